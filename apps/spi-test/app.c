@@ -4,7 +4,7 @@
 #include <peripheral_clk_config.h>
 #include "watch.h"
 #include "watch_utility.h"
-#include "spiflash.h"
+#include "spiflash_log.h"
 #include "lis2dw.h"
 
 #define ACCELEROMETER_DATA_ACQUISITION_INVALID ((uint64_t)(0b11))   // all bits are 1 when the flash is erased
@@ -41,62 +41,18 @@ typedef union {
     uint64_t value;
 } accelerometer_data_acquisition_record_t;
 
-static bool wait_for_flash_ready(void) {
-    watch_set_pin_level(A3, false);
-    bool ok = true;
-    uint8_t read_status_response[1] = {0x00};
-    do {
-        ok = spi_flash_read_command(CMD_READ_STATUS, read_status_response, 1);
-    } while ((read_status_response[0] & 0x3) != 0);
-    delay_ms(1); // why do i need this?
-    watch_set_pin_level(A3, true);
-    return ok;
-}
+#define RECORDS_PER_PAGE (SPI_FLASH_LOG_PAYLOAD_SIZE / sizeof(accelerometer_data_acquisition_record_t))
 
-static void write_buffer_to_page(uint8_t *buf, uint16_t page) {
-    uint32_t address = 256 * page;
-
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_command(CMD_ENABLE_WRITE);
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_write_data(address, buf, 256);
-    wait_for_flash_ready();
-
-    uint8_t buf2[256];
-    watch_set_pin_level(A3, false);
-    spi_flash_read_data(address, buf2, 256);
-    wait_for_flash_ready();
-
-    uint8_t used_pages[256] = {0xFF};
-    uint16_t address_to_mark_used = page / 8;
-    uint8_t header_page = address_to_mark_used / 256;
-    uint8_t used_byte = 0x7F >> (page % 8);
-    uint8_t offset_in_buf = address_to_mark_used % 256;
-
-    watch_set_pin_level(A3, false);
-    spi_flash_read_data(header_page * 256, used_pages, 256);
-    used_pages[offset_in_buf] = used_byte;
-    watch_set_pin_level(A3, false);
-    spi_flash_command(CMD_ENABLE_WRITE);
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_write_data(header_page * 256, used_pages, 256);
-    wait_for_flash_ready();
-}
+static spi_flash_log_t flash_log;
 
-static void print_records_at_page(uint16_t page) {
-    accelerometer_data_acquisition_record_t records[32];
+static void print_records_in_page(accelerometer_data_acquisition_record_t *records) {
     static uint64_t timestamp = 0;
     // static uint16_t temperature = 0;
     static lis2dw_range_t range = LIS2DW_RANGE_2_G;
     static double lsb_value = 1;
     static bool printing_header = false;
 
-    wait_for_flash_ready();
-    spi_flash_read_data(page * 256, (void *)records, 256);
-    for(int i = 0; i < 32; i++) {
+    for(size_t i = 0; i < RECORDS_PER_PAGE; i++) {
         switch (records[i].header.info.record_type) {
             case ACCELEROMETER_DATA_ACQUISITION_HEADER:
                 printing_header = true;
@@ -155,32 +111,17 @@ static void print_records_at_page(uint16_t page) {
                 // don't print anything
                 break;
         }
-        records[i].header.info.record_type = ACCELEROMETER_DATA_ACQUISITION_DELETED;
     }
-
-    // uncomment this to mark all pages deleted
-    // write_buffer_to_page((uint8_t *)records, page);
 }
 
 static void print_records() {
-    uint8_t buf[256];
-    for(int16_t i = 0; i < 4; i++) {
-        wait_for_flash_ready();
-        spi_flash_read_data(i * 256, buf, 256);
-        for(int16_t j = 0; j < 256; j++) {
-            uint8_t pages_written = buf[j];
-            uint8_t start = 0;
-            if (i == 0 && j == 0) {
-                pages_written <<= 4;
-                start = 4;
-            }
-            for(int k = start; k < 8; k++) {
-                if ((pages_written & 0x80) == 0) {
-                    print_records_at_page(i * 2048 + j * 8 + k);
-                }
-                pages_written <<= 1;
-            }
-        }
+    accelerometer_data_acquisition_record_t records[RECORDS_PER_PAGE];
+    spi_flash_log_cursor_t cursor;
+    uint16_t length;
+
+    spi_flash_log_rewind(&flash_log, &cursor);
+    while (spi_flash_log_read_next(&flash_log, &cursor, records, &length)) {
+        if (length == sizeof(records)) print_records_in_page(records);
     }
 
     printf("=== END ===\n");
@@ -196,18 +137,14 @@ void app_setup(void) {
     spi_flash_init();
     delay_ms(5000);
 
+    spi_flash_log_mount(&flash_log, 0, SPI_FLASH_NUM_SECTORS, false);
+
     // bool erase = false;
     // if (erase) {
     //     printf("Erasing...\n");
-    //     wait_for_flash_ready();
-    //     watch_set_pin_level(A3, false);
-    //     spi_flash_command(CMD_ENABLE_WRITE);
-    //     wait_for_flash_ready();
-    //     watch_set_pin_level(A3, false);
-    //     spi_flash_command(CMD_CHIP_ERASE);
-    //     delay_ms(10000);
+    //     spi_flash_log_erase(&flash_log);
     // }
- 
+
     print_records();
 }
 
@@ -1,5 +1,7 @@
 ##############################################################################
-ifndef EMSCRIPTEN
+ifdef HEADLESS
+BUILD = ./build-headless
+else ifndef EMSCRIPTEN
 BUILD = ./build
 else
 BUILD = ./build-sim
@@ -45,7 +47,7 @@ ifeq ($(DETECTED_OS), WINDOWS)
   MAKEFLAGS += -j $(NUMBER_OF_PROCESSORS)
 endif
 
-ifndef EMSCRIPTEN
+ifeq ($(EMSCRIPTEN)$(HEADLESS),)
 CC = arm-none-eabi-gcc
 OBJCOPY = arm-none-eabi-objcopy
 SIZE = arm-none-eabi-size
@@ -120,6 +122,8 @@ SRCS += \
   $(TOP)/watch-library/hardware/watch/watch_uart.c \
   $(TOP)/watch-library/hardware/watch/watch_storage.c \
   $(TOP)/watch-library/hardware/watch/watch_deepsleep.c \
+  $(TOP)/watch-library/hardware/watch/watch_timer.c \
+  $(TOP)/watch-library/hardware/watch/watch_trng.c \
   $(TOP)/watch-library/hardware/watch/watch_private.c \
   $(TOP)/watch-library/hardware/watch/watch.c \
   $(TOP)/watch-library/hardware/hal/src/hal_atomic.c \
@@ -153,8 +157,10 @@ SRCS += \
   $(TOP)/watch-library/shared/driver/lis2dw.c \
   $(TOP)/watch-library/shared/driver/opt3001.c \
   $(TOP)/watch-library/shared/driver/spiflash.c \
+  $(TOP)/watch-library/shared/driver/spiflash_log.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
+  $(TOP)/watch-library/shared/watch/watch_private_timer.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
 
 DEFINES += \
@@ -180,6 +186,42 @@ INCLUDES += \
   -I$(TOP)/watch-library/hardware/hpl/slcd/ \
   -I$(TOP)/watch-library/hardware/hw/ \
 
+ifdef HEADLESS
+# The headless replayer is the simulator build compiled natively: the files under headless/ stand
+# in for the parts that talk to the browser, and a stub emscripten.h compiles away inline JavaScript.
+CFLAGS += -D__EMSCRIPTEN__=1
+
+LIBS += -lm
+
+INCLUDES += \
+  -I$(TOP)/watch-library/headless/include/ \
+  -I$(TOP)/watch-library/headless/watch/ \
+
+SRCS += \
+  $(TOP)/watch-library/headless/main.c \
+  $(TOP)/watch-library/headless/watch/headless.c \
+  $(TOP)/watch-library/headless/watch/headless_display.c \
+  $(TOP)/watch-library/headless/watch/watch_rtc.c \
+  $(TOP)/watch-library/headless/watch/watch_slcd.c \
+  $(TOP)/watch-library/headless/watch/watch_extint.c \
+  $(TOP)/watch-library/headless/watch/watch_led.c \
+  $(TOP)/watch-library/headless/watch/watch_buzzer.c \
+  $(TOP)/watch-library/headless/watch/watch_adc.c \
+  $(TOP)/watch-library/headless/watch/watch_trng.c \
+  $(TOP)/watch-library/headless/watch/watch_deepsleep.c \
+  $(TOP)/watch-library/headless/watch/watch.c \
+  $(TOP)/watch-library/simulator/watch/watch_gpio.c \
+  $(TOP)/watch-library/simulator/watch/watch_i2c.c \
+  $(TOP)/watch-library/simulator/watch/watch_spi.c \
+  $(TOP)/watch-library/simulator/watch/watch_uart.c \
+  $(TOP)/watch-library/simulator/watch/watch_storage.c \
+  $(TOP)/watch-library/simulator/watch/watch_timer.c \
+  $(TOP)/watch-library/simulator/watch/watch_private.c \
+  $(TOP)/watch-library/shared/driver/lis2dw.c \
+  $(TOP)/watch-library/shared/driver/spiflash.c \
+  $(TOP)/watch-library/shared/driver/spiflash_log.c \
+
+else
 SRCS += \
   $(TOP)/watch-library/simulator/main.c \
   $(TOP)/watch-library/simulator/watch/watch_rtc.c \
@@ -194,12 +236,20 @@ SRCS += \
   $(TOP)/watch-library/simulator/watch/watch_uart.c \
   $(TOP)/watch-library/simulator/watch/watch_storage.c \
   $(TOP)/watch-library/simulator/watch/watch_deepsleep.c \
+  $(TOP)/watch-library/simulator/watch/watch_timer.c \
+  $(TOP)/watch-library/simulator/watch/watch_trng.c \
+  $(TOP)/watch-library/simulator/watch/watch_trace.c \
   $(TOP)/watch-library/simulator/watch/watch_private.c \
   $(TOP)/watch-library/simulator/watch/watch.c \
+
+endif
+
+SRCS += \
   $(TOP)/watch-library/shared/driver/thermistor_driver.c \
   $(TOP)/watch-library/shared/driver/opt3001.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
+  $(TOP)/watch-library/shared/watch/watch_private_timer.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
 
 endif
@@ -221,11 +271,21 @@ CFLAGS += -DWATCH_INVERT_LED_POLARITY
 CFLAGS += -DNO_FREQCORR
 endif
 
+# SLCD_DMA=1 drives segment animations from DMA instead of a software timer, and lets the display count
+# seconds in low energy mode. Not yet tried on a watch.
+ifdef SLCD_DMA
+CFLAGS += -DWATCH_SLCD_USE_DMA
+endif
+
 ifdef FIRMWARE
 CFLAGS += -DMOVEMENT_FIRMWARE_$(FIRMWARE)=1
 CFLAGS += -DMOVEMENT_FIRMWARE=MOVEMENT_FIRMWARE_$(FIRMWARE)
 endif
 
+ifdef FACE
+CFLAGS += -DMOVEMENT_TEST_FACE=$(FACE)
+endif
+
 ifeq ($(BOARD), OSO-FEAL-A1-00)
 CFLAGS += -DCRYSTALLESS
 endif
@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "animation.h"
+
+static const animation_script_t *_animation_script;
+static uint8_t _animation_keyframe;
+static uint8_t _animation_loops_left;
+static bool _animation_offloaded;
+static watch_timer_t _animation_timer;
+
+static void _animation_advance(void *context);
+
+static void _animation_show_keyframe(void) {
+    animation_keyframe_t made;
+    const animation_keyframe_t *keyframe = &made;
+    if (_animation_script->keyframes != NULL) keyframe = &_animation_script->keyframes[_animation_keyframe];
+    else _animation_script->make_keyframe(_animation_keyframe, &made, _animation_script->context);
+    watch_set_segments(_animation_script->segments, keyframe->lit);
+    watch_timer_start(&_animation_timer, WATCH_TIMER_MS(keyframe->duration), 0, _animation_advance, NULL);
+}
+
+// runs from the timer interrupt at the end of each keyframe.
+static void _animation_advance(void *context) {
+    (void) context;
+    if (_animation_script == NULL) return;
+
+    if (++_animation_keyframe >= _animation_script->num_keyframes) {
+        if (_animation_script->loops != ANIMATION_LOOP_FOREVER && --_animation_loops_left == 0) {
+            // leave the last keyframe up.
+            _animation_script = NULL;
+            return;
+        }
+        _animation_keyframe = 0;
+    }
+    _animation_show_keyframe();
+}
+
+// hands the script to watch_start_segment_animation, if it's the kind of thing that can loop on its own.
+static bool _animation_offload(const animation_script_t *script) {
+    if (script->loops != ANIMATION_LOOP_FOREVER || script->keyframes == NULL) return false;
+
+    uint16_t shortest = UINT16_MAX;
+    for (uint8_t i = 0; i < script->num_keyframes; i++) {
+        if (script->keyframes[i].duration < shortest) shortest = script->keyframes[i].duration;
+    }
+    if (shortest == 0) return false;
+
+    // a keyframe that lasts two of the shortest becomes two identical frames, and so on.
+    watch_segments_t frames[WATCH_MAX_ANIMATION_FRAMES];
+    uint8_t num_frames = 0;
+    for (uint8_t i = 0; i < script->num_keyframes; i++) {
+        if (script->keyframes[i].duration % shortest) return false;
+        for (uint16_t j = 0; j < script->keyframes[i].duration / shortest; j++) {
+            if (num_frames == WATCH_MAX_ANIMATION_FRAMES) return false;
+            frames[num_frames++] = script->keyframes[i].lit;
+        }
+    }
+
+    watch_start_segment_animation(script->segments, frames, num_frames, shortest);
+    return true;
+}
+
+void animation_play(const animation_script_t *script) {
+    animation_stop();
+    if (script->num_keyframes == 0) return;
+
+    if (_animation_offload(script)) {
+        _animation_offloaded = true;
+        _animation_script = script;
+        return;
+    }
+
+    _animation_keyframe = 0;
+    _animation_loops_left = script->loops;
+    _animation_script = script;
+    _animation_show_keyframe();
+}
+
+bool animation_is_playing(void) {
+    // waking from sleep re-initializes the display, and backup mode stops every timer; either one ends the
+    // animation behind our back, so let go of the script too.
+    if (_animation_script != NULL &&
+        !(_animation_offloaded ? watch_segment_animation_is_running() : watch_timer_is_running(&_animation_timer))) {
+        animation_stop();
+    }
+    return _animation_script != NULL;
+}
+
+void animation_stop(void) {
+    watch_timer_stop(&_animation_timer);
+    if (_animation_offloaded) {
+        watch_stop_segment_animation();
+        _animation_offloaded = false;
+    }
+    _animation_script = NULL;
+}
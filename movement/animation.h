@@ -0,0 +1,88 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef ANIMATION_H_
+#define ANIMATION_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch.h"
+
+/** @brief Movement's animation engine. A face describes an animation as a script of keyframes, each a set of
+  *        lit segments and how long to hold it, and hands it off here. The engine plays it from a single
+  *        software timer (or, for short looping scripts, watch_start_segment_animation), so the face's loop
+  *        isn't called for each frame and can stay at a 1 Hz tick.
+  * @details Only one animation plays at a time; playing another replaces it. Segments outside the script's set
+  *          are left alone, so a face can keep drawing the rest of the display while it plays.
+  *          A script with a keyframes array that loops forever, whose keyframes all last a multiple of the shortest one and add up to
+  *          no more than WATCH_MAX_ANIMATION_FRAMES of it, is handed to watch_start_segment_animation, which
+  *          runs it with the CPU asleep on builds with SLCD_DMA=1; its timing is then rounded to the display's
+  *          frame rate. Since only one segment animation plays at a time, this replaces any
+  *          watch_start_position_blink.
+  */
+
+/// Pass as a script's loops to play it until animation_stop is called.
+#define ANIMATION_LOOP_FOREVER 0
+
+typedef struct {
+    watch_segments_t lit;   // the segments of the script's set that are on in this keyframe.
+    uint16_t duration;      // how long to hold this keyframe, in milliseconds.
+} animation_keyframe_t;
+
+/** @brief Makes a keyframe on the fly, for scripts that would rather compute their keyframes than keep them all
+  *        in RAM. It's called from the timer interrupt, in order from index 0 (and from 0 again on each loop),
+  *        just before the keyframe is shown, so keep it short.
+  */
+typedef void (*animation_keyframe_maker_t)(uint8_t index, animation_keyframe_t *keyframe, void *context);
+
+typedef struct {
+    watch_segments_t segments;              // every segment the animation controls.
+    const animation_keyframe_t *keyframes;  // the keyframes, played in order; or NULL to have make_keyframe make them.
+    animation_keyframe_maker_t make_keyframe;
+    void *context;                          // passed to make_keyframe.
+    uint8_t num_keyframes;
+    uint8_t loops;                          // how many times to play the keyframes, or ANIMATION_LOOP_FOREVER.
+} animation_script_t;
+
+/** @brief Starts playing a script, from its first keyframe.
+  * @param script The script. It isn't copied, so it (and its keyframes) must stay valid until the animation
+  *               finishes or is stopped; a static or a field in the face's context is usually simplest.
+  * @note When a script that doesn't loop forever finishes, its last keyframe stays on screen.
+  */
+void animation_play(const animation_script_t *script);
+
+/** @brief Checks whether an animation is playing.
+  * @return true if a script is playing; false if none was started, or the last one finished or was stopped
+  *         (including by backup mode stopping every timer, or the display being re-initialized on wake).
+  */
+bool animation_is_playing(void);
+
+/** @brief Stops the animation, if one is playing. Its segments are left showing the current keyframe, or
+  *        the first one if it was handed to watch_start_segment_animation.
+  * @note Movement calls this when the face changes, and before entering low energy mode, so an animation never
+  *       outlives the face that started it or keeps waking the watch while it sleeps.
+  */
+void animation_stop(void);
+
+#endif // ANIMATION_H_
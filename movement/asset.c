@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "asset.h"
+#include "watch.h"
+
+// the index of a valid pack, or NULL if there isn't one.
+static const asset_pack_header_t *_asset_pack;
+static const asset_entry_t *_asset_index;
+
+// FNV-1a, same as the checkpoints use; the tool computes it too.
+static uint32_t _asset_checksum(const uint8_t *data, uint32_t size) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool asset_init(void) {
+    uint32_t region_size;
+    const uint8_t *region = watch_storage_get_assets(&region_size);
+
+    _asset_pack = NULL;
+    _asset_index = NULL;
+    if (region == NULL || region_size < sizeof(asset_pack_header_t)) return false;
+
+    const asset_pack_header_t *header = (const asset_pack_header_t *)region;
+    if (header->magic != ASSET_PACK_MAGIC || header->version != ASSET_PACK_VERSION) return false;
+    if (header->size > region_size) return false;
+    uint32_t index_end = sizeof(asset_pack_header_t) + header->count * sizeof(asset_entry_t);
+    if (index_end > header->size) return false;
+    if (_asset_checksum(region + sizeof(asset_pack_header_t), header->size - sizeof(asset_pack_header_t)) != header->checksum) return false;
+
+    // the checksum says the pack is what the tool wrote, but an index that points outside the pack, or isn't in
+    // order, would still send asset_get astray, so we check the tool did its job too.
+    const asset_entry_t *index = (const asset_entry_t *)(region + sizeof(asset_pack_header_t));
+    for (uint16_t i = 0; i < header->count; i++) {
+        if (index[i].name[ASSET_NAME_LENGTH - 1] != 0) return false;
+        if (index[i].offset % 4 || index[i].offset < index_end) return false;
+        if (index[i].offset > header->size || index[i].length > header->size - index[i].offset) return false;
+        if (i && strncmp(index[i - 1].name, index[i].name, ASSET_NAME_LENGTH) >= 0) return false;
+    }
+
+    _asset_pack = header;
+    _asset_index = index;
+    return true;
+}
+
+const void *asset_get(const char *name, uint32_t *length) {
+    if (_asset_pack == NULL) return NULL;
+
+    // the tool sorts the index by name, so this is a binary search.
+    uint16_t low = 0;
+    uint16_t high = _asset_pack->count;
+    while (low < high) {
+        uint16_t middle = low + (high - low) / 2;
+        const asset_entry_t *entry = &_asset_index[middle];
+        int result = strncmp(name, entry->name, ASSET_NAME_LENGTH);
+        if (result == 0) {
+            if (length != NULL) *length = entry->length;
+            return (const uint8_t *)_asset_pack + entry->offset;
+        }
+        if (result < 0) high = middle;
+        else low = middle + 1;
+    }
+
+    return NULL;
+}
+
+uint16_t asset_count(void) {
+    if (_asset_pack == NULL) return 0;
+    return _asset_pack->count;
+}
+
+const asset_entry_t *asset_entry(uint16_t index) {
+    if (index >= asset_count()) return NULL;
+    return &_asset_index[index];
+}
@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASSET_H_
+#define ASSET_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Movement's asset pack: named, read-only blobs (lookup tables, word lists, series coefficients)
+  *        that live in their own region of Flash instead of in the firmware. A face asks for an asset by
+  *        name and gets back a pointer straight into Flash, so the data never takes up RAM, and the pack can
+  *        be rebuilt with utils/asset_pack.py and flashed on its own without touching the firmware.
+  * @note The pack is checked once at startup. If there is no pack, or it is damaged, every lookup fails, so a
+  *       face that uses assets should always have something sensible to show when asset_get returns NULL.
+  *       The simulator never has a pack.
+  */
+
+/// "MVAP", little-endian.
+#define ASSET_PACK_MAGIC 0x5041564D
+#define ASSET_PACK_VERSION 1
+/// Names are NUL-padded to this length, so they can be at most 15 characters long.
+#define ASSET_NAME_LENGTH 16
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;     // number of index entries that follow the header
+    uint32_t size;      // bytes in the whole pack, header included
+    uint32_t checksum;  // FNV-1a of everything after the header
+} asset_pack_header_t;
+
+typedef struct {
+    char name[ASSET_NAME_LENGTH];
+    uint32_t offset;    // from the start of the pack; always a multiple of 4
+    uint32_t length;
+} asset_entry_t;
+
+/** @brief Checks the pack in the asset region, and makes its assets available if it's sound.
+  * @return true if a valid pack was found.
+  */
+bool asset_init(void);
+
+/** @brief Looks up an asset by name.
+  * @param name The asset's name, as given to utils/asset_pack.py.
+  * @param length If not NULL, set to the asset's length in bytes.
+  * @return A pointer to the asset in Flash, aligned to four bytes, or NULL if there's no such asset.
+  *         The pointer stays valid until the watch resets. Do not write through it.
+  */
+const void *asset_get(const char *name, uint32_t *length);
+
+/** @brief Returns the number of assets in the pack, or 0 if there is no valid pack.
+  */
+uint16_t asset_count(void);
+
+/** @brief Returns the index entry for an asset by position, e.g. to list the pack's contents.
+  * @param index A number less than asset_count().
+  * @return The entry, or NULL if the index is out of range.
+  */
+const asset_entry_t *asset_entry(uint16_t index);
+
+#endif // ASSET_H_
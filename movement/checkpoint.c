@@ -0,0 +1,183 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checkpoint.h"
+#include "filesystem.h"
+
+#define CHECKPOINT_MAGIC 0x74706b63 // "ckpt"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t key;
+    uint32_t sequence;
+    uint32_t checksum;
+    uint16_t size;
+    uint8_t version;
+    uint8_t reserved;
+} checkpoint_header_t;
+
+typedef struct {
+    void *data;
+    uint32_t sequence;
+    uint32_t checksum; // of the data as it was last written, so unchanged state is never written again.
+    uint32_t key;
+    uint16_t size;
+    uint8_t version;
+} checkpoint_entry_t;
+
+static checkpoint_entry_t _checkpoint_entries[CHECKPOINT_MAX_ENTRIES];
+static uint8_t _checkpoint_num_entries;
+static uint16_t _checkpoint_interval;
+static uint32_t _checkpoint_last_run;
+
+// FNV-1a; we only need to notice changes and torn writes, not withstand anyone trying to fool us.
+static uint32_t _checkpoint_checksum(const uint8_t *data, uint16_t size) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void _checkpoint_filename(char *filename, checkpoint_entry_t *entry, uint8_t slot) {
+    sprintf(filename, "ck%08lx.%c", (unsigned long)entry->key, 'a' + slot);
+}
+
+// the two files alternate by sequence number: even numbers go to a, odd to b.
+static bool _checkpoint_read_header(checkpoint_entry_t *entry, uint8_t slot, checkpoint_header_t *header) {
+    char filename[16];
+    _checkpoint_filename(filename, entry, slot);
+    if (filesystem_get_file_size(filename) != (int32_t)(sizeof(checkpoint_header_t) + entry->size)) return false;
+    if (!filesystem_read_file(filename, (char *)header, sizeof(checkpoint_header_t))) return false;
+
+    return header->magic == CHECKPOINT_MAGIC && header->key == entry->key && header->size == entry->size && header->version == entry->version &&
+           header->sequence % 2 == slot;
+}
+
+static bool _checkpoint_restore(checkpoint_entry_t *entry, uint8_t slot, const checkpoint_header_t *header) {
+    char filename[16];
+    bool restored = false;
+    uint8_t *buf = malloc(sizeof(checkpoint_header_t) + entry->size);
+
+    if (buf == NULL) return false;
+    _checkpoint_filename(filename, entry, slot);
+    if (filesystem_read_file(filename, (char *)buf, sizeof(checkpoint_header_t) + entry->size)) {
+        uint8_t *data = buf + sizeof(checkpoint_header_t);
+        if (_checkpoint_checksum(data, entry->size) == header->checksum) {
+            memcpy(entry->data, data, entry->size);
+            entry->sequence = header->sequence;
+            entry->checksum = header->checksum;
+            restored = true;
+        }
+    }
+    free(buf);
+
+    return restored;
+}
+
+static bool _checkpoint_write(checkpoint_entry_t *entry) {
+    uint32_t checksum = _checkpoint_checksum(entry->data, entry->size);
+    if (checksum == entry->checksum) return true;
+
+    char filename[16];
+    checkpoint_header_t header = { CHECKPOINT_MAGIC, entry->key, entry->sequence + 1, checksum, entry->size, entry->version, 0 };
+    _checkpoint_filename(filename, entry, header.sequence % 2);
+
+    // littlefs writes the new copy of a file before it lets go of the old one, so the whole file has to fit in
+    // the free space, and we leave some over so that the store and the faces' own files can still be written.
+    uint32_t blocks = (sizeof(header) + entry->size + NVMCTRL_ROW_SIZE - 1) / NVMCTRL_ROW_SIZE;
+    int32_t free_space = filesystem_get_free_space();
+    if (free_space < 0 || (uint32_t)free_space < (blocks + CHECKPOINT_RESERVED_BLOCKS) * NVMCTRL_ROW_SIZE) {
+        printf("checkpoint %s: not enough space\n", filename);
+        return false;
+    }
+
+    // write over the older of the two files; until both halves are down, the newer one is still intact.
+    if (filesystem_write_file(filename, (char *)&header, sizeof(header)) &&
+        filesystem_append_file(filename, (char *)entry->data, entry->size)) {
+        entry->sequence = header.sequence;
+        entry->checksum = checksum;
+        return true;
+    }
+
+    // a half-written file fails its checks at boot anyway, so don't let it hold on to space.
+    printf("checkpoint %s: write failed\n", filename);
+    filesystem_rm(filename);
+    return false;
+}
+
+bool checkpoint_register(uint32_t key, void *data, uint16_t size, uint8_t version) {
+    if (_checkpoint_num_entries >= CHECKPOINT_MAX_ENTRIES) return false;
+
+    checkpoint_entry_t *entry = &_checkpoint_entries[_checkpoint_num_entries++];
+    checkpoint_header_t headers[2];
+    bool valid[2];
+
+    entry->data = data;
+    entry->size = size;
+    entry->key = key;
+    entry->version = version;
+    entry->sequence = 0;
+    // until we've written it once, nothing has been checkpointed, so any state at all counts as a change.
+    entry->checksum = ~_checkpoint_checksum(data, size);
+
+    for (uint8_t slot = 0; slot < 2; slot++) valid[slot] = _checkpoint_read_header(entry, slot, &headers[slot]);
+
+    // try the newer checkpoint first, and fall back to the older one if the newer one was torn.
+    uint8_t newer = (valid[1] && (!valid[0] || headers[1].sequence > headers[0].sequence)) ? 1 : 0;
+    // either way, the next write goes to the other file, never over the checkpoint we just restored.
+    if (valid[newer] && _checkpoint_restore(entry, newer, &headers[newer])) return true;
+    if (valid[!newer] && _checkpoint_restore(entry, !newer, &headers[!newer])) return true;
+
+    return false;
+}
+
+static void _checkpoint_scheduled_flush(void) {
+    checkpoint_flush();
+}
+
+void checkpoint_set_interval(uint16_t minutes) {
+    _checkpoint_interval = minutes;
+}
+
+void checkpoint_run(uint32_t now) {
+    if (_checkpoint_interval == 0) return;
+    // if the clock was set back, don't wait for it to catch up again.
+    if (now >= _checkpoint_last_run && now - _checkpoint_last_run < (uint32_t)_checkpoint_interval * 60) return;
+
+    _checkpoint_last_run = now;
+    // the interval already does the batching; waiting for the filesystem's window as well would only widen
+    // the gap a reset can fall into.
+    filesystem_schedule_write(_checkpoint_scheduled_flush, 0);
+}
+
+bool checkpoint_flush(void) {
+    bool ok = true;
+    for (uint8_t i = 0; i < _checkpoint_num_entries; i++) ok &= _checkpoint_write(&_checkpoint_entries[i]);
+    return ok;
+}
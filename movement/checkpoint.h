@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "store.h"
+
+/** @brief Movement's checkpoint service. Face contexts live in RAM and are lost on a reset, a brown-out or a
+  *        battery change; a face that registers its state here has it written to the filesystem every so often
+  *        (only when it has actually changed) and read back the next time the watch boots.
+  * @note Each checkpoint alternates between two files, and each file carries a sequence number and a checksum,
+  *       so if the power fails in the middle of a write, the previous checkpoint is still there to fall back on.
+  *       A checkpoint is only restored into a registration with the same key, size and version, so bump the
+  *       version whenever the layout of your state changes. Don't checkpoint pointers.
+  * @note Mind the space: the filesystem is only 8 KB, in 32 blocks of 256 bytes, and littlefs needs free blocks to
+  *       write anything at all. Both of a registration's files hold a 20-byte header plus the whole state, so a
+  *       state of a few dozen bytes costs next to nothing (littlefs keeps files that small in the directory), but
+  *       activity_face's 892-byte log takes four blocks per file, eight in all. A write that would leave fewer
+  *       than CHECKPOINT_RESERVED_BLOCKS free is skipped and tried again at the next interval, and the previous
+  *       checkpoint stays in place.
+  */
+
+/// Number of registrations shared by all faces.
+#define CHECKPOINT_MAX_ENTRIES 8
+/// Blocks of the filesystem a checkpoint write always leaves free, for littlefs itself and everyone else's files.
+#define CHECKPOINT_RESERVED_BLOCKS 4
+
+/** @brief Registers a block of memory to be checkpointed, and restores it from the last checkpoint if there is one.
+  *        Call this from your setup function, right after you've allocated and initialized your state.
+  * @param key A key made with STORE_KEY that names the state, like the store's. Don't derive it from the watch
+  *            face index, which changes whenever faces are added or reordered; a face that can appear more than
+  *            once can count its instances instead, as world_clock_face does for its store key.
+  * @param data The state. It has to stay where it is for as long as the watch runs.
+  * @param size The size of the state in bytes.
+  * @param version The version of the state's layout.
+  * @return true if data was restored from a checkpoint; false if it was left as it was.
+  */
+bool checkpoint_register(uint32_t key, void *data, uint16_t size, uint8_t version);
+
+/** @brief Sets how often Movement checks the registered state for changes.
+  * @param minutes The interval in minutes; 0 turns checkpointing off.
+  */
+void checkpoint_set_interval(uint16_t minutes);
+
+/** @brief If the interval has passed, opens the filesystem's flush window at this minute wake, and the
+  *        registrations that have changed since their last checkpoint are written out in it. Movement calls this
+  *        at every minute wake.
+  * @param now The current time, as returned by schedule_now.
+  */
+void checkpoint_run(uint32_t now);
+
+/** @brief Writes out every registration that has changed since its last checkpoint, right now.
+  * @return false if any of them couldn't be written; those stay pending and are tried again next time.
+  */
+bool checkpoint_flush(void);
+
+#endif // CHECKPOINT_H_
@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string.h>
+#include "entropy.h"
+#include "watch.h"
+
+static uint32_t _entropy_state[4];
+static uint8_t _entropy_draws;
+
+static inline uint32_t _entropy_rotl(const uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// xoshiro128** by David Blackman and Sebastiano Vigna (public domain)
+static uint32_t _entropy_next(void) {
+    uint32_t *s = _entropy_state;
+    const uint32_t result = _entropy_rotl(s[1] * 5, 7) * 9;
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = _entropy_rotl(s[3], 11);
+
+    return result;
+}
+
+static void _entropy_mix(const uint32_t *words, size_t count) {
+    for (size_t i = 0; i < count; i++) _entropy_state[i % 4] ^= words[i];
+    // xoshiro must never be all zeroes; vanishingly unlikely, but cheap to rule out.
+    if (!(_entropy_state[0] | _entropy_state[1] | _entropy_state[2] | _entropy_state[3])) _entropy_state[0] = 1;
+    // a few rounds spread the new bits across the whole state before anyone sees output.
+    for (uint8_t i = 0; i < 8; i++) _entropy_next();
+}
+
+void entropy_init(void) {
+    uint32_t seed[4];
+
+    watch_trng_read(seed, 4);
+    _entropy_mix(seed, 4);
+    _entropy_draws = 0;
+}
+
+void entropy_harvest(void) {
+    uint32_t words[ENTROPY_HARVEST_WORDS];
+
+    if (_entropy_draws < ENTROPY_HARVEST_THRESHOLD) return;
+    watch_trng_read(words, ENTROPY_HARVEST_WORDS);
+    _entropy_mix(words, ENTROPY_HARVEST_WORDS);
+    _entropy_draws = 0;
+}
+
+uint32_t entropy_get_u32(void) {
+    if (_entropy_draws < UINT8_MAX) _entropy_draws++;
+    return _entropy_next();
+}
+
+uint32_t entropy_uniform(uint32_t upper_bound) {
+    if (upper_bound < 2) return 0;
+
+    // reject the few values at the bottom of the range that would make the low remainders more likely.
+    uint32_t min = -upper_bound % upper_bound;
+    uint32_t r;
+    do {
+        r = entropy_get_u32();
+    } while (r < min);
+
+    return r % upper_bound;
+}
+
+void entropy_bytes(void *buf, size_t len) {
+    uint8_t *p = (uint8_t *)buf;
+    uint32_t word;
+
+    while (len) {
+        size_t n = len < 4 ? len : 4;
+        word = entropy_get_u32();
+        memcpy(p, &word, n);
+        p += n;
+        len -= n;
+    }
+}
+
+void entropy_shuffle(void *base, size_t count, size_t size) {
+    uint8_t *bytes = (uint8_t *)base;
+
+    if (count < 2) return;
+    for (size_t i = count - 1; i > 0; i--) {
+        size_t j = entropy_uniform(i + 1);
+        if (j == i) continue;
+        uint8_t *a = bytes + i * size;
+        uint8_t *b = bytes + j * size;
+        for (size_t k = 0; k < size; k++) {
+            uint8_t tmp = a[k];
+            a[k] = b[k];
+            b[k] = tmp;
+        }
+    }
+}
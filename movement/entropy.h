@@ -0,0 +1,75 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef ENTROPY_H_
+#define ENTROPY_H_
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/** @brief Movement's pool of random numbers: a xoshiro128** generator seeded from the TRNG at boot and stirred
+  *        with fresh TRNG words every so often while the watch is awake anyway. Faces get random numbers
+  *        instantly, without powering anything up, and get the same behavior on hardware and in the simulator.
+  * @note Good for dice, games and shuffles. It is not a cryptographic generator; don't derive keys from it.
+  */
+
+/// Number of numbers handed out before the next entropy_harvest call stirs in fresh TRNG words.
+#define ENTROPY_HARVEST_THRESHOLD 8
+/// Number of TRNG words stirred in per harvest.
+#define ENTROPY_HARVEST_WORDS 2
+
+/** @brief Seeds the pool with 128 bits from the TRNG. Movement calls this once at boot.
+  */
+void entropy_init(void);
+
+/** @brief Stirs fresh TRNG words into the pool if enough numbers have been drawn since the last harvest.
+  *        Movement calls this from its main loop while awake, so the TRNG is only ever powered for a few
+  *        microseconds at a time, and never while the watch is idle.
+  */
+void entropy_harvest(void);
+
+/** @brief Returns 32 random bits from the pool.
+  */
+uint32_t entropy_get_u32(void);
+
+/** @brief Returns a uniformly distributed random number less than upper_bound, without modulo bias.
+  * @param upper_bound One more than the largest value you want; 0 and 1 both return 0.
+  */
+uint32_t entropy_uniform(uint32_t upper_bound);
+
+/** @brief Fills a buffer with random bytes from the pool.
+  * @param buf The buffer to fill.
+  * @param len The number of bytes to write.
+  */
+void entropy_bytes(void *buf, size_t len);
+
+/** @brief Shuffles an array in place (Fisher-Yates), with every permutation equally likely.
+  * @param base The first element of the array.
+  * @param count The number of elements.
+  * @param size The size of each element in bytes.
+  */
+void entropy_shuffle(void *base, size_t count, size_t size);
+
+#endif // ENTROPY_H_
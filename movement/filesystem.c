@@ -3,10 +3,14 @@
 #include <string.h>
 #include <peripheral_clk_config.h>
 #include "filesystem.h"
+#include "asset.h"
 #include "watch.h"
 #include "lfs.h"
 #include "hpl_flash.h"
 
+#define FILESYSTEM_BLOCK_COUNT (NVMCTRL_RWWEE_PAGES / 4)
+#define FILESYSTEM_WEAR_FILENAME "wear.bin"
+
 int lfs_storage_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size);
 int lfs_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size);
 int lfs_storage_erase(const struct lfs_config *cfg, lfs_block_t block);
@@ -22,8 +26,16 @@ int lfs_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t
     return !watch_storage_write(block, off, (void *)buffer, size);
 }
 
+// erases are what wear the flash out, so we count them per block, and write the counts out now and then.
+static uint32_t _filesystem_erase_counts[FILESYSTEM_BLOCK_COUNT];
+static bool _filesystem_erase_counts_changed;
+
 int lfs_storage_erase(const struct lfs_config *cfg, lfs_block_t block) {
     (void) cfg;
+    if (block < FILESYSTEM_BLOCK_COUNT) {
+        _filesystem_erase_counts[block]++;
+        _filesystem_erase_counts_changed = true;
+    }
     return !watch_storage_erase(block);
 }
 
@@ -43,7 +55,7 @@ const struct lfs_config cfg = {
     .read_size = 16,
     .prog_size = NVMCTRL_PAGE_SIZE,
     .block_size = NVMCTRL_ROW_SIZE,
-    .block_count = NVMCTRL_RWWEE_PAGES / 4,
+    .block_count = FILESYSTEM_BLOCK_COUNT,
     .cache_size = NVMCTRL_PAGE_SIZE,
     .lookahead_size = 16,
     .block_cycles = 100,
@@ -53,6 +65,9 @@ static lfs_t lfs;
 static lfs_file_t file;
 static struct lfs_info info;
 
+static filesystem_writer_t _filesystem_pending_writes[FILESYSTEM_MAX_PENDING_WRITES];
+static uint8_t _filesystem_minutes_left;
+
 static int _traverse_df_cb(void *p, lfs_block_t block) {
     (void) block;
 	uint32_t *nb = p;
@@ -124,6 +139,12 @@ bool filesystem_init(void) {
         printf("Filesystem mounted with %ld bytes free.\n", filesystem_get_free_space());
     }
 
+    // pick up counting where we left off; a missing or mismatched file just means we start from zero.
+    if (err == LFS_ERR_OK && filesystem_get_file_size(FILESYSTEM_WEAR_FILENAME) == sizeof(_filesystem_erase_counts)) {
+        filesystem_read_file(FILESYSTEM_WEAR_FILENAME, (char *)_filesystem_erase_counts, sizeof(_filesystem_erase_counts));
+    }
+    _filesystem_erase_counts_changed = false;
+
     return err == LFS_ERR_OK;
 }
 
@@ -223,6 +244,83 @@ bool filesystem_append_file(char *filename, char *text, int32_t length) {
     return lfs_file_close(&lfs, &file) == LFS_ERR_OK;
 }
 
+bool filesystem_schedule_write(filesystem_writer_t writer, uint8_t delay) {
+    uint8_t i;
+    for (i = 0; i < FILESYSTEM_MAX_PENDING_WRITES; i++) {
+        if (_filesystem_pending_writes[i] == writer || _filesystem_pending_writes[i] == NULL) break;
+    }
+    if (i == FILESYSTEM_MAX_PENDING_WRITES) {
+        filesystem_flush();
+        i = 0;
+    }
+    // the window opens for whoever can wait the least.
+    if (_filesystem_pending_writes[0] == NULL || delay < _filesystem_minutes_left) _filesystem_minutes_left = delay;
+    _filesystem_pending_writes[i] = writer;
+
+    return true;
+}
+
+void filesystem_flush_if_due(void) {
+    if (_filesystem_pending_writes[0] == NULL) return;
+    if (_filesystem_minutes_left == 0) filesystem_flush();
+    else _filesystem_minutes_left--;
+}
+
+void filesystem_flush(void) {
+    filesystem_writer_t writers[FILESYSTEM_MAX_PENDING_WRITES];
+
+    if (_filesystem_pending_writes[0] == NULL) return;
+    // writers are free to schedule themselves again; that lands in the next window, not this one.
+    memcpy(writers, _filesystem_pending_writes, sizeof(writers));
+    memset(_filesystem_pending_writes, 0, sizeof(_filesystem_pending_writes));
+    for (uint8_t i = 0; i < FILESYSTEM_MAX_PENDING_WRITES && writers[i] != NULL; i++) writers[i]();
+
+    // the counts only ever ride along with other writes; written on their own, they'd just wear the flash out
+    // faster. This write's own erases get counted the next time around.
+    if (_filesystem_erase_counts_changed) {
+        _filesystem_erase_counts_changed = false;
+        filesystem_write_file(FILESYSTEM_WEAR_FILENAME, (char *)_filesystem_erase_counts, sizeof(_filesystem_erase_counts));
+    }
+}
+
+uint32_t filesystem_get_erase_count(uint16_t block) {
+    if (block >= FILESYSTEM_BLOCK_COUNT) return 0;
+    return _filesystem_erase_counts[block];
+}
+
+static void filesystem_df(void) {
+    uint32_t total = 0;
+    uint16_t most_worn = 0;
+    for (uint16_t block = 0; block < FILESYSTEM_BLOCK_COUNT; block++) {
+        total += _filesystem_erase_counts[block];
+        if (_filesystem_erase_counts[block] > _filesystem_erase_counts[most_worn]) most_worn = block;
+    }
+    printf("free space: %ld bytes\n", filesystem_get_free_space());
+    printf("erases: %lu total, %lu on the most worn block (%u)\n", (unsigned long)total, (unsigned long)_filesystem_erase_counts[most_worn], most_worn);
+}
+
+static void filesystem_wear(void) {
+    for (uint16_t block = 0; block < FILESYSTEM_BLOCK_COUNT; block++) {
+        printf("block %2u: %lu erases\n", block, (unsigned long)_filesystem_erase_counts[block]);
+    }
+    uint8_t pending = 0;
+    while (pending < FILESYSTEM_MAX_PENDING_WRITES && _filesystem_pending_writes[pending] != NULL) pending++;
+    printf("%u writes pending, flushing in %u minutes\n", pending, pending ? _filesystem_minutes_left + 1 : 0);
+}
+
+static void filesystem_assets(void) {
+    // not part of the filesystem, but this is where the shell lives, and it's the easiest way to see what got flashed.
+    uint16_t count = asset_count();
+    if (count == 0) {
+        printf("no asset pack\n");
+        return;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        const asset_entry_t *entry = asset_entry(i);
+        printf("%-15s %lu bytes\n", entry->name, (unsigned long)entry->length);
+    }
+}
+
 void filesystem_process_command(char *line) {
     printf("$ %s", line);
     char *command = strtok(line, " \n");
@@ -242,7 +340,13 @@ void filesystem_process_command(char *line) {
             filesystem_cat(filename);
         }
     } else if (strcmp(command, "df") == 0) {
-        printf("free space: %ld bytes\n", filesystem_get_free_space());
+        filesystem_df();
+    } else if (strcmp(command, "wear") == 0) {
+        filesystem_wear();
+    } else if (strcmp(command, "sync") == 0) {
+        filesystem_flush();
+    } else if (strcmp(command, "assets") == 0) {
+        filesystem_assets();
     } else if (strcmp(command, "rm") == 0) {
         char *filename = strtok(NULL, " \n");
         if (filename == NULL) {
@@ -28,6 +28,14 @@
 #include <stdbool.h>
 #include "watch.h"
 
+/// Number of writers that can wait for the next flush window at once.
+#define FILESYSTEM_MAX_PENDING_WRITES 8
+/// Minute wakes a pending write waits by default before the flush window, so that later writes can join it.
+#define FILESYSTEM_WRITE_DELAY 10
+
+/// A function that writes one face's or service's files, using the functions below.
+typedef void (*filesystem_writer_t)(void);
+
 /** @brief Initializes and mounts the tiny 8kb filesystem, formatting it if need be.
   * @return true if the filesystem was mounted successfully.
   */
@@ -96,6 +104,34 @@ bool filesystem_write_file(char *filename, char *text, int32_t length);
   */
 bool filesystem_append_file(char *filename, char *text, int32_t length);
 
+/** @brief Asks for a writer to be called in the next flush window, along with everyone else's. Faces whose data
+  *        doesn't have to hit the flash this very second should use this instead of writing directly: writes
+  *        are bunched together into one busy period every so often, and a file that changes several times
+  *        before the window opens is only written once.
+  * @param writer The function that does the writing. It is called once per window no matter how many times
+  *               it was scheduled, so it should write whatever the data looks like at that point.
+  * @param delay The most minute wakes this write can wait. The window opens when the most impatient pending
+  *              write runs out of time, and everyone else's writes go along with it. Use FILESYSTEM_WRITE_DELAY
+  *              unless losing the data to a reset in the meantime would matter; 0 means the next minute wake.
+  * @return true. If every slot is taken, the pending writes are flushed right away to make room.
+  */
+bool filesystem_schedule_write(filesystem_writer_t writer, uint8_t delay);
+
+/** @brief Opens the flush window if a pending write has waited as long as it can. Movement calls this at every
+  *        minute wake, after its own services have scheduled theirs.
+  */
+void filesystem_flush_if_due(void);
+
+/** @brief Calls every pending writer now.
+  */
+void filesystem_flush(void);
+
+/** @brief Gets the number of times a block of the filesystem has been erased, as far as this watch has kept count.
+  * @param block the block, from 0 to the number of blocks in the filesystem
+  * @return the erase count, or 0 if the block doesn't exist.
+  */
+uint32_t filesystem_get_erase_count(uint16_t block);
+
 /** @brief Handles the interactive file browser when Movement is plugged in to USB.
   * @param line The command that the user typed into the serial console.
   */
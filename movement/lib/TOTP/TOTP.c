@@ -4,43 +4,42 @@
 #include "sha512.h"
 #include <stdio.h>
 
-uint8_t* _hmacKey;
-uint8_t _keyLength;
 uint8_t _timeZoneOffset;
-uint32_t _timeStep;
-hmac_alg _algorithm;
+static totp_ctx _ctx;
 
-// Init the library with the private key, its length, the timeStep duration and the algorithm that should be used
-void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm) {
-    _hmacKey = hmacKey;
-    _keyLength = keyLength;
-    _timeStep = timeStep;
-    _algorithm = algorithm;
-}
+void totp_ctx_init(totp_ctx *ctx, const uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm) {
+    ctx->timeStep = timeStep;
+    ctx->algorithm = algorithm;
 
-void setTimezone(uint8_t timezone){
-    _timeZoneOffset = timezone;
+    switch(algorithm){
+        case SHA1:
+            HMAC_SHA1_midstates(hmacKey, keyLength, ctx->midstates.sha1.inner, ctx->midstates.sha1.outer);
+            break;
+        case SHA224:
+            HMAC_SHA256_midstates(hmacKey, keyLength, ctx->midstates.sha256.inner, ctx->midstates.sha256.outer, 1);
+            break;
+        case SHA256:
+            HMAC_SHA256_midstates(hmacKey, keyLength, ctx->midstates.sha256.inner, ctx->midstates.sha256.outer, 0);
+            break;
+        case SHA384:
+            HMAC_SHA512_midstates(hmacKey, keyLength, ctx->midstates.sha512.inner, ctx->midstates.sha512.outer, 1);
+            break;
+        case SHA512:
+            HMAC_SHA512_midstates(hmacKey, keyLength, ctx->midstates.sha512.inner, ctx->midstates.sha512.outer, 0);
+            break;
+    }
 }
 
-static uint32_t TimeStruct2Timestamp(struct tm time){
-    //time.tm_mon -= 1;
-    //time.tm_year -= 1900;
-    return mktime(&(time)) - (_timeZoneOffset * 3600) - 2208988800;
+// Generate a code for the given account, using the timestamp provided
+uint32_t totp_ctx_get_code_from_timestamp(const totp_ctx *ctx, uint32_t timeStamp) {
+    return totp_ctx_get_code_from_steps(ctx, timeStamp / ctx->timeStep);
 }
 
-// Generate a code, using the timestamp provided
-uint32_t getCodeFromTimestamp(uint32_t timeStamp) {
-    uint32_t steps = timeStamp / _timeStep;
-    return getCodeFromSteps(steps);
-}
+// Generate a code for the given account, using the number of steps provided
+uint32_t totp_ctx_get_code_from_steps(const totp_ctx *ctx, uint32_t steps) {
+    uint8_t hash[SHA512_DIGEST_LENGTH];
+    uint8_t digestLength;
 
-// Generate a code, using the timestamp provided
-uint32_t getCodeFromTimeStruct(struct tm time) {
-    return getCodeFromTimestamp(TimeStruct2Timestamp(time));
-}
-
-// Generate a code, using the number of steps provided
-uint32_t getCodeFromSteps(uint32_t steps) {
     // STEP 0, map the number of steps in a 8-bytes array (counter value)
     uint8_t _byteArray[8];
     _byteArray[0] = 0x00;
@@ -52,18 +51,115 @@ uint32_t getCodeFromSteps(uint32_t steps) {
     _byteArray[6] = (uint8_t)((steps >> 8) & 0XFF);
     _byteArray[7] = (uint8_t)((steps & 0XFF));
 
-    switch(_algorithm){
+    // STEP 1, get the HMAC hash from counter and the precomputed key state
+    switch(ctx->algorithm){
         case SHA1:
-            return(TOTP_HMAC_SHA1(_hmacKey, _keyLength, _byteArray, 8));
+            HMAC_SHA1_from_midstates(ctx->midstates.sha1.inner, ctx->midstates.sha1.outer, _byteArray, 8, hash);
+            digestLength = SHA1_DIGEST_LENGTH;
+            break;
         case SHA224:
-            return(TOTP_HMAC_SHA256(_hmacKey, _keyLength, _byteArray, 8, 1));
+            HMAC_SHA256_from_midstates(ctx->midstates.sha256.inner, ctx->midstates.sha256.outer, _byteArray, 8, hash, 1);
+            digestLength = SHA224_DIGEST_LENGTH;
+            break;
         case SHA256:
-            return(TOTP_HMAC_SHA256(_hmacKey, _keyLength, _byteArray, 8, 0));
+            HMAC_SHA256_from_midstates(ctx->midstates.sha256.inner, ctx->midstates.sha256.outer, _byteArray, 8, hash, 0);
+            digestLength = SHA256_DIGEST_LENGTH;
+            break;
         case SHA384:
-            return(TOTP_HMAC_SHA512(_hmacKey, _keyLength, _byteArray, 8, 1));
+            HMAC_SHA512_from_midstates(ctx->midstates.sha512.inner, ctx->midstates.sha512.outer, _byteArray, 8, hash, 1);
+            digestLength = SHA384_DIGEST_LENGTH;
+            break;
         case SHA512:
-            return(TOTP_HMAC_SHA512(_hmacKey, _keyLength, _byteArray, 8, 0));
+            HMAC_SHA512_from_midstates(ctx->midstates.sha512.inner, ctx->midstates.sha512.outer, _byteArray, 8, hash, 0);
+            digestLength = SHA512_DIGEST_LENGTH;
+            break;
         default:
             return(0);
     }
+
+    // STEP 2, apply dynamic truncation to obtain a 4-bytes string
+    uint32_t truncated_hash = 0;
+    uint8_t _offset = hash[digestLength - 1] & 0xF;
+    uint8_t j;
+    for (j = 0; j < 4; ++j) {
+        truncated_hash <<= 8;
+        truncated_hash  |= hash[_offset + j];
+    }
+
+    // STEP 3, compute the OTP value
+    truncated_hash &= 0x7FFFFFFF;
+    truncated_hash %= 1000000;
+
+    return truncated_hash;
+}
+
+void totp_cache_invalidate(totp_cache *cache) {
+    cache->valid = false;
+    cache->nextValid = false;
+}
+
+// If the cache is one step behind and already holds the next code, move forward without computing anything
+static void totp_cache_advance(totp_cache *cache, uint32_t steps) {
+    if (cache->valid && cache->nextValid && cache->steps + 1 == steps) {
+        cache->steps = steps;
+        cache->code = cache->nextCode;
+        cache->nextValid = false;
+    }
+}
+
+uint32_t totp_cache_get_code(totp_cache *cache, const totp_ctx *ctx, uint32_t steps) {
+    totp_cache_advance(cache, steps);
+    if (!cache->valid || cache->steps != steps) {
+        cache->steps = steps;
+        cache->code = totp_ctx_get_code_from_steps(ctx, steps);
+        cache->valid = true;
+        cache->nextValid = false;
+    }
+
+    return cache->code;
+}
+
+bool totp_cache_prefetch(totp_cache *cache, const totp_ctx *ctx, uint32_t steps) {
+    totp_cache_advance(cache, steps);
+    if (!cache->valid || cache->steps != steps) {
+        totp_cache_get_code(cache, ctx, steps);
+        return true;
+    }
+    if (!cache->nextValid) {
+        cache->nextCode = totp_ctx_get_code_from_steps(ctx, steps + 1);
+        cache->nextValid = true;
+        return true;
+    }
+
+    return false;
+}
+
+// Init the library with the private key, its length, the timeStep duration and the algorithm that should be used
+void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm) {
+    totp_ctx_init(&_ctx, hmacKey, keyLength, timeStep, algorithm);
+}
+
+void setTimezone(uint8_t timezone){
+    _timeZoneOffset = timezone;
+}
+
+static uint32_t TimeStruct2Timestamp(struct tm time){
+    //time.tm_mon -= 1;
+    //time.tm_year -= 1900;
+    return mktime(&(time)) - (_timeZoneOffset * 3600) - 2208988800;
+}
+
+// Generate a code, using the timestamp provided
+uint32_t getCodeFromTimestamp(uint32_t timeStamp) {
+    return totp_ctx_get_code_from_timestamp(&_ctx, timeStamp);
+}
+
+// Generate a code, using the timestamp provided
+uint32_t getCodeFromTimeStruct(struct tm time) {
+    return getCodeFromTimestamp(TimeStruct2Timestamp(time));
+}
+
+// Generate a code, using the number of steps provided
+uint32_t getCodeFromSteps(uint32_t steps) {
+    return totp_ctx_get_code_from_steps(&_ctx, steps);
 }
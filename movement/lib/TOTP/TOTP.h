@@ -2,6 +2,7 @@
 #define TOTP_H_
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include "time.h"
 
 typedef enum {
@@ -12,6 +13,49 @@ typedef enum {
     SHA512
 } hmac_alg;
 
+// Per-account state. Holds the HMAC inner and outer midstates instead of the key, so generating a code
+// costs two runs of the compression function and nothing here is shared between accounts.
+typedef struct {
+    hmac_alg algorithm;
+    uint32_t timeStep;
+    union {
+        struct {
+            uint32_t inner[5];
+            uint32_t outer[5];
+        } sha1;
+        struct {
+            uint32_t inner[8];
+            uint32_t outer[8];
+        } sha256;
+        struct {
+            uint64_t inner[8];
+            uint64_t outer[8];
+        } sha512;
+    } midstates;
+} totp_ctx;
+
+void totp_ctx_init(totp_ctx *ctx, const uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm);
+uint32_t totp_ctx_get_code_from_timestamp(const totp_ctx *ctx, uint32_t timeStamp);
+uint32_t totp_ctx_get_code_from_steps(const totp_ctx *ctx, uint32_t steps);
+
+// Holds the code for one time step and, once prefetched, the code for the step after it,
+// so that rolling over to the next step is a lookup instead of an HMAC.
+typedef struct {
+    uint32_t steps;
+    uint32_t code;
+    uint32_t nextCode;
+    bool valid;
+    bool nextValid;
+} totp_cache;
+
+void totp_cache_invalidate(totp_cache *cache);
+// Returns the code for the given step, computing it only if it isn't cached.
+uint32_t totp_cache_get_code(totp_cache *cache, const totp_ctx *ctx, uint32_t steps);
+// Does at most one code's worth of work towards caching the codes for steps and steps + 1.
+// Returns false if there was nothing left to do; call it when idle.
+bool totp_cache_prefetch(totp_cache *cache, const totp_ctx *ctx, uint32_t steps);
+
+// Single-account interface, kept for existing callers.
 void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm);
 void setTimezone(uint8_t timezone);
 uint32_t getCodeFromTimestamp(uint32_t timeStamp);
@@ -87,6 +87,10 @@ void mbedtls_sha1_starts( mbedtls_sha1_context *ctx )
 void mbedtls_sha1_process( mbedtls_sha1_context *ctx, const unsigned char data[SHA1_BLOCK_LENGTH] )
 {
     uint32_t temp, W[16], A, B, C, D, E;
+#if defined(MBEDTLS_SHA1_SMALLER)
+    uint32_t x;
+    unsigned int i;
+#endif
 
     GET_UINT32_BE( W[ 0], data,  0 );
     GET_UINT32_BE( W[ 1], data,  4 );
@@ -125,6 +129,34 @@ void mbedtls_sha1_process( mbedtls_sha1_context *ctx, const unsigned char data[S
     D = ctx->state[3];
     E = ctx->state[4];
 
+#if defined(MBEDTLS_SHA1_SMALLER)
+    /*
+     * Rolled variant: one round per iteration with the working variables
+     * shuffled down by hand. Roughly a fifth of the code size of the
+     * unrolled rounds below, at the cost of a branch and five moves a round.
+     */
+    for( i = 0; i < 80; i++ )
+    {
+        x = ( i < 16 ) ? W[i] : R(i);
+
+        if( i < 20 )
+            x += ( D ^ ( B & ( C ^ D ) ) ) + 0x5A827999;
+        else if( i < 40 )
+            x += ( B ^ C ^ D ) + 0x6ED9EBA1;
+        else if( i < 60 )
+            x += ( ( B & C ) | ( D & ( B | C ) ) ) + 0x8F1BBCDC;
+        else
+            x += ( B ^ C ^ D ) + 0xCA62C1D6;
+
+        x += S(A,5) + E;
+        E = D;
+        D = C;
+        C = S(B,30);
+        B = A;
+        A = x;
+    }
+#else /* MBEDTLS_SHA1_SMALLER */
+
 #define F(x,y,z) (z ^ (x & (y ^ z)))
 #define K 0x5A827999
 
@@ -232,6 +264,7 @@ void mbedtls_sha1_process( mbedtls_sha1_context *ctx, const unsigned char data[S
 
 #undef K
 #undef F
+#endif /* MBEDTLS_SHA1_SMALLER */
 
     ctx->state[0] += A;
     ctx->state[1] += B;
@@ -396,3 +429,59 @@ uint32_t TOTP_HMAC_SHA1(const uint8_t* key, size_t key_length, const uint8_t *in
 
     return truncated_hash;
 }
+
+/*
+* Precompute the HMAC_SHA1 inner and outer midstates for a key: the SHA1 state after absorbing the key XORd with ipad and opad
+*/
+void HMAC_SHA1_midstates(const uint8_t* key, size_t key_length, uint32_t inner[5], uint32_t outer[5]){
+  uint8_t i;
+  uint8_t k_pad[SHA1_BLOCK_LENGTH];
+  mbedtls_sha1_context ctx;
+
+  memset(k_pad, 0, sizeof(k_pad));
+  if (key_length <= SHA1_BLOCK_LENGTH) {
+      memcpy(k_pad, key, key_length);
+  } else {
+      mbedtls_sha1(key, key_length, k_pad);
+  }
+
+  mbedtls_sha1_init(&ctx);
+
+  for (i = 0; i < SHA1_BLOCK_LENGTH; i++) k_pad[i] ^= HMAC_IPAD;
+  mbedtls_sha1_starts(&ctx);
+  mbedtls_sha1_process(&ctx, k_pad);
+  memcpy(inner, ctx.state, sizeof(ctx.state));
+
+  // flip from ipad to opad without keeping a second copy of the key around
+  for (i = 0; i < SHA1_BLOCK_LENGTH; i++) k_pad[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+  mbedtls_sha1_starts(&ctx);
+  mbedtls_sha1_process(&ctx, k_pad);
+  memcpy(outer, ctx.state, sizeof(ctx.state));
+
+  mbedtls_zeroize(k_pad, sizeof(k_pad));
+  mbedtls_sha1_free(&ctx);
+}
+
+/*
+* Compute HMAC_SHA1 from precomputed midstates. For short messages this is just two runs of the compression function.
+*/
+void HMAC_SHA1_from_midstates(const uint32_t inner[5], const uint32_t outer[5], const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]){
+  mbedtls_sha1_context ctx;
+
+  mbedtls_sha1_init(&ctx);
+
+  // perform inner SHA1, picking up after the key block
+  memcpy(ctx.state, inner, sizeof(ctx.state));
+  ctx.total[0] = SHA1_BLOCK_LENGTH;
+  mbedtls_sha1_update(&ctx, in, n);
+  mbedtls_sha1_finish(&ctx, out);
+
+  // perform outer SHA1
+  memcpy(ctx.state, outer, sizeof(ctx.state));
+  ctx.total[0] = SHA1_BLOCK_LENGTH;
+  ctx.total[1] = 0;
+  mbedtls_sha1_update(&ctx, out, SHA1_DIGEST_LENGTH);
+  mbedtls_sha1_finish(&ctx, out);
+
+  mbedtls_sha1_free(&ctx);
+}
@@ -93,6 +93,8 @@ void mbedtls_sha1_process( mbedtls_sha1_context *ctx, const unsigned char data[S
 void mbedtls_sha1( const unsigned char *input, size_t ilen, unsigned char output[SHA1_DIGEST_LENGTH] );
 void HMAC_SHA1(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]);
 uint32_t TOTP_HMAC_SHA1(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n);
+void HMAC_SHA1_midstates(const uint8_t* key, size_t key_length, uint32_t inner[5], uint32_t outer[5]);
+void HMAC_SHA1_from_midstates(const uint32_t inner[5], const uint32_t outer[5], const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]);
 
 
 #endif /* mbedtls_sha1.h */
@@ -157,9 +157,16 @@ static const uint32_t K[] =
     d += temp1; h = temp1 + temp2;              \
 }
 
+#define W16(t)  W[( t ) & 0x0F]
+#define V(n)    A[( ( n ) - i ) & 7]
+
 void mbedtls_sha256_process( mbedtls_sha256_context *ctx, const unsigned char data[SHA256_BLOCK_LENGTH] )
 {
+#if defined(MBEDTLS_SHA256_SMALLER)
+    uint32_t temp1, temp2, W[16];
+#else
     uint32_t temp1, temp2, W[64];
+#endif
     uint32_t A[8];
     unsigned int i;
 
@@ -169,6 +176,21 @@ void mbedtls_sha256_process( mbedtls_sha256_context *ctx, const unsigned char da
     for( i = 0; i < 16; i++ )
         GET_UINT32_BE( W[i], data, 4 * i );
 
+#if defined(MBEDTLS_SHA256_SMALLER)
+    /*
+     * Rolled variant: the message schedule is kept in a 16-word ring, and
+     * rather than shuffling the eight working variables after every round,
+     * round i addresses them through an index rotated by i. 64 rounds is a
+     * multiple of eight, so A[] lines up with the state again at the end.
+     */
+    for( i = 0; i < 64; i++ )
+    {
+        if( i >= 16 )
+            W16(i) += S1(W16(i -  2)) + W16(i -  7) + S0(W16(i - 15));
+
+        P( V(0), V(1), V(2), V(3), V(4), V(5), V(6), V(7), W16(i), K[i] );
+    }
+#else /* MBEDTLS_SHA256_SMALLER */
     for( i = 0; i < 16; i += 8 )
     {
         P( A[0], A[1], A[2], A[3], A[4], A[5], A[6], A[7], W[i+0], K[i+0] );
@@ -193,6 +215,8 @@ void mbedtls_sha256_process( mbedtls_sha256_context *ctx, const unsigned char da
         P( A[1], A[2], A[3], A[4], A[5], A[6], A[7], A[0], R(i+7), K[i+7] );
     }
 
+#endif /* MBEDTLS_SHA256_SMALLER */
+
     for( i = 0; i < 8; i++ )
         ctx->state[i] += A[i];
 }
@@ -369,4 +393,62 @@ uint32_t TOTP_HMAC_SHA256(const uint8_t* key, size_t key_length, const uint8_t *
     truncated_hash %= 1000000;
 
     return truncated_hash;
-}
\ No newline at end of file
+}
+
+/*
+* Precompute the HMAC_SHA224/256 inner and outer midstates for a key: the SHA256 state after absorbing the key XORd with ipad and opad
+*/
+void HMAC_SHA256_midstates(const uint8_t* key, size_t key_length, uint32_t inner[8], uint32_t outer[8], int is224){
+  uint8_t i;
+  uint8_t k_pad[SHA256_BLOCK_LENGTH];
+  mbedtls_sha256_context ctx;
+
+  memset(k_pad, 0, sizeof(k_pad));
+  if (key_length <= SHA256_BLOCK_LENGTH) {
+      memcpy(k_pad, key, key_length);
+  } else {
+      mbedtls_sha256(key, key_length, k_pad, is224);
+  }
+
+  mbedtls_sha256_init(&ctx);
+
+  for (i = 0; i < SHA256_BLOCK_LENGTH; i++) k_pad[i] ^= HMAC_IPAD;
+  mbedtls_sha256_starts(&ctx, is224);
+  mbedtls_sha256_process(&ctx, k_pad);
+  memcpy(inner, ctx.state, sizeof(ctx.state));
+
+  // flip from ipad to opad without keeping a second copy of the key around
+  for (i = 0; i < SHA256_BLOCK_LENGTH; i++) k_pad[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+  mbedtls_sha256_starts(&ctx, is224);
+  mbedtls_sha256_process(&ctx, k_pad);
+  memcpy(outer, ctx.state, sizeof(ctx.state));
+
+  mbedtls_zeroize(k_pad, sizeof(k_pad));
+  mbedtls_sha256_free(&ctx);
+}
+
+/*
+* Compute HMAC_SHA224/256 from precomputed midstates. For short messages this is just two runs of the compression function.
+*/
+void HMAC_SHA256_from_midstates(const uint32_t inner[8], const uint32_t outer[8], const uint8_t *in, size_t n, uint8_t* out, int is224){
+  int digest_length = (is224 == 1) ? SHA224_DIGEST_LENGTH : SHA256_DIGEST_LENGTH;
+  mbedtls_sha256_context ctx;
+
+  mbedtls_sha256_init(&ctx);
+  ctx.is224 = is224;
+
+  // perform inner SHA256, picking up after the key block
+  memcpy(ctx.state, inner, sizeof(ctx.state));
+  ctx.total[0] = SHA256_BLOCK_LENGTH;
+  mbedtls_sha256_update(&ctx, in, n);
+  mbedtls_sha256_finish(&ctx, out);
+
+  // perform outer SHA256
+  memcpy(ctx.state, outer, sizeof(ctx.state));
+  ctx.total[0] = SHA256_BLOCK_LENGTH;
+  ctx.total[1] = 0;
+  mbedtls_sha256_update(&ctx, out, digest_length);
+  mbedtls_sha256_finish(&ctx, out);
+
+  mbedtls_sha256_free(&ctx);
+}
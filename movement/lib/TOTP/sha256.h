@@ -108,5 +108,7 @@ void mbedtls_sha256( const unsigned char *input, size_t ilen,
            unsigned char* output, int is224 );
 void HMAC_SHA256(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is224);
 uint32_t TOTP_HMAC_SHA256(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, int is224);
+void HMAC_SHA256_midstates(const uint8_t* key, size_t key_length, uint32_t inner[8], uint32_t outer[8], int is224);
+void HMAC_SHA256_from_midstates(const uint32_t inner[8], const uint32_t outer[8], const uint8_t *in, size_t n, uint8_t* out, int is224);
 
 #endif /* mbedtls_sha256.h */
@@ -173,6 +173,129 @@ void mbedtls_sha512_starts( mbedtls_sha512_context *ctx, int is384 )
     ctx->is384 = is384;
 }
 
+#if defined(MBEDTLS_SHA512_SMALLER)
+/*
+ * SHA-512 on 32-bit limbs, for cores like the Cortex-M0+ that have neither
+ * 64-bit registers nor room to keep 64-bit temporaries out of the stack.
+ * Each word is a hi/lo pair, every rotation is done on the halves directly
+ * (one shifted by n, one by 32 + n), the message schedule is a 16-entry ring
+ * instead of W[80] and the rounds run as one rolled loop, addressing the
+ * working variables by an index rotated by the round number.
+ */
+typedef struct
+{
+    uint32_t hi;
+    uint32_t lo;
+}
+sha512_limbs;
+
+static inline sha512_limbs sha512_add( sha512_limbs a, sha512_limbs b )
+{
+    sha512_limbs r;
+
+    r.lo = a.lo + b.lo;
+    r.hi = a.hi + b.hi + ( r.lo < a.lo );
+    return( r );
+}
+
+/* rotate right by n, 0 < n < 32 */
+static inline sha512_limbs sha512_rotr( sha512_limbs x, unsigned int n )
+{
+    sha512_limbs r;
+
+    r.hi = ( x.hi >> n ) | ( x.lo << ( 32 - n ) );
+    r.lo = ( x.lo >> n ) | ( x.hi << ( 32 - n ) );
+    return( r );
+}
+
+/* rotate right by 32 + n, 0 < n < 32 */
+static inline sha512_limbs sha512_rotr32( sha512_limbs x, unsigned int n )
+{
+    sha512_limbs r;
+
+    r.hi = ( x.lo >> n ) | ( x.hi << ( 32 - n ) );
+    r.lo = ( x.hi >> n ) | ( x.lo << ( 32 - n ) );
+    return( r );
+}
+
+/* shift right by n, 0 < n < 32 */
+static inline sha512_limbs sha512_shr( sha512_limbs x, unsigned int n )
+{
+    sha512_limbs r;
+
+    r.hi = x.hi >> n;
+    r.lo = ( x.lo >> n ) | ( x.hi << ( 32 - n ) );
+    return( r );
+}
+
+static inline sha512_limbs sha512_xor3( sha512_limbs a, sha512_limbs b, sha512_limbs c )
+{
+    sha512_limbs r;
+
+    r.hi = a.hi ^ b.hi ^ c.hi;
+    r.lo = a.lo ^ b.lo ^ c.lo;
+    return( r );
+}
+
+#define S0(x) sha512_xor3( sha512_rotr(x, 1), sha512_rotr(x, 8), sha512_shr(x, 7) )
+#define S1(x) sha512_xor3( sha512_rotr(x,19), sha512_rotr32(x,29), sha512_shr(x, 6) )
+
+#define S2(x) sha512_xor3( sha512_rotr(x,28), sha512_rotr32(x, 2), sha512_rotr32(x, 7) )
+#define S3(x) sha512_xor3( sha512_rotr(x,14), sha512_rotr(x,18), sha512_rotr32(x, 9) )
+
+#define F0(x,y,z) ((x & y) | (z & (x | y)))
+#define F1(x,y,z) (z ^ (x & (y ^ z)))
+
+#define W16(t)  W[( t ) & 0x0F]
+#define V(n)    A[( ( n ) - i ) & 7]
+
+void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char data[SHA512_BLOCK_LENGTH] )
+{
+    unsigned int i;
+    sha512_limbs temp1, temp2, f, k, W[16], A[8];
+
+    for( i = 0; i < 8; i++ )
+    {
+        A[i].hi = (uint32_t) ( ctx->state[i] >> 32 );
+        A[i].lo = (uint32_t) ( ctx->state[i] );
+    }
+
+    for( i = 0; i < 16; i++ )
+    {
+        const unsigned char *b = data + ( i << 3 );
+
+        W[i].hi = ( (uint32_t) b[0] << 24 ) | ( (uint32_t) b[1] << 16 )
+                | ( (uint32_t) b[2] <<  8 ) | ( (uint32_t) b[3]       );
+        W[i].lo = ( (uint32_t) b[4] << 24 ) | ( (uint32_t) b[5] << 16 )
+                | ( (uint32_t) b[6] <<  8 ) | ( (uint32_t) b[7]       );
+    }
+
+    for( i = 0; i < 80; i++ )
+    {
+        if( i >= 16 )
+            W16(i) = sha512_add( sha512_add( W16(i), S1(W16(i - 2)) ),
+                                 sha512_add( W16(i - 7), S0(W16(i - 15)) ) );
+
+        k.hi = (uint32_t) ( K[i] >> 32 );
+        k.lo = (uint32_t) ( K[i] );
+
+        f.hi = F1( V(4).hi, V(5).hi, V(6).hi );
+        f.lo = F1( V(4).lo, V(5).lo, V(6).lo );
+        temp1 = sha512_add( sha512_add( V(7), S3(V(4)) ),
+                            sha512_add( sha512_add( f, k ), W16(i) ) );
+
+        f.hi = F0( V(0).hi, V(1).hi, V(2).hi );
+        f.lo = F0( V(0).lo, V(1).lo, V(2).lo );
+        temp2 = sha512_add( S2(V(0)), f );
+
+        V(3) = sha512_add( V(3), temp1 );
+        V(7) = sha512_add( temp1, temp2 );
+    }
+
+    for( i = 0; i < 8; i++ )
+        ctx->state[i] += ( (uint64_t) A[i].hi << 32 ) | A[i].lo;
+}
+#else /* MBEDTLS_SHA512_SMALLER */
 void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char data[SHA512_BLOCK_LENGTH] )
 {
     int i;
@@ -241,6 +364,7 @@ void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char da
     ctx->state[6] += G;
     ctx->state[7] += H;
 }
+#endif /* MBEDTLS_SHA512_SMALLER */
 
 /*
  * SHA-512 process buffer
@@ -419,4 +543,62 @@ uint32_t TOTP_HMAC_SHA512(const uint8_t* key, size_t key_length, const uint8_t *
     truncated_hash %= 1000000;
 
     return truncated_hash;
-}
\ No newline at end of file
+}
+
+/*
+* Precompute the HMAC_SHA384/512 inner and outer midstates for a key: the SHA512 state after absorbing the key XORd with ipad and opad
+*/
+void HMAC_SHA512_midstates(const uint8_t* key, size_t key_length, uint64_t inner[8], uint64_t outer[8], int is384){
+  uint8_t i;
+  uint8_t k_pad[SHA512_BLOCK_LENGTH];
+  mbedtls_sha512_context ctx;
+
+  memset(k_pad, 0, sizeof(k_pad));
+  if (key_length <= SHA512_BLOCK_LENGTH) {
+      memcpy(k_pad, key, key_length);
+  } else {
+      mbedtls_sha512(key, key_length, k_pad, is384);
+  }
+
+  mbedtls_sha512_init(&ctx);
+
+  for (i = 0; i < SHA512_BLOCK_LENGTH; i++) k_pad[i] ^= HMAC_IPAD;
+  mbedtls_sha512_starts(&ctx, is384);
+  mbedtls_sha512_process(&ctx, k_pad);
+  memcpy(inner, ctx.state, sizeof(ctx.state));
+
+  // flip from ipad to opad without keeping a second copy of the key around
+  for (i = 0; i < SHA512_BLOCK_LENGTH; i++) k_pad[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+  mbedtls_sha512_starts(&ctx, is384);
+  mbedtls_sha512_process(&ctx, k_pad);
+  memcpy(outer, ctx.state, sizeof(ctx.state));
+
+  mbedtls_zeroize(k_pad, sizeof(k_pad));
+  mbedtls_sha512_free(&ctx);
+}
+
+/*
+* Compute HMAC_SHA384/512 from precomputed midstates. For short messages this is just two runs of the compression function.
+*/
+void HMAC_SHA512_from_midstates(const uint64_t inner[8], const uint64_t outer[8], const uint8_t *in, size_t n, uint8_t* out, int is384){
+  int digest_length = (is384 == 1) ? SHA384_DIGEST_LENGTH : SHA512_DIGEST_LENGTH;
+  mbedtls_sha512_context ctx;
+
+  mbedtls_sha512_init(&ctx);
+  ctx.is384 = is384;
+
+  // perform inner SHA512, picking up after the key block
+  memcpy(ctx.state, inner, sizeof(ctx.state));
+  ctx.total[0] = SHA512_BLOCK_LENGTH;
+  mbedtls_sha512_update(&ctx, in, n);
+  mbedtls_sha512_finish(&ctx, out);
+
+  // perform outer SHA512
+  memcpy(ctx.state, outer, sizeof(ctx.state));
+  ctx.total[0] = SHA512_BLOCK_LENGTH;
+  ctx.total[1] = 0;
+  mbedtls_sha512_update(&ctx, out, digest_length);
+  mbedtls_sha512_finish(&ctx, out);
+
+  mbedtls_sha512_free(&ctx);
+}
@@ -115,5 +115,7 @@ int mbedtls_sha512_self_test( int verbose );
 void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char data[SHA512_BLOCK_LENGTH] );
 void HMAC_SHA512(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is384);
 uint32_t TOTP_HMAC_SHA512(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, int is384);
+void HMAC_SHA512_midstates(const uint8_t* key, size_t key_length, uint64_t inner[8], uint64_t outer[8], int is384);
+void HMAC_SHA512_from_midstates(const uint64_t inner[8], const uint64_t outer[8], const uint8_t *in, size_t n, uint8_t* out, int is384);
 
 #endif /* mbedtls_sha512.h */
@@ -0,0 +1,203 @@
+/**
+ * test_sha.c
+ *
+ * Known-answer tests and a rough benchmark for the SHA compression kernels,
+ * run on the host rather than the watch:
+ *
+ *   cc -O2 -I. -o test_sha test_sha.c sha1.c sha256.c sha512.c TOTP.c && ./test_sha
+ *
+ * Add -DMBEDTLS_SHA1_SMALLER, -DMBEDTLS_SHA256_SMALLER and/or
+ * -DMBEDTLS_SHA512_SMALLER to test the rolled kernels instead. Pass --bench
+ * to also time each kernel; on x86 this reports TSC cycles per block,
+ * elsewhere nanoseconds per block.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "sha1.h"
+#include "sha256.h"
+#include "sha512.h"
+#include "TOTP.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+static uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static uint64_t bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+static const char *msg_abc = "abc";
+static const char *msg_448 = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static const char *msg_896 = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                             "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+static int failures = 0;
+
+static void check(const char *name, const uint8_t *digest, size_t len, const char *expected) {
+    char hex[129];
+    for (size_t i = 0; i < len; i++) sprintf(hex + 2 * i, "%02x", digest[i]);
+    if (strcmp(hex, expected) == 0) {
+        printf("ok    %s\n", name);
+    } else {
+        printf("FAIL  %s\n      got      %s\n      expected %s\n", name, hex, expected);
+        failures++;
+    }
+}
+
+static void check_code(const char *name, uint32_t code, uint32_t expected) {
+    if (code == expected) {
+        printf("ok    %s\n", name);
+    } else {
+        printf("FAIL  %s: got %06u, expected %06u\n", name, (unsigned)code, (unsigned)expected);
+        failures++;
+    }
+}
+
+static void test_sha1(void) {
+    uint8_t out[SHA1_DIGEST_LENGTH];
+    mbedtls_sha1_context ctx;
+    uint8_t block[1000];
+
+    mbedtls_sha1((const uint8_t *)msg_abc, 3, out);
+    check("SHA-1 abc", out, sizeof(out), "a9993e364706816aba3e25717850c26c9cd0d89d");
+    mbedtls_sha1((const uint8_t *)msg_448, 56, out);
+    check("SHA-1 448-bit", out, sizeof(out), "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+
+    memset(block, 'a', sizeof(block));
+    mbedtls_sha1_init(&ctx);
+    mbedtls_sha1_starts(&ctx);
+    for (int i = 0; i < 1000; i++) mbedtls_sha1_update(&ctx, block, sizeof(block));
+    mbedtls_sha1_finish(&ctx, out);
+    mbedtls_sha1_free(&ctx);
+    check("SHA-1 million a", out, sizeof(out), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+
+    HMAC_SHA1((const uint8_t *)"Jefe", 4, (const uint8_t *)"what do ya want for nothing?", 28, out);
+    check("HMAC-SHA-1 RFC 2202 #2", out, sizeof(out), "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79");
+}
+
+static void test_sha256(void) {
+    uint8_t out[SHA256_DIGEST_LENGTH];
+    mbedtls_sha256_context ctx;
+    uint8_t block[1000];
+
+    mbedtls_sha256((const uint8_t *)msg_abc, 3, out, 1);
+    check("SHA-224 abc", out, SHA224_DIGEST_LENGTH, "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+    mbedtls_sha256((const uint8_t *)msg_abc, 3, out, 0);
+    check("SHA-256 abc", out, sizeof(out), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    mbedtls_sha256((const uint8_t *)msg_448, 56, out, 0);
+    check("SHA-256 448-bit", out, sizeof(out), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    memset(block, 'a', sizeof(block));
+    mbedtls_sha256_init(&ctx);
+    mbedtls_sha256_starts(&ctx, 0);
+    for (int i = 0; i < 1000; i++) mbedtls_sha256_update(&ctx, block, sizeof(block));
+    mbedtls_sha256_finish(&ctx, out);
+    mbedtls_sha256_free(&ctx);
+    check("SHA-256 million a", out, sizeof(out), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+    HMAC_SHA256((const uint8_t *)"Jefe", 4, (const uint8_t *)"what do ya want for nothing?", 28, out, 0);
+    check("HMAC-SHA-256 RFC 4231 #2", out, sizeof(out), "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+}
+
+static void test_sha512(void) {
+    uint8_t out[SHA512_DIGEST_LENGTH];
+    mbedtls_sha512_context ctx;
+    uint8_t block[1000];
+
+    mbedtls_sha512((const uint8_t *)msg_abc, 3, out, 1);
+    check("SHA-384 abc", out, SHA384_DIGEST_LENGTH,
+          "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+    mbedtls_sha512((const uint8_t *)msg_abc, 3, out, 0);
+    check("SHA-512 abc", out, sizeof(out),
+          "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd"
+          "454d4423643ce80e2a9ac94fa54ca49f");
+    mbedtls_sha512((const uint8_t *)msg_896, 112, out, 0);
+    check("SHA-512 896-bit", out, sizeof(out),
+          "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433a"
+          "c7d329eeb6dd26545e96e55b874be909");
+
+    memset(block, 'a', sizeof(block));
+    mbedtls_sha512_init(&ctx);
+    mbedtls_sha512_starts(&ctx, 0);
+    for (int i = 0; i < 1000; i++) mbedtls_sha512_update(&ctx, block, sizeof(block));
+    mbedtls_sha512_finish(&ctx, out);
+    mbedtls_sha512_free(&ctx);
+    check("SHA-512 million a", out, sizeof(out),
+          "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31b"
+          "eb009c5c2c49aa2e4eadb217ad8cc09b");
+
+    HMAC_SHA512((const uint8_t *)"Jefe", 4, (const uint8_t *)"what do ya want for nothing?", 28, out, 0);
+    check("HMAC-SHA-512 RFC 4231 #2", out, sizeof(out),
+          "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea2505549758bf75c05a994a6d034f65f8f0e6fd"
+          "caeab1a34d4a6b4b636e070a38bce737");
+}
+
+static void test_totp(void) {
+    // RFC 6238 appendix B, eight digits truncated to the six the watch displays
+    static const uint8_t seed20[] = "12345678901234567890";
+    static const uint8_t seed32[] = "12345678901234567890123456789012";
+    static const uint8_t seed64[] = "1234567890123456789012345678901234567890123456789012345678901234";
+    totp_ctx ctx;
+
+    totp_ctx_init(&ctx, seed20, 20, 30, SHA1);
+    check_code("TOTP SHA-1 59", totp_ctx_get_code_from_timestamp(&ctx, 59), 287082);
+    check_code("TOTP SHA-1 1111111109", totp_ctx_get_code_from_timestamp(&ctx, 1111111109), 81804);
+    check_code("TOTP SHA-1 1111111111", totp_ctx_get_code_from_timestamp(&ctx, 1111111111), 50471);
+    totp_ctx_init(&ctx, seed32, 32, 30, SHA256);
+    check_code("TOTP SHA-256 59", totp_ctx_get_code_from_timestamp(&ctx, 59), 119246);
+    check_code("TOTP SHA-256 1234567890", totp_ctx_get_code_from_timestamp(&ctx, 1234567890), 819424);
+    totp_ctx_init(&ctx, seed64, 64, 30, SHA512);
+    check_code("TOTP SHA-512 59", totp_ctx_get_code_from_timestamp(&ctx, 59), 693936);
+    check_code("TOTP SHA-512 2000000000", totp_ctx_get_code_from_timestamp(&ctx, 2000000000), 618901);
+}
+
+#define BENCH_BLOCKS 20000
+
+static void bench(void) {
+    static uint8_t data[SHA512_BLOCK_LENGTH];
+    mbedtls_sha1_context sha1;
+    mbedtls_sha256_context sha256;
+    mbedtls_sha512_context sha512;
+    uint64_t start;
+
+    memset(data, 0x5a, sizeof(data));
+
+    mbedtls_sha1_init(&sha1);
+    mbedtls_sha1_starts(&sha1);
+    start = bench_now();
+    for (int i = 0; i < BENCH_BLOCKS; i++) mbedtls_sha1_process(&sha1, data);
+    printf("SHA-1   %8.1f %s/block\n", (double)(bench_now() - start) / BENCH_BLOCKS, BENCH_UNIT);
+
+    mbedtls_sha256_init(&sha256);
+    mbedtls_sha256_starts(&sha256, 0);
+    start = bench_now();
+    for (int i = 0; i < BENCH_BLOCKS; i++) mbedtls_sha256_process(&sha256, data);
+    printf("SHA-256 %8.1f %s/block\n", (double)(bench_now() - start) / BENCH_BLOCKS, BENCH_UNIT);
+
+    mbedtls_sha512_init(&sha512);
+    mbedtls_sha512_starts(&sha512, 0);
+    start = bench_now();
+    for (int i = 0; i < BENCH_BLOCKS; i++) mbedtls_sha512_process(&sha512, data);
+    printf("SHA-512 %8.1f %s/block\n", (double)(bench_now() - start) / BENCH_BLOCKS, BENCH_UNIT);
+
+    // keep the compiler from discarding the loops
+    printf("(state %08x %08x %016llx)\n", (unsigned)sha1.state[0], (unsigned)sha256.state[0],
+           (unsigned long long)sha512.state[0]);
+}
+
+int main(int argc, char **argv) {
+    test_sha1();
+    test_sha256();
+    test_sha512();
+    test_totp();
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) bench();
+
+    printf("%s\n", failures ? "FAILED" : "all tests passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "activity.h"
+
+// Readings are left-justified 14-bit values; at ±4 g this brings 1 g to 512 counts.
+#define ACTIVITY_INPUT_SHIFT 4
+// Time constant of the gravity filter, as a shift: 2^6 samples is about 2.5 seconds at 25 Hz.
+#define ACTIVITY_GRAVITY_SHIFT 6
+
+// The dynamic acceleration has to swing this far past zero to count as a crossing (about 0.03 g).
+#define ACTIVITY_CROSSING_HYSTERESIS 15
+// A step is a peak of at least 0.08 g followed by a return through zero.
+#define ACTIVITY_STEP_THRESHOLD 41
+// Steps closer together than this (~214 steps per minute) are bounces or shaking, not steps.
+#define ACTIVITY_MIN_STEP_INTERVAL 7
+// Steps further apart than this (2 seconds) end a walk.
+#define ACTIVITY_MAX_STEP_INTERVAL 50
+// We only start counting once we've seen this many steps in a row; then we count all of them.
+#define ACTIVITY_STEP_RUN_LENGTH 4
+
+// Decision tree thresholds.
+#define ACTIVITY_IDLE_ENERGY 655            // (0.05 g)^2
+#define ACTIVITY_RUN_ENERGY 65536           // (0.5 g)^2
+#define ACTIVITY_RUN_STEP_INTERVAL 11       // ~136 steps per minute
+#define ACTIVITY_MAX_LOCOMOTION_CROSSINGS 20
+
+static uint16_t _activity_isqrt(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint16_t)result;
+}
+
+static void _activity_register_step(activity_state_t *state) {
+    uint8_t interval = state->samples_since_step;
+
+    state->samples_since_step = 0;
+    if (interval < ACTIVITY_MIN_STEP_INTERVAL) {
+        // too fast to be walking; whatever this is, it breaks the rhythm.
+        state->step_run = 0;
+        state->pending_steps = 0;
+        state->step_interval = 0;
+        return;
+    }
+    if (interval > ACTIVITY_MAX_STEP_INTERVAL || state->step_run == 0) {
+        // first step of a new run; we can't tell its interval yet.
+        state->step_run = 1;
+        state->pending_steps = 1;
+        state->step_interval = 0;
+        return;
+    }
+
+    if (state->step_interval) state->step_interval = (state->step_interval * 3 + interval) / 4;
+    else state->step_interval = interval;
+
+    if (state->step_run < ACTIVITY_STEP_RUN_LENGTH) {
+        state->step_run++;
+        state->pending_steps++;
+        if (state->step_run == ACTIVITY_STEP_RUN_LENGTH) {
+            state->steps += state->pending_steps;
+            state->pending_steps = 0;
+        }
+    } else {
+        state->steps++;
+    }
+}
+
+static void _activity_update_window(activity_state_t *state, int16_t value) {
+    uint8_t pos = state->window_pos;
+    uint8_t mask = 1 << (pos % 8);
+    int8_t sign = state->last_sign;
+
+    if (state->window_fill == ACTIVITY_WINDOW_SIZE) {
+        // drop the oldest sample's contribution
+        state->energy_sum -= (int32_t)state->window[pos] * state->window[pos];
+        if (state->crossings[pos / 8] & mask) state->crossing_count--;
+    } else {
+        state->window_fill++;
+    }
+
+    state->window[pos] = value;
+    state->energy_sum += (int32_t)value * value;
+
+    if (value > ACTIVITY_CROSSING_HYSTERESIS) sign = 1;
+    else if (value < -ACTIVITY_CROSSING_HYSTERESIS) sign = -1;
+    if (state->last_sign != 0 && sign != state->last_sign) {
+        state->crossings[pos / 8] |= mask;
+        state->crossing_count++;
+    } else {
+        state->crossings[pos / 8] &= ~mask;
+    }
+    state->last_sign = sign;
+
+    state->window_pos = (pos + 1) % ACTIVITY_WINDOW_SIZE;
+}
+
+void activity_init(activity_state_t *state) {
+    memset(state, 0, sizeof(activity_state_t));
+    state->samples_since_step = 255;
+    state->samples_until_classification = ACTIVITY_SAMPLE_RATE;
+}
+
+void activity_add_sample(activity_state_t *state, int16_t x, int16_t y, int16_t z) {
+    int32_t ax = x >> ACTIVITY_INPUT_SHIFT;
+    int32_t ay = y >> ACTIVITY_INPUT_SHIFT;
+    int32_t az = z >> ACTIVITY_INPUT_SHIFT;
+    int32_t magnitude = _activity_isqrt(ax * ax + ay * ay + az * az);
+
+    // split the magnitude into gravity and dynamic acceleration, then take the edge off the high frequencies.
+    if (state->gravity == 0) state->gravity = magnitude << 4;
+    else state->gravity += ((magnitude << 4) - state->gravity) >> ACTIVITY_GRAVITY_SHIFT;
+    int32_t dynamic = magnitude - (state->gravity >> 4);
+    state->smoothed += (dynamic - state->smoothed) / 2;
+
+    _activity_update_window(state, state->smoothed);
+
+    if (state->samples_since_step < 255) state->samples_since_step++;
+    if (state->samples_since_step > ACTIVITY_MAX_STEP_INTERVAL) {
+        state->step_run = 0;
+        state->pending_steps = 0;
+        state->step_interval = 0;
+    }
+    if (!state->step_armed && state->smoothed > ACTIVITY_STEP_THRESHOLD) {
+        state->step_armed = true;
+    } else if (state->step_armed && state->smoothed < 0) {
+        state->step_armed = false;
+        _activity_register_step(state);
+    }
+
+    if (--state->samples_until_classification == 0) {
+        state->samples_until_classification = ACTIVITY_SAMPLE_RATE;
+        if (state->window_fill == ACTIVITY_WINDOW_SIZE) {
+            activity_features_t features;
+            activity_get_features(state, &features);
+            state->current_class = activity_classify(&features);
+            state->seconds[state->current_class]++;
+        }
+    }
+}
+
+void activity_get_features(activity_state_t *state, activity_features_t *features) {
+    features->magnitude = state->gravity >> 4;
+    features->energy = state->window_fill ? state->energy_sum / state->window_fill : 0;
+    features->zero_crossings = state->crossing_count;
+    features->step_interval = (state->step_run >= ACTIVITY_STEP_RUN_LENGTH) ? state->step_interval : 0;
+}
+
+activity_class_t activity_get_class(activity_state_t *state) {
+    return state->current_class;
+}
+
+activity_class_t activity_classify(const activity_features_t *features) {
+    if (features->energy < ACTIVITY_IDLE_ENERGY) return ACTIVITY_IDLE;
+
+    // walking and running are rhythmic, and slower than shaking or scrubbing.
+    if (features->step_interval && features->zero_crossings <= ACTIVITY_MAX_LOCOMOTION_CROSSINGS) {
+        if (features->step_interval <= ACTIVITY_RUN_STEP_INTERVAL || features->energy >= ACTIVITY_RUN_ENERGY) return ACTIVITY_RUNNING;
+        return ACTIVITY_WALKING;
+    }
+
+    return ACTIVITY_OTHER;
+}
@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ACTIVITY_H_
+#define ACTIVITY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Integer-only step counter and activity classifier.
+ *
+ * Feed it accelerometer samples one at a time (typically one FIFO batch per second) and it keeps
+ * running totals of steps and of the number of seconds spent in each activity class. Nothing but
+ * these totals and a small sliding window is ever kept, so memory use is fixed.
+ *
+ * Samples are raw, left-justified LIS2DW readings at a range of ±4 g and a data rate of 25 Hz.
+ * Internally they are scaled so that 1 g is 512 counts.
+ */
+
+#define ACTIVITY_SAMPLE_RATE 25
+// The sliding window for the band energy and zero crossing features. Must be a power of two.
+#define ACTIVITY_WINDOW_SIZE 64
+#define ACTIVITY_ONE_G 512
+
+typedef enum {
+    ACTIVITY_IDLE = 0,
+    ACTIVITY_WALKING,
+    ACTIVITY_RUNNING,
+    ACTIVITY_OTHER,     // moving, but not in a way that looks like walking or running
+    ACTIVITY_NUM_CLASSES
+} activity_class_t;
+
+typedef struct {
+    uint16_t magnitude;     // slow-moving average of the acceleration magnitude, i.e. gravity
+    uint32_t energy;        // mean square of the dynamic acceleration over the window
+    uint8_t zero_crossings; // number of times the dynamic acceleration changed sign over the window
+    uint8_t step_interval;  // average number of samples between steps, or 0 if not stepping
+} activity_features_t;
+
+// Holds state used by the classifier. Do not manipulate directly.
+typedef struct {
+    // filters
+    int32_t gravity;            // low-passed magnitude, in 1/16 counts
+    int16_t smoothed;           // low-passed dynamic acceleration
+    // sliding window
+    int16_t window[ACTIVITY_WINDOW_SIZE];
+    uint8_t crossings[ACTIVITY_WINDOW_SIZE / 8];
+    uint32_t energy_sum;
+    uint8_t crossing_count;
+    uint8_t window_pos;
+    uint8_t window_fill;
+    int8_t last_sign;
+    uint8_t samples_until_classification;
+    // step detector
+    bool step_armed;
+    uint8_t samples_since_step;
+    uint8_t step_interval;
+    uint8_t step_run;
+    uint8_t pending_steps;
+    // results
+    activity_class_t current_class;
+    uint32_t steps;
+    uint32_t seconds[ACTIVITY_NUM_CLASSES];
+} activity_state_t;
+
+/** @brief Resets the classifier, including the step and activity totals.
+ */
+void activity_init(activity_state_t *state);
+
+/** @brief Processes one accelerometer sample.
+ * @param state Pointer to the classifier state.
+ * @param x, y, z The raw reading from the accelerometer.
+ */
+void activity_add_sample(activity_state_t *state, int16_t x, int16_t y, int16_t z);
+
+/** @brief Gets the features the classifier is currently looking at.
+ */
+void activity_get_features(activity_state_t *state, activity_features_t *features);
+
+/** @brief Returns the most recent classification. This is updated once per second of samples.
+ */
+activity_class_t activity_get_class(activity_state_t *state);
+
+/** @brief Classifies a set of features. Exposed so it can be tested on its own.
+ */
+activity_class_t activity_classify(const activity_features_t *features);
+
+#endif // ACTIVITY_H_
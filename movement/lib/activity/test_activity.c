@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Feeds synthetic accelerometer traces through the step counter and classifier.
+// cc activity.c test_activity.c -lm && ./a.out
+
+#include <stdio.h>
+#include <math.h>
+
+#include "activity.h"
+
+#define RAW_ONE_G (ACTIVITY_ONE_G << 4)
+
+static int failures = 0;
+
+static void run_trace(activity_state_t *state, float frequency, float amplitude, int seconds) {
+    for (int i = 0; i < seconds * ACTIVITY_SAMPLE_RATE; i++) {
+        float t = (float)i / ACTIVITY_SAMPLE_RATE;
+        int16_t z = (int16_t)(RAW_ONE_G * (1.0f + amplitude * sinf(2 * M_PI * frequency * t)));
+        // tilt the watch a little so all three axes carry some signal
+        activity_add_sample(state, RAW_ONE_G / 8, -RAW_ONE_G / 16, z);
+    }
+}
+
+static void check(const char *name, activity_state_t *state, uint32_t min_steps, uint32_t max_steps, activity_class_t expected) {
+    activity_class_t actual = activity_get_class(state);
+    bool ok = state->steps >= min_steps && state->steps <= max_steps && actual == expected;
+
+    printf("%-8s steps %4lu (expected %lu-%lu), class %d (expected %d): %s\n", name,
+           (unsigned long)state->steps, (unsigned long)min_steps, (unsigned long)max_steps,
+           actual, expected, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+int main(void) {
+    activity_state_t state;
+
+    activity_init(&state);
+    run_trace(&state, 0, 0, 60);
+    check("still", &state, 0, 0, ACTIVITY_IDLE);
+
+    activity_init(&state);
+    run_trace(&state, 1.8, 0.3, 60);
+    check("walking", &state, 100, 110, ACTIVITY_WALKING);
+
+    activity_init(&state);
+    run_trace(&state, 2.8, 0.8, 60);
+    check("running", &state, 160, 170, ACTIVITY_RUNNING);
+
+    activity_init(&state);
+    run_trace(&state, 6, 0.3, 60);
+    check("shaking", &state, 0, 0, ACTIVITY_OTHER);
+
+    return failures;
+}
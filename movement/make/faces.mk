@@ -0,0 +1,41 @@
+# Works out which watch faces this firmware uses, and drops every other face from SRCS along with
+# any library in ../lib that none of the remaining faces needs. The list of faces comes from the
+# same header movement.c includes: the face named by FACE=, the alt_fw header for FIRMWARE=, or
+# movement_config.h otherwise. Set ALL_FACES=1 to compile every face, e.g. to check they all build.
+
+# Declared here so it stays the default goal; rules.mk adds its prerequisites.
+all:
+
+ifdef FACE
+SELECTED_FACES := $(FACE)
+else
+ifeq ($(filter-out STANDARD,$(FIRMWARE)),)
+FACE_CONFIG = ../movement_config.h
+else
+FACE_CONFIG = ../alt_fw/$(shell echo $(FIRMWARE) | tr '[:upper:]' '[:lower:]').h
+endif
+# Every name between "watch_faces[] = {" and the closing brace, minus comments.
+SELECTED_FACES := $(sort $(shell awk '/watch_faces\[\] *=/ { inside = 1; next } inside && /}/ { inside = 0 } inside' $(FACE_CONFIG) | sed 's@//.*@@' | grep -o '[A-Za-z0-9_]\+'))
+endif
+SELECTED_FACES := $(SELECTED_FACES) $(foreach face,$(SELECTED_FACES),$(FACE_DEPS_$(face)))
+
+OPTIONAL_LIBS := $(patsubst FACE_LIBS_%,%,$(filter FACE_LIBS_%,$(.VARIABLES)))
+
+ifndef ALL_FACES
+UNUSED_FACE_SRCS := $(filter-out $(foreach face,$(SELECTED_FACES),%/$(face).c),$(filter ../watch_faces/%,$(SRCS)))
+UNUSED_LIBS := $(foreach lib,$(OPTIONAL_LIBS),$(if $(filter $(SELECTED_FACES),$(FACE_LIBS_$(lib))),,$(lib)))
+SRCS := $(filter-out $(UNUSED_FACE_SRCS) $(foreach lib,$(UNUSED_LIBS),../lib/$(lib)/%),$(SRCS))
+endif
+
+# Prints what each face and library in this build costs, from its object file: flash is text plus
+# data, RAM is data plus bss. Unused functions haven't been discarded by the linker yet at this
+# point, so treat these as upper bounds.
+FACE_SIZE_SRCS = $(filter ../watch_faces/% $(foreach lib,$(OPTIONAL_LIBS),../lib/$(lib)/%),$(SRCS))
+
+face-sizes: all
+	@$(or $(SIZE),size) $(addprefix $(BUILD)/, $(notdir $(FACE_SIZE_SRCS:.c=.o))) | awk ' \
+		NR == 1 { printf "%-40s %8s %8s\n", "object", "flash", "ram"; next } \
+		{ n = split($$6, path, "/"); printf "%-40s %8d %8d\n", substr(path[n], 1, length(path[n]) - 2), $$1 + $$2, $$2 + $$3; flash += $$1 + $$2; ram += $$2 + $$3 } \
+		END { printf "%-40s %8d %8d\n", "total", flash, ram }'
+
+.PHONY: face-sizes
@@ -23,6 +23,9 @@
  */
 
 #define MOVEMENT_LONG_PRESS_TICKS 64
+#define MOVEMENT_SETTINGS_KEY STORE_KEY('m', 'v', 's', 't')
+// bump this whenever the layout of movement_settings_t changes, so an old copy in the store isn't misread.
+#define MOVEMENT_SETTINGS_VERSION 1
 
 #include <stdio.h>
 #include <string.h>
@@ -32,9 +35,17 @@
 #include <stdio.h>
 #include "watch.h"
 #include "filesystem.h"
+#include "entropy.h"
+#include "schedule.h"
+#include "animation.h"
+#include "store.h"
+#include "checkpoint.h"
+#include "asset.h"
 #include "movement.h"
 
-#ifndef MOVEMENT_FIRMWARE
+#if defined(MOVEMENT_TEST_FACE)
+#include "alt_fw/test_face.h"
+#elif !defined(MOVEMENT_FIRMWARE)
 #include "movement_config.h"
 #elif MOVEMENT_FIRMWARE == MOVEMENT_FIRMWARE_STANDARD
 #include "movement_config.h"
@@ -69,6 +80,11 @@
 #define MOVEMENT_DEFAULT_GREEN_COLOR 0xF
 #endif
 
+// How often, in minutes, faces' checkpointed state is written out if it has changed. 0 turns checkpoints off.
+#ifndef MOVEMENT_CHECKPOINT_INTERVAL
+#define MOVEMENT_CHECKPOINT_INTERVAL 15
+#endif
+
 #if __EMSCRIPTEN__
 #include <emscripten.h>
 #endif
@@ -157,15 +173,29 @@ static inline void _movement_disable_fast_tick_if_possible(void) {
     }
 }
 
+static void _movement_fire_background_task(uint8_t watch_face_index) {
+    movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+    watch_faces[watch_face_index].loop(background_event, &movement_state.settings, watch_face_contexts[watch_face_index]);
+}
+
 static void _movement_handle_background_tasks(void) {
+    uint32_t now = schedule_now();
+    // faces that registered with the scheduling service only hear from us when one of their entries is due...
+    schedule_dispatch(now, _movement_fire_background_task);
+    // ...while the rest still get asked every minute.
     for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
         // For each face, if the watch face wants a background task...
         if (watch_faces[i].wants_background_task != NULL && watch_faces[i].wants_background_task(&movement_state.settings, watch_face_contexts[i])) {
             // ...we give it one. pretty straightforward!
-            movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-            watch_faces[i].loop(background_event, &movement_state.settings, watch_face_contexts[i]);
+            _movement_fire_background_task(i);
         }
     }
+    // faces save our settings to BKUP[0] themselves; keep a copy in the store as well, which costs nothing
+    // unless they changed. Then write out whatever the store has been holding on to long enough.
+    store_set_u32(MOVEMENT_SETTINGS_KEY, MOVEMENT_SETTINGS_VERSION, movement_state.settings.reg);
+    store_flush_if_due(now);
+    checkpoint_run(now);
+    filesystem_flush_if_due();
     movement_state.needs_background_tasks_handled = false;
 }
 
@@ -196,22 +226,42 @@ static void _movement_handle_scheduled_tasks(void) {
     }
 }
 
-void movement_request_tick_frequency(uint8_t freq) {
+static void _movement_request_tick(uint8_t freq, uint64_t phases) {
     // Movement uses the 128 Hz tick internally
     if (freq == 128) return;
 
     // Movement requires at least a 1 Hz tick.
     // If we are asked for an invalid frequency, default back to 1 Hz.
     if (freq == 0 || __builtin_popcount(freq) != 1) freq = 1;
+    // a mask that selects none of this frequency's subseconds would leave the face without any tick at all.
+    if (freq < 64) phases &= (1ull << freq) - 1;
+    if (phases == 0) phases = 1;
 
     // disable all callbacks except the 128 Hz one
     watch_rtc_disable_matching_periodic_callbacks(0xFE);
 
     movement_state.subsecond = 0;
     movement_state.tick_frequency = freq;
+    movement_state.tick_phases = phases;
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+void movement_request_tick_frequency(uint8_t freq) {
+    _movement_request_tick(freq, UINT64_MAX);
+}
+
+void movement_request_tick_phases(uint8_t freq, uint64_t phases) {
+    // at the same frequency only the mask changes; keep counting so the face stays in phase.
+    // (the 1 Hz request always goes through, since that's how app_setup brings the tick back after sleep.)
+    if (freq > 1 && freq == movement_state.tick_frequency) {
+        if (freq < 64) phases &= (1ull << freq) - 1;
+        movement_state.tick_phases = phases ? phases : 1;
+        return;
+    }
+
+    _movement_request_tick(freq, phases);
+}
+
 void movement_illuminate_led(void) {
     if (movement_state.settings.bit.led_duration) {
         watch_set_led_color(movement_state.settings.bit.led_red_color ? (0xF | movement_state.settings.bit.led_red_color << 4) : 0,
@@ -353,9 +403,15 @@ void app_init(void) {
     movement_state.light_ticks = -1;
     movement_state.alarm_ticks = -1;
     movement_state.next_available_backup_register = 4;
-    _movement_reset_inactivity_countdown();
 
     filesystem_init();
+    asset_init();
+    store_init();
+    // if BKUP[0] has been lost along with the power, the copy in the store is the next best thing.
+    store_get_u32(MOVEMENT_SETTINGS_KEY, MOVEMENT_SETTINGS_VERSION, &movement_state.settings.reg);
+    checkpoint_set_interval(MOVEMENT_CHECKPOINT_INTERVAL);
+    _movement_reset_inactivity_countdown();
+    entropy_init();
 
 #if __EMSCRIPTEN__
     int32_t time_zone_offset = EM_ASM_INT({
@@ -372,12 +428,15 @@ void app_init(void) {
 
 void app_wake_from_backup(void) {
     movement_state.settings.reg = watch_get_backup_data(0);
+    store_wake_from_backup();
 }
 
 void app_setup(void) {
     watch_store_backup_data(movement_state.settings.reg, 0);
+    store_save_hot();
 
     static bool is_first_launch = true;
+    bool is_cold_boot = is_first_launch;
 
     if (is_first_launch) {
         #ifdef MOVEMENT_CUSTOM_BOOT_COMMANDS
@@ -411,7 +470,12 @@ void app_setup(void) {
         movement_request_tick_frequency(1);
 
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-            watch_faces[i].setup(&movement_state.settings, i, &watch_face_contexts[i]);
+            // faces that split out a resume function only need their (possibly slow) setup at boot.
+            if (!is_cold_boot && watch_faces[i].resume != NULL) {
+                watch_faces[i].resume(&movement_state.settings, watch_face_contexts[i]);
+            } else {
+                watch_faces[i].setup(&movement_state.settings, i, &watch_face_contexts[i]);
+            }
         }
 
         watch_faces[movement_state.current_watch_face].activate(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
@@ -426,7 +490,8 @@ void app_prepare_for_standby(void) {
 void app_wake_from_standby(void) {
 }
 
-static void _sleep_mode_app_loop(void) {
+// returns true if a button woke us from sleep, in which case watch_enter_sleep_mode has already called app_setup.
+static bool _sleep_mode_app_loop(void) {
     movement_state.needs_wake = false;
     // as long as le_mode_ticks is -1 (i.e. we are in low energy mode), we wake up here, update the screen, and go right back to sleep.
     while (movement_state.le_mode_ticks == -1) {
@@ -437,10 +502,12 @@ static void _sleep_mode_app_loop(void) {
         watch_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
 
         // if we need to wake immediately, do it!
-        if (movement_state.needs_wake) return;
+        if (movement_state.needs_wake) return false;
         // otherwise enter sleep mode, and when the extwake handler is called, it will reset le_mode_ticks and force us out at the next loop.
         else watch_enter_sleep_mode();
     }
+
+    return true;
 }
 
 bool app_loop(void) {
@@ -450,6 +517,7 @@ bool app_loop(void) {
             watch_buzzer_play_note(movement_state.next_watch_face ? BUZZER_NOTE_C7 : BUZZER_NOTE_C8, 50);
         }
         watch_faces[movement_state.current_watch_face].resign(&movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
+        animation_stop();
         movement_state.current_watch_face = movement_state.next_watch_face;
         watch_clear_display();
         movement_request_tick_frequency(1);
@@ -475,23 +543,31 @@ bool app_loop(void) {
     if (movement_state.needs_background_tasks_handled) _movement_handle_background_tasks();
 
     // if we have a scheduled background task, handle that here:
-    if (event.event_type == EVENT_TICK && movement_state.has_scheduled_background_task) _movement_handle_scheduled_tasks();
+    if (movement_state.second_elapsed) {
+        movement_state.second_elapsed = false;
+        if (movement_state.has_scheduled_background_task) _movement_handle_scheduled_tasks();
+    }
 
     // if we have timed out of our low energy mode countdown, enter low energy mode.
     if (movement_state.le_mode_ticks == 0) {
         movement_state.le_mode_ticks = -1;
+        // nobody's looking, and a battery change while we sleep would take anything still waiting in RAM with it.
+        store_flush();
+        checkpoint_flush();
+        filesystem_flush();
+        // an animation's timer would keep waking us from standby.
+        animation_stop();
         watch_register_extwake_callback(BTN_ALARM, cb_alarm_btn_extwake, true);
         event.event_type = EVENT_NONE;
         event.subsecond = 0;
 
         // _sleep_mode_app_loop takes over at this point and loops until le_mode_ticks is reset by the extwake handler,
         // or wake is requested using the movement_request_wake function.
-        _sleep_mode_app_loop();
+        bool woke_from_sleep = _sleep_mode_app_loop();
         // as soon as _sleep_mode_app_loop returns, we reactivate ourselves.
         event.event_type = EVENT_ACTIVATE;
-        // this is a hack tho: waking from sleep mode, app_setup does get called, but it happens before we have reset our ticks.
-        // need to figure out if there's a better heuristic for determining how we woke up.
-        app_setup();
+        // if a wake was requested instead, we left the mini-runloop without going through app_setup, so call it here.
+        if (!woke_from_sleep) app_setup();
     }
 
     static bool can_sleep = true;
@@ -500,6 +576,8 @@ bool app_loop(void) {
         event.subsecond = movement_state.subsecond;
         can_sleep = watch_faces[movement_state.current_watch_face].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_watch_face]);
         event.event_type = EVENT_NONE;
+        // we're awake anyway; if the face drew from the entropy pool, top it up while the TRNG is cheap to run.
+        entropy_harvest();
     }
 
     // if we have timed out of our timeout countdown, give the app a hint that they can resign.
@@ -650,7 +728,6 @@ void cb_fast_tick(void) {
 }
 
 void cb_tick(void) {
-    event.event_type = EVENT_TICK;
     watch_date_time date_time = watch_rtc_get_date_time();
     if (date_time.unit.second != movement_state.last_second) {
         // TODO: can we consolidate these two ticks?
@@ -658,8 +735,14 @@ void cb_tick(void) {
         if (movement_state.timeout_ticks > 0) movement_state.timeout_ticks--;
 
         movement_state.last_second = date_time.unit.second;
+        movement_state.second_elapsed = true;
         movement_state.subsecond = 0;
     } else {
         movement_state.subsecond++;
     }
+
+    // ticks the face didn't ask for still wake us, but end here instead of in the face's loop.
+    // (the RTC's periods don't start on the second, so now and then a second sees one tick more than freq.)
+    if (!(movement_state.tick_phases & (1ull << (movement_state.subsecond & (movement_state.tick_frequency - 1))))) return;
+    event.event_type = EVENT_TICK;
 }
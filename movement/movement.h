@@ -62,7 +62,12 @@ typedef union {
         bool clock_mode_24h : 1;            // indicates whether clock should use 12 or 24 hour mode.
         bool use_imperial_units : 1;        // indicates whether to use metric units (the default) or imperial.
         bool alarm_enabled : 1;             // indicates whether there is at least one alarm enabled.
-        uint8_t reserved : 6;               // room for more preferences if needed.
+#ifdef WATCH_SLCD_USE_DMA
+        bool le_seconds : 1;                // if true, clock faces keep the seconds counting in low energy mode.
+#else
+        bool le_seconds_unused : 1;         // only builds with SLCD_DMA=1 can count the seconds in low energy mode.
+#endif
+        uint8_t reserved : 5;               // room for more preferences if needed.
     } bit;
     uint32_t reg;
 } movement_settings_t;
@@ -93,7 +98,8 @@ typedef union {
     uint32_t reg;
 } movement_birthdate_t;
 
-// movement_reserved_t is a placeholder for future use of the BKUP[3] register.
+// movement_reserved_t is a placeholder for future use of the BKUP[3] register. For now the settings store (store.h)
+// keeps its hot records there.
 typedef union {
     struct {
         uint32_t reserved : 32;
@@ -138,7 +144,8 @@ extern const char movement_valid_position_1_chars[];
   *          need to keep track of any state in your watch face. If your watch face requires any other setup,
   *          like configuring a pin mode or a peripheral, you may want to do that here too.
   *          This function will be called again after waking from sleep mode, since sleep mode disables all
-  *          of the device's pins and peripherals.
+  *          of the device's pins and peripherals, unless you provide a watch_face_resume function, in which
+  *          case that gets called instead and this one only runs once, at boot.
   * @param settings A pointer to the global Movement settings. You can use this to inform how you present your
   *                 display to the user (i.e. taking into account whether they have silenced the buttons, or if
   *                 they prefer 12 or 24-hour mode). You can also change these settings if you like.
@@ -214,6 +221,10 @@ typedef void (*watch_face_resign)(movement_settings_t *settings, void *context);
   *          immediately call your loop function with an EVENT_BACKGROUND_TASK event. Note that it will not call your
   *          activate or deactivate functions, since you are not going on screen.
   *
+  *          If all you do here is compare the time against a fixed schedule (a chime, an alarm), register it with
+  *          the scheduling service in schedule.h instead and leave this NULL: you'll get the same
+  *          EVENT_BACKGROUND_TASK when it's due, without being called every minute.
+  *
   *          Examples of background tasks:
   *           - Wake and play a sound when an alarm or timer has been triggered.
   *           - Check the state of an RTC interrupt pin or the timestamp of an RTC interrupt event.
@@ -231,12 +242,26 @@ typedef void (*watch_face_resign)(movement_settings_t *settings, void *context);
   */
 typedef bool (*watch_face_wants_background_task)(movement_settings_t *settings, void *context);
 
+/** @brief OPTIONAL. Re-enable pins and peripherals after waking from sleep mode.
+  * @details If you provide this function, Movement calls it instead of your setup function when the watch wakes
+  *          from low energy mode, and your setup function runs only once, at boot. That means setup is the place
+  *          for anything slow that only needs doing once, like reading a file from the filesystem or scanning
+  *          external flash, and this function should only redo what sleep mode undid: pin modes, peripherals
+  *          your face keeps configured between activations, and the like. Keep it short; it runs between the
+  *          button press that woke the watch and the first frame the user sees.
+  *          If you leave this NULL, your setup function is called on every wake, as it always has been.
+  * @param settings A pointer to the global Movement settings. @see watch_face_setup.
+  * @param context A pointer to your watch face's context. @see watch_face_setup.
+  */
+typedef void (*watch_face_resume)(movement_settings_t *settings, void *context);
+
 typedef struct {
     watch_face_setup setup;
     watch_face_activate activate;
     watch_face_loop loop;
     watch_face_resign resign;
     watch_face_wants_background_task wants_background_task;
+    watch_face_resume resume;
 } watch_face_t;
 
 typedef struct {
@@ -278,6 +303,8 @@ typedef struct {
     uint8_t tick_frequency;
     uint8_t last_second;
     uint8_t subsecond;
+    uint64_t tick_phases;
+    bool second_elapsed;
 
     // backup register stuff
     uint8_t next_available_backup_register;
@@ -292,6 +319,12 @@ void movement_illuminate_led(void);
 
 void movement_request_tick_frequency(uint8_t freq);
 
+// like movement_request_tick_frequency, but only sends EVENT_TICK on the subseconds whose bits are set in phases
+// (bit 0 is the top of the second). For example, freq 4 with phases 0b0101 ticks on subseconds 0 and 2 only.
+// the other ticks still keep count, but never wake your watch face. Calling this again at the same frequency
+// only swaps the mask, so a face can pick its next phase from its tick handler without losing its place.
+void movement_request_tick_phases(uint8_t freq, uint64_t phases);
+
 // note: watch faces can only schedule a background task when in the foreground, since
 // movement will associate the scheduled task with the currently active face.
 void movement_schedule_background_task(watch_date_time date_time);
@@ -99,6 +99,7 @@
 #include "minute_repeater_decimal_face.h"
 #include "tuning_tones_face.h"
 #include "kitchen_conversions_face.h"
+#include "activity_counter_face.h"
 // New includes go above this line.
 
 #endif // MOVEMENT_FACES_H_
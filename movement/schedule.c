@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "schedule.h"
+#include "watch.h"
+#include "watch_utility.h"
+
+#define SCHEDULE_SECONDS_PER_DAY 86400
+
+typedef struct {
+    schedule_cron_t cron;
+    uint32_t next;
+    uint8_t watch_face_index;
+    uint8_t id;
+    bool in_use;
+    bool once;
+} schedule_entry_t;
+
+static schedule_entry_t _schedule_entries[SCHEDULE_MAX_ENTRIES];
+static uint32_t _schedule_deadline = UINT32_MAX;
+static uint32_t _schedule_last_dispatch;
+
+static void _schedule_update_deadline(void) {
+    _schedule_deadline = UINT32_MAX;
+    for (uint8_t i = 0; i < SCHEDULE_MAX_ENTRIES; i++) {
+        if (_schedule_entries[i].in_use && _schedule_entries[i].next < _schedule_deadline) _schedule_deadline = _schedule_entries[i].next;
+    }
+}
+
+static schedule_entry_t *_schedule_get_entry(uint8_t watch_face_index, uint8_t id) {
+    schedule_entry_t *unused = NULL;
+    for (uint8_t i = 0; i < SCHEDULE_MAX_ENTRIES; i++) {
+        schedule_entry_t *entry = &_schedule_entries[i];
+        if (entry->in_use) {
+            if (entry->watch_face_index == watch_face_index && entry->id == id) return entry;
+        } else if (unused == NULL) {
+            unused = entry;
+        }
+    }
+    return unused;
+}
+
+uint32_t schedule_now(void) {
+    watch_date_time date_time = watch_rtc_get_date_time();
+    date_time.unit.second = 0;
+    return watch_utility_date_time_to_unix_time(date_time, 0);
+}
+
+uint32_t schedule_cron_next(const schedule_cron_t *cron, uint32_t from) {
+    if (!(cron->minutes & SCHEDULE_ALL_MINUTES) || !(cron->hours & SCHEDULE_ALL_HOURS) || !(cron->weekdays & SCHEDULE_ALL_DAYS)) return UINT32_MAX;
+    if (from % 60) from += 60 - from % 60;
+
+    uint32_t day_start = from - from % SCHEDULE_SECONDS_PER_DAY;
+    uint8_t hour = (from % SCHEDULE_SECONDS_PER_DAY) / 3600;
+    uint8_t minute = (from % 3600) / 60;
+
+    // every weekday comes around within a week, so eight days (today's remainder included) always suffice.
+    for (uint8_t i = 0; i < 8; i++, day_start += SCHEDULE_SECONDS_PER_DAY, hour = 0, minute = 0) {
+        uint8_t weekday = (day_start / SCHEDULE_SECONDS_PER_DAY + 3) % 7; // 1970-01-01 was a thursday
+        if (!(cron->weekdays & SCHEDULE_WEEKDAY(weekday))) continue;
+        for (; hour < 24; hour++, minute = 0) {
+            if (!(cron->hours & SCHEDULE_HOUR(hour))) continue;
+            uint64_t minutes = (cron->minutes & SCHEDULE_ALL_MINUTES) >> minute;
+            if (minutes) return day_start + hour * 3600 + (minute + __builtin_ctzll(minutes)) * 60;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+bool schedule_set_cron(uint8_t watch_face_index, uint8_t id, const schedule_cron_t *cron) {
+    schedule_entry_t *entry = _schedule_get_entry(watch_face_index, id);
+    if (entry == NULL) return false;
+
+    entry->cron = *cron;
+    entry->next = schedule_cron_next(cron, schedule_now() + 60);
+    entry->watch_face_index = watch_face_index;
+    entry->id = id;
+    entry->once = false;
+    entry->in_use = true;
+    _schedule_update_deadline();
+
+    return true;
+}
+
+bool schedule_set_once(uint8_t watch_face_index, uint8_t id, uint32_t timestamp) {
+    schedule_entry_t *entry = _schedule_get_entry(watch_face_index, id);
+    if (entry == NULL) return false;
+
+    entry->next = timestamp - timestamp % 60;
+    entry->watch_face_index = watch_face_index;
+    entry->id = id;
+    entry->once = true;
+    entry->in_use = true;
+    _schedule_update_deadline();
+
+    return true;
+}
+
+void schedule_clear(uint8_t watch_face_index, uint8_t id) {
+    schedule_entry_t *entry = _schedule_get_entry(watch_face_index, id);
+    if (entry == NULL || !entry->in_use) return;
+
+    entry->in_use = false;
+    if (entry->next == _schedule_deadline) _schedule_update_deadline();
+}
+
+uint32_t schedule_get_deadline(void) {
+    return _schedule_deadline;
+}
+
+void schedule_dispatch(uint32_t now, void (*fire)(uint8_t watch_face_index)) {
+    uint8_t due_faces[SCHEDULE_MAX_ENTRIES];
+    uint8_t num_due_faces = 0;
+
+    if (now < _schedule_last_dispatch) {
+        // the clock was set back: plan repeating entries again from here.
+        for (uint8_t i = 0; i < SCHEDULE_MAX_ENTRIES; i++) {
+            schedule_entry_t *entry = &_schedule_entries[i];
+            if (entry->in_use && !entry->once) entry->next = schedule_cron_next(&entry->cron, now);
+        }
+        _schedule_update_deadline();
+    }
+    _schedule_last_dispatch = now;
+
+    // the common case: nothing is due this minute.
+    if (now < _schedule_deadline) return;
+
+    for (uint8_t i = 0; i < SCHEDULE_MAX_ENTRIES; i++) {
+        schedule_entry_t *entry = &_schedule_entries[i];
+        if (!entry->in_use || entry->next > now) continue;
+
+        bool due = true;
+        if (entry->once) {
+            entry->in_use = false;
+        } else {
+            // a repeating entry that was missed (the clock jumped forward) only fires if it also matches now.
+            if (entry->next < now) entry->next = schedule_cron_next(&entry->cron, now);
+            due = entry->next == now;
+            if (due) entry->next = schedule_cron_next(&entry->cron, now + 60);
+        }
+        if (!due) continue;
+
+        bool listed = false;
+        for (uint8_t j = 0; j < num_due_faces; j++) {
+            if (due_faces[j] == entry->watch_face_index) listed = true;
+        }
+        if (!listed) due_faces[num_due_faces++] = entry->watch_face_index;
+    }
+    _schedule_update_deadline();
+
+    for (uint8_t i = 0; i < num_due_faces; i++) fire(due_faces[i]);
+}
@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef SCHEDULE_H_
+#define SCHEDULE_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Movement's scheduling service. Faces register cron-like specs ("minute 0 of every hour", "07:30 on
+  *        weekdays") or one-shot timestamps here instead of checking the time in wants_background_task.
+  *        Movement keeps the earliest deadline across all entries, so the minute wake is a single compare
+  *        unless something is actually due, and only the faces that are due get an EVENT_BACKGROUND_TASK.
+  * @note All timestamps are local wall-clock time in seconds since 1970 (i.e. the RTC time converted with a
+  *       UTC offset of 0), and the service works at one minute resolution. If the clock is set back, repeating
+  *       entries are re-planned from the new time; if it jumps forward, repeating entries skip what they missed
+  *       and one-shots fire at the next minute wake.
+  * @note The entries are shared by every face in the build, and a face can't know what the others have taken.
+  *       Check the result of schedule_set_cron and schedule_set_once: if there was no room, switch the alarm or
+  *       chime back off so the wearer can see it isn't armed, rather than let it silently never fire.
+  */
+
+/// Number of entries shared by all faces.
+#define SCHEDULE_MAX_ENTRIES 24
+
+#define SCHEDULE_MINUTE(m) (1ULL << (m))
+#define SCHEDULE_HOUR(h) (1UL << (h))
+#define SCHEDULE_WEEKDAY(d) (1U << (d)) // 0 = Monday ... 6 = Sunday
+#define SCHEDULE_ALL_MINUTES 0x0FFFFFFFFFFFFFFFULL
+#define SCHEDULE_ALL_HOURS 0x00FFFFFFUL
+#define SCHEDULE_WEEKDAYS 0x1FU
+#define SCHEDULE_WEEKEND 0x60U
+#define SCHEDULE_ALL_DAYS 0x7FU
+
+/// A repeating schedule: fires at every minute whose bit is set in minutes, in every hour whose bit is set
+/// in hours, on every weekday whose bit is set in weekdays.
+typedef struct {
+    uint64_t minutes;
+    uint32_t hours;
+    uint8_t weekdays;
+} schedule_cron_t;
+
+/** @brief Returns the current local time, rounded down to the minute, in the form the scheduler uses.
+  */
+uint32_t schedule_now(void);
+
+/** @brief Returns the first time at or after from that matches a cron spec.
+  * @param cron The spec.
+  * @param from A local timestamp; seconds are rounded up to the next full minute.
+  * @return The matching timestamp, or UINT32_MAX if the spec can never match.
+  */
+uint32_t schedule_cron_next(const schedule_cron_t *cron, uint32_t from);
+
+/** @brief Registers (or replaces) a repeating entry. Its first deadline is the next matching minute after now.
+  * @param watch_face_index The face that will receive EVENT_BACKGROUND_TASK when the entry is due.
+  * @param id A number of the face's choosing that tells its entries apart.
+  * @param cron The spec; it is copied.
+  * @return false if all SCHEDULE_MAX_ENTRIES entries are in use.
+  */
+bool schedule_set_cron(uint8_t watch_face_index, uint8_t id, const schedule_cron_t *cron);
+
+/** @brief Registers (or replaces) an entry that fires once and then removes itself.
+  * @param watch_face_index The face that will receive EVENT_BACKGROUND_TASK when the entry is due.
+  * @param id A number of the face's choosing that tells its entries apart.
+  * @param timestamp The local time to fire at, as returned by schedule_now.
+  * @return false if all SCHEDULE_MAX_ENTRIES entries are in use.
+  */
+bool schedule_set_once(uint8_t watch_face_index, uint8_t id, uint32_t timestamp);
+
+/** @brief Removes an entry, if the face has one with this id.
+  */
+void schedule_clear(uint8_t watch_face_index, uint8_t id);
+
+/** @brief Returns the earliest deadline across all entries, or UINT32_MAX if nothing is scheduled.
+  */
+uint32_t schedule_get_deadline(void);
+
+/** @brief Fires everything that is due. Movement calls this at every minute wake.
+  * @param now The current time, as returned by schedule_now.
+  * @param fire Called once for each face with at least one due entry, after all entries have been moved on
+  *             to their next deadline; it is free to register or clear entries.
+  */
+void schedule_dispatch(uint32_t now, void (*fire)(uint8_t watch_face_index));
+
+#endif // SCHEDULE_H_
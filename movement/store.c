@@ -0,0 +1,253 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "store.h"
+#include "schedule.h"
+#include "filesystem.h"
+#include "watch.h"
+
+#define STORE_FILENAME "settings.kv"
+#define STORE_MAGIC STORE_KEY('m', 'v', 'k', 'v')
+// bump this if the layout of the file itself changes; a file in any other format is discarded.
+#define STORE_FORMAT 1
+#define STORE_HOT_REGISTER 3
+
+typedef struct {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t used;
+} store_file_header_t;
+
+// each record is one of these, followed by its value, padded so the next header stays word-aligned.
+typedef struct {
+    uint32_t key;
+    uint8_t type;
+    uint8_t version;
+    uint8_t length;
+    uint8_t hot; // one more than the record's offset into the hot register, or 0 if it isn't hot.
+} store_record_t;
+
+// the file is just this struct, so it can be read and written in one go, without a second buffer.
+static struct {
+    store_file_header_t header;
+    uint32_t records[STORE_CAPACITY / 4];
+} _store;
+// time of the first change that hasn't been written out yet, or 0 if there are none.
+static uint32_t _store_changed_at;
+// true if any of those changes would be lost in a reset, i.e. it isn't just a hot record.
+static bool _store_cold_changes;
+
+static inline uint8_t *_store_bytes(void) {
+    return (uint8_t *)_store.records;
+}
+
+static inline uint16_t _store_record_size(uint8_t length) {
+    return sizeof(store_record_t) + ((length + 3) & ~3);
+}
+
+static inline uint8_t *_store_value(store_record_t *record) {
+    return (uint8_t *)(record + 1);
+}
+
+static store_record_t *_store_find(uint32_t key) {
+    for (uint16_t offset = 0; offset < _store.header.used; ) {
+        store_record_t *record = (store_record_t *)(_store_bytes() + offset);
+        if (record->key == key) return record;
+        offset += _store_record_size(record->length);
+    }
+    return NULL;
+}
+
+static void _store_changed(bool hot) {
+    if (_store_changed_at == 0) _store_changed_at = schedule_now();
+    if (!hot) _store_cold_changes = true;
+}
+
+static uint8_t _store_hot_used(void) {
+    uint8_t used = 0;
+    for (uint16_t offset = 0; offset < _store.header.used; ) {
+        store_record_t *record = (store_record_t *)(_store_bytes() + offset);
+        if (record->hot && record->hot - 1 + record->length > used) used = record->hot - 1 + record->length;
+        offset += _store_record_size(record->length);
+    }
+    return used;
+}
+
+// a record in the loaded file has to fit where it says it does, or we can't trust any of it.
+static bool _store_validate(void) {
+    uint16_t offset = 0;
+    while (offset < _store.header.used) {
+        if (offset + sizeof(store_record_t) > _store.header.used) return false;
+        store_record_t *record = (store_record_t *)(_store_bytes() + offset);
+        if (record->length > STORE_MAX_LENGTH || _store.header.used - offset < _store_record_size(record->length)) return false;
+        if (record->hot && (record->type == STORE_TYPE_BLOB || record->hot - 1 + record->length > STORE_HOT_CAPACITY)) record->hot = 0;
+        offset += _store_record_size(record->length);
+    }
+    return true;
+}
+
+void store_init(void) {
+    int32_t size = filesystem_get_file_size(STORE_FILENAME);
+
+    _store_changed_at = 0;
+    _store_cold_changes = false;
+    if (size < (int32_t)sizeof(store_file_header_t) || size > (int32_t)sizeof(_store) ||
+        !filesystem_read_file(STORE_FILENAME, (char *)&_store, size) ||
+        _store.header.magic != STORE_MAGIC || _store.header.format != STORE_FORMAT ||
+        _store.header.used + sizeof(store_file_header_t) != (uint32_t)size || !_store_validate()) {
+        // no file, or one we can't make sense of: start over with an empty store.
+        _store.header.magic = STORE_MAGIC;
+        _store.header.format = STORE_FORMAT;
+        _store.header.used = 0;
+    }
+}
+
+void store_wake_from_backup(void) {
+    uint32_t hot = watch_get_backup_data(STORE_HOT_REGISTER);
+    for (uint16_t offset = 0; offset < _store.header.used; ) {
+        store_record_t *record = (store_record_t *)(_store_bytes() + offset);
+        if (record->hot && memcmp(_store_value(record), (uint8_t *)&hot + record->hot - 1, record->length)) {
+            memcpy(_store_value(record), (uint8_t *)&hot + record->hot - 1, record->length);
+            _store_changed(true);
+        }
+        offset += _store_record_size(record->length);
+    }
+}
+
+void store_save_hot(void) {
+    uint32_t hot = 0;
+    for (uint16_t offset = 0; offset < _store.header.used; ) {
+        store_record_t *record = (store_record_t *)(_store_bytes() + offset);
+        if (record->hot) memcpy((uint8_t *)&hot + record->hot - 1, _store_value(record), record->length);
+        offset += _store_record_size(record->length);
+    }
+    watch_store_backup_data(hot, STORE_HOT_REGISTER);
+}
+
+bool store_get(uint32_t key, store_type_t type, uint8_t version, store_migrate_t migrate, void *value, uint8_t length) {
+    store_record_t *record = _store_find(key);
+    if (record == NULL || record->type != type || record->version > version) return false;
+
+    if (record->version < version) {
+        uint8_t data[STORE_MAX_LENGTH];
+        uint8_t new_length = record->length;
+        memcpy(data, _store_value(record), record->length);
+        if (migrate == NULL || !migrate(key, record->version, data, &new_length) || !store_set(key, type, version, data, new_length)) {
+            store_remove(key);
+            return false;
+        }
+        record = _store_find(key);
+    }
+
+    if (record->length != length) return false;
+    memcpy(value, _store_value(record), length);
+    return true;
+}
+
+bool store_set(uint32_t key, store_type_t type, uint8_t version, const void *value, uint8_t length) {
+    if (length > STORE_MAX_LENGTH) return false;
+
+    store_record_t *record = _store_find(key);
+    if (record != NULL && record->type == type && record->length == length) {
+        // same shape: update it in place, and only count it as a change if something actually changed.
+        if (record->version == version && memcmp(_store_value(record), value, length) == 0) return true;
+        record->version = version;
+        memcpy(_store_value(record), value, length);
+        if (record->hot) store_save_hot();
+        _store_changed(record->hot);
+        return true;
+    }
+
+    uint16_t size = _store_record_size(length);
+    if (_store.header.used - (record ? _store_record_size(record->length) : 0) + size > STORE_CAPACITY) return false;
+    store_remove(key);
+
+    record = (store_record_t *)(_store_bytes() + _store.header.used);
+    record->key = key;
+    record->type = type;
+    record->version = version;
+    record->length = length;
+    record->hot = 0;
+    memset(_store_value(record), 0, size - sizeof(store_record_t));
+    memcpy(_store_value(record), value, length);
+    _store.header.used += size;
+    _store_changed(false);
+
+    return true;
+}
+
+void store_remove(uint32_t key) {
+    store_record_t *record = _store_find(key);
+    if (record == NULL) return;
+
+    uint8_t *start = (uint8_t *)record;
+    uint16_t size = _store_record_size(record->length);
+    uint8_t *end = start + size;
+    memmove(start, end, _store_bytes() + _store.header.used - end);
+    _store.header.used -= size;
+    _store_changed(false);
+}
+
+bool store_make_hot(uint32_t key) {
+    store_record_t *record = _store_find(key);
+    if (record == NULL || record->type == STORE_TYPE_BLOB) return false;
+    if (record->hot) return true;
+
+    uint8_t offset = _store_hot_used();
+    if (offset + record->length > STORE_HOT_CAPACITY) return false;
+    record->hot = offset + 1;
+    store_save_hot();
+    // which records are hot is itself part of the file, so it has to be written out like any other change.
+    _store_changed(false);
+
+    return true;
+}
+
+bool store_flush(void) {
+    if (_store_changed_at == 0) return true;
+
+    if (!filesystem_write_file(STORE_FILENAME, (char *)&_store, sizeof(store_file_header_t) + _store.header.used)) return false;
+
+    _store_changed_at = 0;
+    _store_cold_changes = false;
+
+    return true;
+}
+
+static void _store_scheduled_flush(void) {
+    store_flush();
+}
+
+void store_flush_if_due(uint32_t now) {
+    if (_store_changed_at == 0) return;
+
+    uint32_t delay = _store_cold_changes ? STORE_WRITE_DELAY : STORE_HOT_WRITE_DELAY;
+    // if the clock was set back, don't wait for it to catch up again.
+    if (now < _store_changed_at || now - _store_changed_at >= delay) {
+        // cold changes exist only in RAM, and we've already waited out the burst; don't make them wait for the
+        // filesystem's window too. Hot ones are safe in BKUP[3] and can ride along with whoever writes next.
+        filesystem_schedule_write(_store_scheduled_flush, _store_cold_changes ? 0 : FILESYSTEM_WRITE_DELAY);
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef STORE_H_
+#define STORE_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Movement's settings store: small typed records, looked up by key, that survive resets and battery
+  *        changes. Faces read and write a RAM copy; a minute or two after the first change, the whole store
+  *        goes to a single file, opening the filesystem's flush window early if it has to, so a burst of
+  *        changes costs one flash write and a face never touches the filesystem itself.
+  * @note Each record has a version number. When a face asks for a newer version than the one stored, it can
+  *       pass a migration function to bring the old record up to date; without one, the old record is dropped
+  *       and the face gets its defaults. A few bytes of scalar records can also be made "hot": they are copied
+  *       to the BKUP[3] register on every write, so values that change often survive a reset (or BACKUP mode)
+  *       even if they haven't been written to flash yet.
+  */
+
+/// Builds a key from four characters, e.g. STORE_KEY('w', 'c', 'l', 'k'). Pick something unlikely to collide.
+#define STORE_KEY(a, b, c, d) (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+
+/// Bytes of RAM (and flash) shared by all records, including an eight-byte header for each.
+#define STORE_CAPACITY 512
+/// The largest value a single record can hold.
+#define STORE_MAX_LENGTH 64
+/// Bytes of hot records that fit in the BKUP[3] register.
+#define STORE_HOT_CAPACITY 4
+/// Seconds after the first unsaved change before the store asks to be written out. Hot records can wait much longer.
+#define STORE_WRITE_DELAY 60
+#define STORE_HOT_WRITE_DELAY 3600
+
+typedef enum {
+    STORE_TYPE_U8 = 1,
+    STORE_TYPE_U16,
+    STORE_TYPE_U32,
+    STORE_TYPE_BLOB,
+} store_type_t;
+
+/** @brief Brings an old record up to date.
+  * @param key The record's key.
+  * @param stored_version The version the record was written with.
+  * @param data The record's value, in a buffer of STORE_MAX_LENGTH bytes; update it in place.
+  * @param length The value's length; update it if the new layout is a different size.
+  * @return true to keep the updated record, false to drop it.
+  */
+typedef bool (*store_migrate_t)(uint32_t key, uint8_t stored_version, uint8_t *data, uint8_t *length);
+
+/** @brief Loads the store from the filesystem. Movement calls this once at boot, after filesystem_init.
+  */
+void store_init(void);
+
+/** @brief Copies the hot records back from BKUP[3], where they may be newer than what's in flash. Movement
+  *        calls this when waking from BACKUP mode or a reset.
+  */
+void store_wake_from_backup(void);
+
+/** @brief Copies the hot records to BKUP[3]. Movement calls this from app_setup, alongside its own settings.
+  */
+void store_save_hot(void);
+
+/** @brief Reads a record.
+  * @param key The record's key.
+  * @param type The type you expect; a record of another type is treated as missing.
+  * @param version The version you expect.
+  * @param migrate Called if the stored version is older than version; may be NULL.
+  * @param value A buffer of at least length bytes.
+  * @param length The size you expect; a record of another size is treated as missing.
+  * @return true if value was filled in; false if the record is missing, and value is untouched. A record
+  *         written by a newer version than the one you ask for is also treated as missing.
+  */
+bool store_get(uint32_t key, store_type_t type, uint8_t version, store_migrate_t migrate, void *value, uint8_t length);
+
+/** @brief Writes a record, replacing any existing record with the same key.
+  * @return false if the store is full, or length is over STORE_MAX_LENGTH.
+  * @note This only changes the RAM copy; nothing is written to flash if the value didn't change.
+  */
+bool store_set(uint32_t key, store_type_t type, uint8_t version, const void *value, uint8_t length);
+
+/** @brief Removes a record, if it exists.
+  */
+void store_remove(uint32_t key);
+
+/** @brief Makes an existing scalar record hot, mirroring it in BKUP[3] from now on.
+  * @return false if the record is missing, is a blob, or there is no room left in the register.
+  */
+bool store_make_hot(uint32_t key);
+
+static inline bool store_get_u8(uint32_t key, uint8_t version, uint8_t *value) { return store_get(key, STORE_TYPE_U8, version, NULL, value, 1); }
+static inline bool store_get_u16(uint32_t key, uint8_t version, uint16_t *value) { return store_get(key, STORE_TYPE_U16, version, NULL, value, 2); }
+static inline bool store_get_u32(uint32_t key, uint8_t version, uint32_t *value) { return store_get(key, STORE_TYPE_U32, version, NULL, value, 4); }
+static inline bool store_set_u8(uint32_t key, uint8_t version, uint8_t value) { return store_set(key, STORE_TYPE_U8, version, &value, 1); }
+static inline bool store_set_u16(uint32_t key, uint8_t version, uint16_t value) { return store_set(key, STORE_TYPE_U16, version, &value, 2); }
+static inline bool store_set_u32(uint32_t key, uint8_t version, uint32_t value) { return store_set(key, STORE_TYPE_U32, version, &value, 4); }
+
+/** @brief Writes the store out now if it has unsaved changes.
+  * @return false if the write failed; the changes stay pending and will be retried.
+  */
+bool store_flush(void);
+
+/** @brief Schedules the store to be written if its changes have waited long enough: cold changes at this minute
+  *        wake, hot ones in the filesystem's next flush window. Movement calls this at every minute wake.
+  * @param now The current time, as returned by schedule_now.
+  */
+void store_flush_if_due(uint32_t now);
+
+#endif // STORE_H_
@@ -50,6 +50,7 @@ void <#watch_face_name#>_face_resign(movement_settings_t *settings, void *contex
     <#watch_face_name#>_face_loop, \
     <#watch_face_name#>_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // <#WATCH_FACE_NAME#>_FACE_H_
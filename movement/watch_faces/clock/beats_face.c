@@ -49,9 +49,6 @@ void beats_face_activate(movement_settings_t *settings, void *context) {
 bool beats_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     (void) settings;
     beats_face_state_t *state = (beats_face_state_t *)context;
-    if (event.event_type == EVENT_TICK && event.subsecond != state->next_subsecond_update) {
-         return true; // math is hard, don't do it if we don't have to.
-    }
 
     char buf[16];
     uint32_t centibeats;
@@ -69,6 +66,8 @@ bool beats_face_loop(movement_event_t event, movement_settings_t *settings, void
                 state->next_subsecond_update = (event.subsecond + 1 + (BEAT_REFRESH_FREQUENCY * 2 / 3)) % BEAT_REFRESH_FREQUENCY;
                 state->last_centibeat_displayed = centibeats;
             }
+            // math is hard, don't do it if we don't have to: only wake up for the subsecond we want next.
+            movement_request_tick_phases(BEAT_REFRESH_FREQUENCY, 1ull << state->next_subsecond_update);
             sprintf(buf, "bt  %6lu", centibeats);
 
             watch_display_string(buf, 0);
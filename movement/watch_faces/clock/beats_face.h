@@ -55,6 +55,7 @@ void beats_face_resign(movement_settings_t *settings, void *context);
     beats_face_loop, \
     beats_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // BEATS_FACE_H_
\ No newline at end of file
@@ -42,6 +42,7 @@
 #include "watch.h"
 #include "watch_utility.h"
 #include "watch_private_display.h"
+#include "schedule.h"
 
 void mrd_play_hour_chime(void) {
         watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
@@ -60,6 +61,14 @@ void mrd_play_minute_chime(void) {
         watch_buzzer_play_note(BUZZER_NOTE_REST, 500);
 }
 
+static void _update_hourly_signal(minute_repeater_decimal_state_t *state) {
+    static const schedule_cron_t top_of_the_hour = { SCHEDULE_MINUTE(0), SCHEDULE_ALL_HOURS, SCHEDULE_ALL_DAYS };
+    if (!state->signal_enabled) schedule_clear(state->watch_face_index, 0);
+    // the scheduler's entries are shared with every other face's chimes and alarms; if they're all taken,
+    // the chime can't ring, so turn it back off rather than show a bell that never sounds.
+    else if (!schedule_set_cron(state->watch_face_index, 0, &top_of_the_hour)) state->signal_enabled = false;
+}
+
 static void _update_alarm_indicator(bool settings_alarm_enabled, minute_repeater_decimal_state_t *state) {
     state->alarm_enabled = settings_alarm_enabled;
     if (state->alarm_enabled) watch_set_indicator(WATCH_INDICATOR_SIGNAL);
@@ -162,6 +171,7 @@ bool minute_repeater_decimal_face_loop(movement_event_t event, movement_settings
             break;
         case EVENT_ALARM_LONG_PRESS:
             state->signal_enabled = !state->signal_enabled;
+            _update_hourly_signal(state);
             if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
             else watch_clear_indicator(WATCH_INDICATOR_BELL);
             break;
@@ -226,13 +236,3 @@ void minute_repeater_decimal_face_resign(movement_settings_t *settings, void *co
     (void) settings;
     (void) context;
 }
-
-bool minute_repeater_decimal_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    minute_repeater_decimal_state_t *state = (minute_repeater_decimal_state_t *)context;
-    if (!state->signal_enabled) return false;
-
-    watch_date_time date_time = watch_rtc_get_date_time();
-
-    return date_time.unit.minute == 0;
-}
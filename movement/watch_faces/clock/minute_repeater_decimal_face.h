@@ -71,14 +71,14 @@ void minute_repeater_decimal_face_setup(movement_settings_t *settings, uint8_t w
 void minute_repeater_decimal_face_activate(movement_settings_t *settings, void *context);
 bool minute_repeater_decimal_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void minute_repeater_decimal_face_resign(movement_settings_t *settings, void *context);
-bool minute_repeater_decimal_face_wants_background_task(movement_settings_t *settings, void *context);
 
 #define minute_repeater_decimal_face ((const watch_face_t){ \
     minute_repeater_decimal_face_setup, \
     minute_repeater_decimal_face_activate, \
     minute_repeater_decimal_face_loop, \
     minute_repeater_decimal_face_resign, \
-    minute_repeater_decimal_face_wants_background_task, \
+    NULL, \
+    NULL, \
 })
 
 #endif // MINUTE_REPEATER_DECIMAL_FACE_H_
@@ -27,6 +27,7 @@
 #include "watch.h"
 #include "watch_utility.h"
 #include "watch_private_display.h"
+#include "schedule.h"
 
 void play_hour_chime(void) {
         watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
@@ -45,6 +46,14 @@ void play_minute_chime(void) {
         watch_buzzer_play_note(BUZZER_NOTE_REST, 500);
 }
 
+static void _update_hourly_signal(repetition_minute_state_t *state) {
+    static const schedule_cron_t top_of_the_hour = { SCHEDULE_MINUTE(0), SCHEDULE_ALL_HOURS, SCHEDULE_ALL_DAYS };
+    if (!state->signal_enabled) schedule_clear(state->watch_face_index, 0);
+    // the scheduler's entries are shared with every other face's chimes and alarms; if they're all taken,
+    // the chime can't ring, so turn it back off rather than show a bell that never sounds.
+    else if (!schedule_set_cron(state->watch_face_index, 0, &top_of_the_hour)) state->signal_enabled = false;
+}
+
 static void _update_alarm_indicator(bool settings_alarm_enabled, repetition_minute_state_t *state) {
     state->alarm_enabled = settings_alarm_enabled;
     if (state->alarm_enabled) watch_set_indicator(WATCH_INDICATOR_SIGNAL);
@@ -147,6 +156,7 @@ bool repetition_minute_face_loop(movement_event_t event, movement_settings_t *se
             break;
         case EVENT_ALARM_LONG_PRESS:
             state->signal_enabled = !state->signal_enabled;
+            _update_hourly_signal(state);
             if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
             else watch_clear_indicator(WATCH_INDICATOR_BELL);
             break;
@@ -207,13 +217,3 @@ void repetition_minute_face_resign(movement_settings_t *settings, void *context)
     (void) settings;
     (void) context;
 }
-
-bool repetition_minute_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    repetition_minute_state_t *state = (repetition_minute_state_t *)context;
-    if (!state->signal_enabled) return false;
-
-    watch_date_time date_time = watch_rtc_get_date_time();
-
-    return date_time.unit.minute == 0;
-}
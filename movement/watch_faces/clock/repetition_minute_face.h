@@ -70,14 +70,14 @@ void repetition_minute_face_setup(movement_settings_t *settings, uint8_t watch_f
 void repetition_minute_face_activate(movement_settings_t *settings, void *context);
 bool repetition_minute_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void repetition_minute_face_resign(movement_settings_t *settings, void *context);
-bool repetition_minute_face_wants_background_task(movement_settings_t *settings, void *context);
 
 #define repetition_minute_face ((const watch_face_t){ \
     repetition_minute_face_setup, \
     repetition_minute_face_activate, \
     repetition_minute_face_loop, \
     repetition_minute_face_resign, \
-    repetition_minute_face_wants_background_task, \
+    NULL, \
+    NULL, \
 })
 
 #endif // REPETITION_MINUTE_FACE_H_
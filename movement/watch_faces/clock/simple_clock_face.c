@@ -27,6 +27,15 @@
 #include "watch.h"
 #include "watch_utility.h"
 #include "watch_private_display.h"
+#include "schedule.h"
+
+static void _update_hourly_signal(simple_clock_state_t *state) {
+    static const schedule_cron_t top_of_the_hour = { SCHEDULE_MINUTE(0), SCHEDULE_ALL_HOURS, SCHEDULE_ALL_DAYS };
+    if (!state->signal_enabled) schedule_clear(state->watch_face_index, 0);
+    // the scheduler's entries are shared with every other face's chimes and alarms; if they're all taken,
+    // the chime can't ring, so turn it back off rather than show a bell that never sounds.
+    else if (!schedule_set_cron(state->watch_face_index, 0, &top_of_the_hour)) state->signal_enabled = false;
+}
 
 static void _update_alarm_indicator(bool settings_alarm_enabled, simple_clock_state_t *state) {
     state->alarm_enabled = settings_alarm_enabled;
@@ -50,6 +59,7 @@ void simple_clock_face_activate(movement_settings_t *settings, void *context) {
     simple_clock_state_t *state = (simple_clock_state_t *)context;
 
     if (watch_tick_animation_is_running()) watch_stop_tick_animation();
+    if (watch_lp_seconds_is_running()) watch_stop_lp_seconds();
 
     if (settings->bit.clock_mode_24h) watch_set_indicator(WATCH_INDICATOR_24H);
 
@@ -70,6 +80,12 @@ bool simple_clock_face_loop(movement_event_t event, movement_settings_t *setting
     simple_clock_state_t *state = (simple_clock_state_t *)context;
     char buf[11];
     uint8_t pos;
+#ifdef WATCH_SLCD_USE_DMA
+    bool le_seconds = settings->bit.le_seconds;
+#else
+    // only builds with SLCD_DMA=1 can count the seconds on the display.
+    bool le_seconds = false;
+#endif
 
     watch_date_time date_time;
     uint32_t previous_date_time;
@@ -117,7 +133,7 @@ bool simple_clock_face_loop(movement_event_t event, movement_settings_t *setting
                     if (date_time.unit.hour == 0) date_time.unit.hour = 12;
                 }
                 pos = 0;
-                if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
+                if (event.event_type == EVENT_LOW_ENERGY_UPDATE && !le_seconds) {
                     if (!watch_tick_animation_is_running()) watch_start_tick_animation(500);
                     sprintf(buf, "%s%2d%2d%02d  ", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute);
                 } else {
@@ -125,11 +141,14 @@ bool simple_clock_face_loop(movement_event_t event, movement_settings_t *setting
                 }
             }
             watch_display_string(buf, pos);
+            // in low energy mode, let the display count the seconds until we wake again at the top of the minute.
+            if (event.event_type == EVENT_LOW_ENERGY_UPDATE && le_seconds) watch_start_lp_seconds(date_time.unit.second);
             // handle alarm indicator
             if (state->alarm_enabled != settings->bit.alarm_enabled) _update_alarm_indicator(settings->bit.alarm_enabled, state);
             break;
         case EVENT_ALARM_LONG_PRESS:
             state->signal_enabled = !state->signal_enabled;
+            _update_hourly_signal(state);
             if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
             else watch_clear_indicator(WATCH_INDICATOR_BELL);
             break;
@@ -153,13 +172,3 @@ void simple_clock_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
     (void) context;
 }
-
-bool simple_clock_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    simple_clock_state_t *state = (simple_clock_state_t *)context;
-    if (!state->signal_enabled) return false;
-
-    watch_date_time date_time = watch_rtc_get_date_time();
-
-    return date_time.unit.minute == 0;
-}
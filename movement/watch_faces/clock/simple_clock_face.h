@@ -49,14 +49,14 @@ void simple_clock_face_setup(movement_settings_t *settings, uint8_t watch_face_i
 void simple_clock_face_activate(movement_settings_t *settings, void *context);
 bool simple_clock_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void simple_clock_face_resign(movement_settings_t *settings, void *context);
-bool simple_clock_face_wants_background_task(movement_settings_t *settings, void *context);
 
 #define simple_clock_face ((const watch_face_t){ \
     simple_clock_face_setup, \
     simple_clock_face_activate, \
     simple_clock_face_loop, \
     simple_clock_face_resign, \
-    simple_clock_face_wants_background_task, \
+    NULL, \
+    NULL, \
 })
 
 #endif // SIMPLE_CLOCK_FACE_H_
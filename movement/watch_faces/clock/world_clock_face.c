@@ -28,17 +28,30 @@
 #include "watch.h"
 #include "watch_utility.h"
 
+static void _world_clock_face_save_settings(world_clock_state_t *state) {
+    store_set_u32(state->store_key, WORLD_CLOCK_STORE_VERSION, state->settings.reg);
+}
+
 void world_clock_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
+    // counts the world clocks set up so far, which (unlike the face index) doesn't change when other faces are added.
+    static uint8_t instances = 0;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(world_clock_state_t));
         memset(*context_ptr, 0, sizeof(world_clock_state_t));
-        uint8_t backup_register = movement_claim_backup_register();
-        if (backup_register) {
-            world_clock_state_t *state = (world_clock_state_t *)*context_ptr;
-            state->settings.reg = watch_get_backup_data(backup_register);
-            state->backup_register = backup_register;
+        world_clock_state_t *state = (world_clock_state_t *)*context_ptr;
+        uint8_t instance = instances++;
+        // there may be more than one world clock, so each keeps its own record.
+        state->store_key = STORE_KEY('w', 'c', 'l', '0' + instance);
+        if (!store_get_u32(state->store_key, WORLD_CLOCK_STORE_VERSION, &state->settings.reg)) {
+            // no record yet: pick up the register an older firmware kept this clock in, and free it up.
+            uint8_t backup_register = WORLD_CLOCK_LEGACY_BACKUP_REGISTER + instance;
+            if (backup_register < 8 && watch_get_backup_data(backup_register)) {
+                state->settings.reg = watch_get_backup_data(backup_register);
+                _world_clock_face_save_settings(state);
+                watch_store_backup_data(0, backup_register);
+            }
         }
     }
 }
@@ -127,7 +140,7 @@ static bool world_clock_face_do_display_mode(movement_event_t event, movement_se
 static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_settings_t *settings, world_clock_state_t *state) {
     switch (event.event_type) {
         case EVENT_MODE_BUTTON_UP:
-            if (state->backup_register) watch_store_backup_data(state->settings.reg, state->backup_register);
+            _world_clock_face_save_settings(state);
             movement_move_to_next_face();
             return false;
         case EVENT_LIGHT_BUTTON_DOWN:
@@ -135,7 +148,7 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_
             if (state->current_screen > 3) {
                 movement_request_tick_frequency(1);
                 state->current_screen = 0;
-                if (state->backup_register) watch_store_backup_data(state->settings.reg, state->backup_register);
+                _world_clock_face_save_settings(state);
                 event.event_type = EVENT_ACTIVATE;
                 return world_clock_face_do_display_mode(event, settings, state);
             }
@@ -47,6 +47,11 @@
  */
 
 #include "movement.h"
+#include "store.h"
+
+#define WORLD_CLOCK_STORE_VERSION 1
+// before the settings store, each world clock claimed a backup register in face order, starting with this one.
+#define WORLD_CLOCK_LEGACY_BACKUP_REGISTER 4
 
 typedef union {
     struct {
@@ -59,7 +64,7 @@ typedef union {
 
 typedef struct {
     world_clock_settings_t settings;
-    uint8_t backup_register;
+    uint32_t store_key;
     uint8_t current_screen;
     uint32_t previous_date_time;
 } world_clock_state_t;
@@ -77,6 +82,7 @@ uint8_t world_clock_face_get_weekday(uint16_t day, uint16_t month, uint16_t year
     world_clock_face_loop, \
     world_clock_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // WORLD_CLOCK_FACE_H_
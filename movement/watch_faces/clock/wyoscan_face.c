@@ -101,11 +101,70 @@ void wyoscan_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
 
+// finds the segment a frame of the scan lights, if any: 8 frames per digit, and none in the trailing frames.
+static bool _wyoscan_get_frame_segment(wyoscan_state_t *state, uint8_t frame, uint8_t *com, uint8_t *seg) {
+    if (frame >= WYOSCAN_FRAMES - MAX_ILLUMINATED_SEGMENTS) return false;
+    uint8_t position = (frame / 8) % 6;
+    char *segments = segment_map[state->time_digits[position]];
+    char segment = segments[frame % strlen(segments)];
+    // if 'X', skip this frame
+    if (segment == 'X') return false;
+
+    *com = clock_mapping[position][segment - 'A'][0];
+    *seg = clock_mapping[position][segment - 'A'][1];
+    return true;
+}
+
+// makes each frame from the one before it, as the animation engine plays the scan: light the frame's segment,
+// and let go of the one lit MAX_ILLUMINATED_SEGMENTS - 1 frames ago, so at most that many are on at once.
+static void _wyoscan_make_keyframe(uint8_t index, animation_keyframe_t *keyframe, void *context) {
+    wyoscan_state_t *state = (wyoscan_state_t *)context;
+    uint8_t com, seg;
+
+    if (index == 0) memset(&state->lit, 0, sizeof(state->lit));
+    if (index >= MAX_ILLUMINATED_SEGMENTS - 1 &&
+        _wyoscan_get_frame_segment(state, index - (MAX_ILLUMINATED_SEGMENTS - 1), &com, &seg)) {
+        state->lit.com[com] &= ~(1ul << seg);
+    }
+    if (_wyoscan_get_frame_segment(state, index, &com, &seg)) state->lit.com[com] |= 1ul << seg;
+
+    keyframe->lit = state->lit;
+    keyframe->duration = WYOSCAN_FRAME_DURATION;
+}
+
+static void _wyoscan_build_script(wyoscan_state_t *state, watch_date_time date_time) {
+    state->time_digits[0] = date_time.unit.hour / 10;
+    state->time_digits[1] = date_time.unit.hour % 10;
+    state->time_digits[2] = date_time.unit.minute / 10;
+    state->time_digits[3] = date_time.unit.minute % 10;
+    state->time_digits[4] = date_time.unit.second / 10;
+    state->time_digits[5] = date_time.unit.second % 10;
+
+    memset(&state->script.segments, 0, sizeof(state->script.segments));
+    for (uint8_t frame = 0; frame < WYOSCAN_FRAMES; frame++) {
+        uint8_t com, seg;
+        if (_wyoscan_get_frame_segment(state, frame, &com, &seg)) watch_segments_add_pixel(&state->script.segments, com, seg);
+    }
+    state->script.keyframes = NULL;
+    state->script.make_keyframe = _wyoscan_make_keyframe;
+    state->script.context = state;
+    state->script.num_keyframes = WYOSCAN_FRAMES;
+    state->script.loops = 1;
+}
+
+static void _wyoscan_start_scan(wyoscan_state_t *state, watch_date_time date_time) {
+    // the colon is off for the first second of the scan and on for the second.
+    if (date_time.unit.second % 2) watch_set_colon();
+    else watch_clear_colon();
+    // the last scan's frames are made from the same state, so stop it before changing that.
+    animation_stop();
+    _wyoscan_build_script(state, date_time);
+    animation_play(&state->script);
+}
+
 void wyoscan_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
-    wyoscan_state_t *state = (wyoscan_state_t *)context;
-    movement_request_tick_frequency(32);
-    state->total_frames = 64;
+    (void) context;
 }
 
 bool wyoscan_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -114,79 +173,13 @@ bool wyoscan_face_loop(movement_event_t event, movement_settings_t *settings, vo
     watch_date_time date_time;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
+            _wyoscan_start_scan(state, watch_rtc_get_date_time());
             break;
-        case EVENT_TICK:            
-            if (!state->animate) {
-                date_time = watch_rtc_get_date_time();
-                state->start = 0; 
-                state->end = 0;
-                state->animation = 0;
-                state->animate = true;
-                state->time_digits[0] = date_time.unit.hour / 10;
-                state->time_digits[1] = date_time.unit.hour % 10;
-                state->time_digits[2] = date_time.unit.minute / 10;
-                state->time_digits[3] = date_time.unit.minute % 10;
-                state->time_digits[4] = date_time.unit.second / 10;
-                state->time_digits[5] = date_time.unit.second % 10;
-            }
-            if ( state->animate ) {
-                // if we have reached the max number of illuminated segments, we clear the oldest one
-                if ((state->end + 1) % MAX_ILLUMINATED_SEGMENTS == state->start) {
-                    // clear the oldest pixel if it's not 'X'
-                    if (state->illuminated_segments[state->start][0] != 99 && state->illuminated_segments[state->start][1] != 99) {
-                        watch_clear_pixel(state->illuminated_segments[state->start][0], state->illuminated_segments[state->start][1]);
-                    }
-                    // increment the start index to point to the next oldest pixel
-                    state->start = (state->start + 1) % MAX_ILLUMINATED_SEGMENTS;
-                }
-                if (state->animation < state->total_frames - MAX_ILLUMINATED_SEGMENTS) {
-                    if (state->animation % 32 == 0) {
-                        if (state->colon) {
-                            watch_set_colon();
-                        } else {
-                            watch_clear_colon();
-                        }
-                        state->colon = !state->colon;
-                    }
-                    
-                    // calculate the start position for the current frame
-                    state->position = (state->animation / 8) % 6;
-                    // calculate the current segment for the current digit
-                    state->segment = state->animation % strlen(segment_map[state->time_digits[state->position]]);
-                    // get the segments for the current digit
-                    state->segments = segment_map[state->time_digits[state->position]];
-                    
-                    if (state->segments[state->segment] == 'X') {
-                        // if 'X', skip this frame
-                        state->illuminated_segments[state->end][0] = 99;
-                        state->illuminated_segments[state->end][1] = 99;
-                        state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
-                        state->animation = (state->animation + 1);
-                        break;
-                    }
-
-                    // calculate the animation frame
-                    state->x = clock_mapping[state->position][state->segments[state->segment]-'A'][0];
-                    state->y = clock_mapping[state->position][state->segments[state->segment]-'A'][1];
-                    
-                    // set the new pixel
-                    watch_set_pixel(state->x, state->y);
-                    
-                    // store this pixel in the buffer
-                    state->illuminated_segments[state->end][0] = state->x;
-                    state->illuminated_segments[state->end][1] = state->y;
-                    // increment the end index to the next position
-                    state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
-                } 
-                else if (state->animation >= state->total_frames - MAX_ILLUMINATED_SEGMENTS && state->animation < state->total_frames) {
-                    state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
-                }
-                else {
-                    // reset the animation state
-                    state->animate = false;
-                }
-                state->animation = (state->animation + 1);
-            } 
+        case EVENT_TICK:
+            // a scan takes two seconds, so start a new one on every even second.
+            date_time = watch_rtc_get_date_time();
+            if (date_time.unit.second % 2 == 0) _wyoscan_start_scan(state, date_time);
+            else watch_set_colon();
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             break;
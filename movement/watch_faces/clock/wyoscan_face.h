@@ -50,8 +50,11 @@
  */
 
 #include "movement.h"
+#include "animation.h"
 
 #define MAX_ILLUMINATED_SEGMENTS 16
+#define WYOSCAN_FRAMES 64
+#define WYOSCAN_FRAME_DURATION 31 // milliseconds; the timer rounds this to 1/32 of a second.
 
 typedef struct {
     uint32_t previous_date_time;
@@ -60,17 +63,9 @@ typedef struct {
     bool signal_enabled;
     bool battery_low;
     bool alarm_enabled;
-    uint8_t animation;
-    bool animate;
-    uint32_t start;
-    uint32_t end;
-    uint32_t total_frames;
-    bool colon;
-    uint8_t position, segment;
-    char *segments;
-    uint8_t x, y;
-    uint32_t time_digits[6];
-    uint32_t illuminated_segments[MAX_ILLUMINATED_SEGMENTS][2]; 
+    animation_script_t script;
+    uint8_t time_digits[6];     // hhmmss of the scan that's playing.
+    watch_segments_t lit;       // the segments lit in the scan's latest frame.
 } wyoscan_state_t;
 
 void wyoscan_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -85,6 +80,7 @@ bool wyoscan_face_wants_background_task(movement_settings_t *settings, void *con
     wyoscan_face_loop, \
     wyoscan_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // WYOSCAN_FACE_H_
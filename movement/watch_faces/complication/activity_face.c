@@ -31,6 +31,7 @@
 #include <string.h>
 #include "activity_face.h"
 #include "chirpy_tx.h"
+#include "checkpoint.h"
 #include "watch.h"
 #include "watch_utility.h"
 
@@ -93,11 +94,13 @@ typedef struct __attribute__((__packed__)) {
 // Size of (fixed) buffer to log activites. Takes up x9 bytes in SRAM if face is installed.
 #define ACTIVITY_LOG_SZ 99
 
-// Number of activities in buffer.
-static uint8_t activity_log_count = 0;
-
-// Buffer with all logged activities.
-static activity_item_t activity_log_buffer[ACTIVITY_LOG_SZ];
+// The log, kept in one struct so it's checkpointed in one piece.
+static struct {
+    // Number of activities in buffer.
+    uint8_t count;
+    // Buffer with all logged activities.
+    activity_item_t buffer[ACTIVITY_LOG_SZ];
+} activity_log;
 
 #define CHIRPY_PREFIX_LEN 2
 // First two bytes chirped out, to identify transmission as from the activity face
@@ -163,7 +166,7 @@ uint16_t *activity_seq_pos;
 
 static void _activity_clear_buffers() {
     // Clear activity buffer; 0xcd is good for diagnostics
-    memset(activity_log_buffer, 0xcd, ACTIVITY_LOG_SZ * sizeof(activity_item_t));
+    memset(activity_log.buffer, 0xcd, ACTIVITY_LOG_SZ * sizeof(activity_item_t));
     // Clear display buffer
     memset(activity_buf, 0, ACTIVITY_BUF_SZ);
 }
@@ -180,6 +183,8 @@ void activity_face_setup(movement_settings_t *settings, uint8_t watch_face_index
         memset(*context_ptr, 0, sizeof(activity_state_t));
         // This happens only at boot
         _activity_clear_buffers();
+        // The log is what we'd hate to lose in a reset; the rest of the state is just where the UI was.
+        checkpoint_register(STORE_KEY('a', 'c', 't', 'l'), &activity_log, sizeof(activity_log), 1);
     }
     // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
@@ -218,7 +223,7 @@ static void _activity_activate(movement_settings_t *settings, activity_state_t *
 static void _activity_display_choice(activity_state_t *state) {
     watch_display_string("AC", 0);
     // If buffer is full: We say "FULL"
-    if (activity_log_count >= ACTIVITY_LOG_SZ) {
+    if (activity_log.count >= ACTIVITY_LOG_SZ) {
         watch_display_string(" FULL ", 4);
     }
     // Otherwise, we show currently activity
@@ -367,12 +372,12 @@ static void _activity_chirp_tick_countdown(void *context) {
 }
 
 static uint8_t _activity_get_next_byte(uint8_t *next_byte) {
-    uint16_t num_bytes = 2 + activity_log_count * sizeof(activity_item_t);
+    uint16_t num_bytes = 2 + activity_log.count * sizeof(activity_item_t);
     uint16_t pos = *activity_seq_pos;
 
     // Init counter
     if (pos == 0) {
-        sprintf(activity_buf, "%3d", activity_log_count);
+        sprintf(activity_buf, "%3d", activity_log.count);
         watch_display_string(activity_buf, 5);
     }
 
@@ -387,12 +392,12 @@ static uint8_t _activity_get_next_byte(uint8_t *next_byte) {
     else {
         pos -= 2;
         uint16_t ix = pos / sizeof(activity_item_t);
-        const activity_item_t *itm = &activity_log_buffer[ix];
+        const activity_item_t *itm = &activity_log.buffer[ix];
         uint16_t ofs = pos % sizeof(activity_item_t);
 
         // Update counter when starting new item
         if (ofs == 0) {
-            sprintf(activity_buf, "%3d", activity_log_count - ix);
+            sprintf(activity_buf, "%3d", activity_log.count - ix);
             watch_display_string(activity_buf, 5);
         }
 
@@ -431,13 +436,13 @@ static void _activity_finish_logging(activity_state_t *state) {
     // Save this activity
     // If shorter than minimum for log: don't save
     // Sanity check about buffer length. This should never happen, but also we never want to overrun by error
-    if (state->curr_total_sec >= activity_min_length_sec && activity_log_count + 1 < ACTIVITY_LOG_SZ) {
-        activity_item_t *itm = &activity_log_buffer[activity_log_count];
+    if (state->curr_total_sec >= activity_min_length_sec && activity_log.count + 1 < ACTIVITY_LOG_SZ) {
+        activity_item_t *itm = &activity_log.buffer[activity_log.count];
         itm->start_time = state->start_time;
         itm->total_sec = state->curr_total_sec;
         itm->pause_sec = state->curr_pause_sec;
         itm->activity_type = state->type_ix;
-        ++activity_log_count;
+        ++activity_log.count;
     }
 
     // Go to DONE animation
@@ -540,7 +545,7 @@ static void _activity_alarm_long(movement_settings_t *settings, activity_state_t
     // On choose face: start logging activity
     if (state->mode == ACTM_CHOOSE) {
         // If buffer is full: Ignore this long press
-        if (activity_log_count >= ACTIVITY_LOG_SZ)
+        if (activity_log.count >= ACTIVITY_LOG_SZ)
             return;
         // OK, we go ahead and start logging
         state->start_time = watch_rtc_get_date_time();
@@ -572,7 +577,7 @@ static void _activity_alarm_long(movement_settings_t *settings, activity_state_t
     }
     // If clear: confirm (unless empty)
     else if (state->mode == ACTM_CLEAR) {
-        if (activity_log_count == 0)
+        if (activity_log.count == 0)
             return;
         state->mode = ACTM_CLEAR_CONFIRM;
         state->counter = -1;
@@ -581,7 +586,7 @@ static void _activity_alarm_long(movement_settings_t *settings, activity_state_t
     // If clear confirm: do clear.
     else if (state->mode == ACTM_CLEAR_CONFIRM) {
         _activity_clear_buffers();
-        activity_log_count = 0;
+        activity_log.count = 0;
         state->mode = ACTM_CLEAR_DONE;
         state->counter = -1;
         watch_display_string("0     ", 4);
@@ -621,7 +626,7 @@ static void _activity_light_short(activity_state_t *state) {
     if (state->mode == ACTM_CHOOSE) {
         state->mode = ACTM_LOGSIZE;
         state->counter = 0;
-        sprintf(activity_buf, "AC  L#g%3d", activity_log_count);
+        sprintf(activity_buf, "AC  L#g%3d", activity_log.count);
         watch_display_string(activity_buf, 0);
     }
     // If log size face: move to chirp
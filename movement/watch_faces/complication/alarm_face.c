@@ -29,6 +29,7 @@
 #include "watch.h"
 #include "watch_utility.h"
 #include "watch_private_display.h"
+#include "schedule.h"
 
 typedef enum {
     alarm_setting_idx_alarm,
@@ -47,13 +48,94 @@ static const uint8_t _buzzer_segdata[3][2] = {{0, 3}, {1, 3}, {2, 2}};
 
 static int8_t _wait_ticks;
 
-static uint8_t _get_weekday_idx(watch_date_time date_time) {
-    date_time.unit.year += 20;
-    if (date_time.unit.month <= 2) {
-        date_time.unit.month += 12;
-        date_time.unit.year--;
+#define ALARM_SECONDS_PER_DAY 86400
+#define ALARM_SCHEDULE_ID_INDICATOR ALARM_ALARMS // slots use their own index as schedule id
+
+static schedule_cron_t _alarm_get_cron(alarm_setting_t *alarm) {
+    schedule_cron_t cron = { SCHEDULE_MINUTE(alarm->minute), SCHEDULE_HOUR(alarm->hour), SCHEDULE_ALL_DAYS };
+    switch (alarm->day) {
+    case ALARM_DAY_EACH_DAY:
+    case ALARM_DAY_ONE_TIME:
+        break;
+    case ALARM_DAY_WORKDAY:
+        cron.weekdays = SCHEDULE_WEEKDAYS;
+        break;
+    case ALARM_DAY_WEEKEND:
+        cron.weekdays = SCHEDULE_WEEKEND;
+        break;
+    default:
+        cron.weekdays = SCHEDULE_WEEKDAY(alarm->day);
+        break;
     }
-    return (date_time.unit.day + 13 * (date_time.unit.month + 1) / 5 + date_time.unit.year + date_time.unit.year / 4 + 525 - 2) % 7;
+    return cron;
+}
+
+static void _alarm_schedule_sort(alarm_state_t *state) {
+    // insertion sort: the schedule is short and usually all but sorted already.
+    // ties go to the lower slot number, as the old linear scan did.
+    for (uint8_t i = 1; i < state->schedule_len; i++) {
+        alarm_schedule_entry_t entry = state->schedule[i];
+        int8_t j = i - 1;
+        while (j >= 0 && (state->schedule[j].timestamp > entry.timestamp
+               || (state->schedule[j].timestamp == entry.timestamp && state->schedule[j].alarm_idx > entry.alarm_idx))) {
+            state->schedule[j + 1] = state->schedule[j];
+            j--;
+        }
+        state->schedule[j + 1] = entry;
+    }
+}
+
+static void _alarm_schedule_rebuild(alarm_state_t *state, uint32_t from) {
+    state->schedule_len = 0;
+    for (uint8_t i = 0; i < ALARM_ALARMS; i++) {
+        if (!state->alarm[i].enabled) continue;
+        schedule_cron_t cron = _alarm_get_cron(&state->alarm[i]);
+        state->schedule[state->schedule_len].timestamp = schedule_cron_next(&cron, from);
+        state->schedule[state->schedule_len].alarm_idx = i;
+        state->schedule_len++;
+    }
+    _alarm_schedule_sort(state);
+}
+
+static bool _alarm_find_due(alarm_state_t *state) {
+    // the lowest numbered slot due this minute plays; any others due at the same time are skipped
+    uint32_t now = schedule_now();
+    _alarm_schedule_rebuild(state, now);
+    if (!state->schedule_len || state->schedule[0].timestamp != now) return false;
+    state->alarm_playing_idx = state->schedule[0].alarm_idx;
+    return true;
+}
+
+// returns false if the scheduler had no room for a slot, which is then switched back off.
+static bool _alarm_schedule_publish(movement_settings_t *settings, alarm_state_t *state) {
+    // hand every enabled slot to movement's scheduler, which wakes us when one of them is due
+    uint32_t now = schedule_now();
+    bool published = true;
+    for (uint8_t i = 0; i < ALARM_ALARMS; i++) {
+        if (state->alarm[i].enabled) {
+            schedule_cron_t cron = _alarm_get_cron(&state->alarm[i]);
+            if (schedule_set_cron(state->watch_face_index, i, &cron)) continue;
+            // the entries are shared with every other face; an alarm the scheduler can't hold would never ring.
+            state->alarm[i].enabled = false;
+            published = false;
+        }
+        schedule_clear(state->watch_face_index, i);
+    }
+    _alarm_schedule_rebuild(state, now + 60);
+    state->schedule_dirty = false;
+
+    // save indication for alarms due in the next 24 h to movement settings,
+    // and if the next alarm is further out than that, come back when it isn't.
+    settings->bit.alarm_enabled = state->schedule_len && state->schedule[0].timestamp - now <= ALARM_SECONDS_PER_DAY;
+    if (state->schedule_len && !settings->bit.alarm_enabled) {
+        // with no room to come back later, show the indicator early rather than not at all.
+        if (!schedule_set_once(state->watch_face_index, ALARM_SCHEDULE_ID_INDICATOR, state->schedule[0].timestamp - ALARM_SECONDS_PER_DAY))
+            settings->bit.alarm_enabled = true;
+    } else {
+        schedule_clear(state->watch_face_index, ALARM_SCHEDULE_ID_INDICATOR);
+    }
+
+    return published;
 }
 
 static void _alarm_set_signal(alarm_state_t *state) {
@@ -63,7 +145,7 @@ static void _alarm_set_signal(alarm_state_t *state) {
         watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
 }
 
-static void _alarm_face_draw(movement_settings_t *settings, alarm_state_t *state, uint8_t subsecond) {
+static void _alarm_face_draw(movement_settings_t *settings, alarm_state_t *state) {
     char buf[12];
 
     uint8_t i = 0;
@@ -87,27 +169,32 @@ static void _alarm_face_draw(movement_settings_t *settings, alarm_state_t *state
         (state->alarm_idx + 1),
         h,
         state->alarm[state->alarm_idx].minute);
-    // blink items if in settings mode
-    if (state->is_setting && subsecond % 2 && state->setting_state < alarm_setting_idx_pitch && !state->alarm_quick_ticks) {
-        buf[_blink_idx[state->setting_state]] = buf[_blink_idx2[state->setting_state]] = ' ';
-    }
+    // the blink shows what was on screen when it started, so stop one that's ending before drawing.
+    if (!state->is_setting || state->alarm_quick_ticks) watch_stop_segment_animation();
     watch_display_string(buf, 0);
     
     if (state->is_setting) {
-    // draw pitch level indicator
-        if ((subsecond % 2) == 0 || (state->setting_state != alarm_setting_idx_pitch)) {
+        // draw pitch level indicator
         for (i = 0; i <= state->alarm[state->alarm_idx].pitch && i < 3; i++)
             watch_set_pixel(_buzzer_segdata[i][0], _buzzer_segdata[i][1]);
-    }
         // draw beep rounds indicator
-        if ((subsecond % 2) == 0 || (state->setting_state != alarm_setting_idx_beeps)) {
-            if (state->alarm[state->alarm_idx].beeps == ALARM_MAX_BEEP_ROUNDS - 1)
-                watch_display_character('L', _blink_idx[alarm_setting_idx_beeps]);
-            else {
-                if (state->alarm[state->alarm_idx].beeps == 0)
-                    watch_display_character('o', _blink_idx[alarm_setting_idx_beeps]);
-                else
-                    watch_display_character(state->alarm[state->alarm_idx].beeps + 48, _blink_idx[alarm_setting_idx_beeps]);
+        if (state->alarm[state->alarm_idx].beeps == ALARM_MAX_BEEP_ROUNDS - 1)
+            watch_display_character('L', _blink_idx[alarm_setting_idx_beeps]);
+        else {
+            if (state->alarm[state->alarm_idx].beeps == 0)
+                watch_display_character('o', _blink_idx[alarm_setting_idx_beeps]);
+            else
+                watch_display_character(state->alarm[state->alarm_idx].beeps + 48, _blink_idx[alarm_setting_idx_beeps]);
+        }
+        // blink the item being set; this doesn't need fast ticks, so we can stay at 1 Hz.
+        if (!state->alarm_quick_ticks) {
+            if (state->setting_state == alarm_setting_idx_pitch) {
+                watch_segments_t segments = {0};
+                for (i = 0; i < 3; i++) watch_segments_add_pixel(&segments, _buzzer_segdata[i][0], _buzzer_segdata[i][1]);
+                const watch_segments_t frames[2] = { watch_get_segments(segments), {{0}} };
+                watch_start_segment_animation(segments, frames, 2, 250);
+            } else {
+                watch_start_position_blink(_blink_idx[state->setting_state], _blink_idx2[state->setting_state] - _blink_idx[state->setting_state] + 1, 250);
             }
         }
     }
@@ -116,57 +203,15 @@ static void _alarm_face_draw(movement_settings_t *settings, alarm_state_t *state
     _alarm_set_signal(state);
 }
 
-static void _alarm_initiate_setting(movement_settings_t *settings, alarm_state_t *state, uint8_t subsecond) {
+static void _alarm_initiate_setting(movement_settings_t *settings, alarm_state_t *state) {
     state->is_setting = true;
     state->setting_state = 0;
-    movement_request_tick_frequency(4);
-    _alarm_face_draw(settings, state, subsecond);
+    _alarm_face_draw(settings, state);
 }
 
-static void _alarm_resume_setting(movement_settings_t *settings, alarm_state_t *state, uint8_t subsecond) {
+static void _alarm_resume_setting(movement_settings_t *settings, alarm_state_t *state) {
     state->is_setting = false;
-    movement_request_tick_frequency(1);
-    _alarm_face_draw(settings, state, subsecond);
-}
-
-static void _alarm_update_alarm_enabled(movement_settings_t *settings, alarm_state_t *state) {
-    // save indication for active alarms to movement settings
-    bool active_alarms = false;
-    watch_date_time now;
-    bool now_init = false;
-    uint8_t weekday_idx;
-    uint16_t now_minutes_of_day;
-    uint16_t alarm_minutes_of_day;
-    for (uint8_t i = 0; i < ALARM_ALARMS; i++) {
-        if (state->alarm[i].enabled) {
-            // figure out if alarm is to go off in the next 24 h
-            if (state->alarm[i].day == ALARM_DAY_EACH_DAY || state->alarm[i].day == ALARM_DAY_ONE_TIME) {
-            active_alarms = true;
-            break;
-            } else {
-                if (!now_init) {
-                    now = watch_rtc_get_date_time();
-                    now_init = true;
-                    weekday_idx = _get_weekday_idx(now);
-                    now_minutes_of_day = now.unit.hour * 60 + now.unit.minute;
-                }
-                alarm_minutes_of_day = state->alarm[i].hour * 60 + state->alarm[i].minute;
-                // no more shortcuts: check days and times for all possible cases...
-                if ((state->alarm[i].day == weekday_idx && alarm_minutes_of_day >= now_minutes_of_day)
-                    || ((weekday_idx + 1) % 7 == state->alarm[i].day && alarm_minutes_of_day <= now_minutes_of_day) 
-                    || (state->alarm[i].day == ALARM_DAY_WORKDAY && (weekday_idx < 4
-                        || (weekday_idx == 4 && alarm_minutes_of_day >= now_minutes_of_day)
-                        || (weekday_idx == 6 && alarm_minutes_of_day <= now_minutes_of_day)))
-                    || (state->alarm[i].day == ALARM_DAY_WEEKEND && (weekday_idx == 5
-                        || (weekday_idx == 6 && alarm_minutes_of_day >= now_minutes_of_day)
-                        || (weekday_idx == 4 && alarm_minutes_of_day <= now_minutes_of_day)))) {
-                    active_alarms = true;
-                    break;
-                }
-            }
-        }
-    }
-    settings->bit.alarm_enabled = active_alarms;
+    _alarm_face_draw(settings, state);
 }
 
 static void _alarm_play_short_beep(uint8_t pitch_idx) {
@@ -192,13 +237,13 @@ static void _abort_quick_ticks(alarm_state_t *state) {
     if (state->alarm_quick_ticks) {
         state->alarm[state->alarm_idx].enabled = true;
         state->alarm_quick_ticks = false;
-        movement_request_tick_frequency(4);
+        state->schedule_dirty = true;
+        movement_request_tick_frequency(1);
     }
 }
 
 void alarm_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr) {
     (void) settings;
-    (void) watch_face_index;
 
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(alarm_state_t));
@@ -210,7 +255,7 @@ void alarm_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
             state->alarm[i].beeps = 5;
             state->alarm[i].pitch = 1;
         }
-        state->alarm_handled_minute = -1;
+        state->watch_face_index = watch_face_index;
         _wait_ticks = -1;
     }
 }
@@ -224,41 +269,14 @@ void alarm_face_activate(movement_settings_t *settings, void *context) {
 void alarm_face_resign(movement_settings_t *settings, void *context) {
     alarm_state_t *state = (alarm_state_t *)context;
     state->is_setting = false;
-    _alarm_update_alarm_enabled(settings, state);
+    _alarm_schedule_publish(settings, state);
+    watch_stop_segment_animation();
     watch_set_led_off();
     state->alarm_quick_ticks = false;
     _wait_ticks = -1;
     movement_request_tick_frequency(1);
 }
 
-bool alarm_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    alarm_state_t *state = (alarm_state_t *)context;
-    watch_date_time now = watch_rtc_get_date_time();
-    // just a failsafe: never fire more than one alarm within a minute
-    if (state->alarm_handled_minute == now.unit.minute) return false;
-    state->alarm_handled_minute = now.unit.minute;
-    // check the rest
-    for (uint8_t i = 0; i < ALARM_ALARMS; i++) {
-        if (state->alarm[i].enabled) {
-            if (state->alarm[i].minute == now.unit.minute) {
-                if (state->alarm[i].hour == now.unit.hour) {
-                    state->alarm_playing_idx = i;
-                    if (state->alarm[i].day == ALARM_DAY_EACH_DAY || state->alarm[i].day == ALARM_DAY_ONE_TIME) return true;
-                    uint8_t weekday_idx = _get_weekday_idx(now);
-                    if (state->alarm[i].day == weekday_idx) return true;
-                    if (state->alarm[i].day == ALARM_DAY_WORKDAY && weekday_idx < 5) return true;
-                    if (state->alarm[i].day == ALARM_DAY_WEEKEND && weekday_idx >= 5) return true;
-                }
-            }
-        }
-    }
-    state->alarm_handled_minute = -1;
-    // update the movement's alarm indicator five times an hour
-    if (now.unit.minute % 12 == 0) _alarm_update_alarm_enabled(settings, state);
-    return false;
-}
-
 bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     (void) settings;
     alarm_state_t *state = (alarm_state_t *)context;
@@ -272,6 +290,7 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
             } else if (state->setting_state == alarm_setting_idx_minute) {
                         state->alarm[state->alarm_idx].minute = (state->alarm[state->alarm_idx].minute + 1) % 60;
             } else _abort_quick_ticks(state);
+            state->schedule_dirty = true;
         } else if (!state->is_setting) {
             if (_wait_ticks >= 0) _wait_ticks++;
             if (_wait_ticks == 2) {
@@ -280,6 +299,7 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
                 if (state->alarm_idx) {
                     // revert change of enabled flag and show it briefly
                     state->alarm[state->alarm_idx].enabled ^= 1;
+                    state->schedule_dirty = true;
                     _alarm_set_signal(state);
                     delay_ms(275);
                     state->alarm_idx = 0;
@@ -288,25 +308,25 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
         }
         // fall through
     case EVENT_ACTIVATE:
-        _alarm_face_draw(settings, state, event.subsecond);
+        _alarm_face_draw(settings, state);
         break;
     case EVENT_LIGHT_BUTTON_UP:
         if (!state->is_setting) {
             movement_illuminate_led();
-            _alarm_initiate_setting(settings, state, event.subsecond);
+            _alarm_initiate_setting(settings, state);
             break;
         }
         state->setting_state += 1;
         if (state->setting_state >= ALARM_SETTING_STATES) {
             // we have done a full settings cycle, so resume to normal
-            _alarm_resume_setting(settings, state, event.subsecond);
+            _alarm_resume_setting(settings, state);
         }
         break;
     case EVENT_LIGHT_LONG_PRESS:
         if (state->is_setting) {
-            _alarm_resume_setting(settings, state, event.subsecond);
+            _alarm_resume_setting(settings, state);
         } else {
-            _alarm_initiate_setting(settings, state, event.subsecond);
+            _alarm_initiate_setting(settings, state);
         }
         break;
     case EVENT_ALARM_BUTTON_UP:
@@ -353,13 +373,15 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
             }
             // auto enable an alarm if user sets anything
             if (state->setting_state > alarm_setting_idx_alarm) state->alarm[state->alarm_idx].enabled = true;
+            state->schedule_dirty = true;
         }
-        _alarm_face_draw(settings, state, event.subsecond);
+        _alarm_face_draw(settings, state);
         break;
     case EVENT_ALARM_LONG_PRESS:
         if (!state->is_setting) {
             // toggle the enabled flag for current alarm
             state->alarm[state->alarm_idx].enabled ^= 1;
+            state->schedule_dirty = true;
             // start wait ticks counter
             _wait_ticks = 0;
         } else {
@@ -379,7 +401,7 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
                 break;
             }
         }
-        _alarm_face_draw(settings, state, event.subsecond);
+        _alarm_face_draw(settings, state);
         break;
     case EVENT_ALARM_LONG_UP:
         if (state->is_setting) {
@@ -388,6 +410,11 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
         } else _wait_ticks = -1;
         break;
     case EVENT_BACKGROUND_TASK:
+        // woken by the scheduler: either a slot is due now, or the next one just came within 24 hours
+        if (!_alarm_find_due(state)) {
+            _alarm_schedule_publish(settings, state);
+            break;
+        }
         // play alarm
         if (state->alarm[state->alarm_playing_idx].beeps == 0) {
             // short beep
@@ -411,8 +438,8 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
             state->alarm[state->alarm_playing_idx].beeps = 5;
             state->alarm[state->alarm_playing_idx].pitch = 1;
             state->alarm[state->alarm_playing_idx].enabled = false;
-            _alarm_update_alarm_enabled(settings, state);
         }
+        _alarm_schedule_publish(settings, state);
         break;
     case EVENT_TIMEOUT:
         movement_move_to_face(0);
@@ -425,5 +452,12 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
         break;
     }
 
+    // let the scheduler know about any edits right away, so they count even while we're on screen.
+    // if it's full, the alarm just switched on goes off again; redraw so the signal indicator says so.
+    if (state->schedule_dirty && !_alarm_schedule_publish(settings, state)) {
+        _alarm_face_draw(settings, state);
+        if (settings->bit.button_should_sound) watch_buzzer_play_note(BUZZER_NOTE_C6, 250);
+    }
+
     return true;
 }
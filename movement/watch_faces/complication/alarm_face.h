@@ -52,6 +52,10 @@
  *      long ('L') and extra short ('o') alarms.
  *    - The simple watch face indicates if any alarm is set within the next 24h by showing the signal
  *      indicator.
+ *
+ * The face keeps the enabled alarms in a schedule sorted by their next trigger time, and registers
+ * each of them with movement's scheduling service (schedule.h). It isn't polled every minute; it
+ * only runs when an alarm is due or the next alarm comes within 24 hours.
  */
 
 #include "movement.h"
@@ -74,14 +78,22 @@ typedef struct {
     bool enabled : 1;
 } alarm_setting_t;
 
+typedef struct {
+    uint32_t timestamp; // local time of the next trigger, in seconds since 1970
+    uint8_t alarm_idx;
+} alarm_schedule_entry_t;
+
 typedef struct {
     uint8_t alarm_idx : 4;
     uint8_t alarm_playing_idx : 4;
     uint8_t setting_state : 3;
-    int8_t alarm_handled_minute;
     bool alarm_quick_ticks : 1;
     bool is_setting : 1;
+    bool schedule_dirty : 1;
+    uint8_t watch_face_index;
+    uint8_t schedule_len;   // number of enabled alarms in the schedule
     alarm_setting_t alarm[ALARM_ALARMS];
+    alarm_schedule_entry_t schedule[ALARM_ALARMS]; // enabled alarms, soonest first
 } alarm_state_t;
 
 
@@ -89,14 +101,14 @@ void alarm_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
 void alarm_face_activate(movement_settings_t *settings, void *context);
 bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void alarm_face_resign(movement_settings_t *settings, void *context);
-bool alarm_face_wants_background_task(movement_settings_t *settings, void *context);
 
 #define alarm_face ((const watch_face_t){ \
     alarm_face_setup, \
     alarm_face_activate, \
     alarm_face_loop, \
     alarm_face_resign, \
-    alarm_face_wants_background_task, \
+    NULL, \
+    NULL, \
 })
 
 #endif // ALARM_FACE_H_
@@ -81,6 +81,7 @@ void couch_to_5k_face_resign(movement_settings_t *settings, void *context);
     couch_to_5k_face_loop, \
     couch_to_5k_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // COUCHTO5K_FACE_H_
@@ -34,13 +34,10 @@
 
 static bool quick_ticks_running;
 
-static void abort_quick_ticks(countdown_state_t *state) {
+static void abort_quick_ticks(void) {
     if (quick_ticks_running) {
         quick_ticks_running = false;
-        if (state->mode == cd_setting)
-            movement_request_tick_frequency(4);
-        else
-            movement_request_tick_frequency(1);
+        movement_request_tick_frequency(1);
     }
 }
 
@@ -79,7 +76,7 @@ static void start(countdown_state_t *state, movement_settings_t *settings) {
     watch_set_indicator(WATCH_INDICATOR_BELL);
 }
 
-static void draw(countdown_state_t *state, uint8_t subsecond) {
+static void draw(countdown_state_t *state) {
     char buf[16];
 
     uint32_t delta;
@@ -101,24 +98,15 @@ static void draw(countdown_state_t *state, uint8_t subsecond) {
             break;
         case cd_setting:
             sprintf(buf, "CD  %2d%02d%02d", state->hours, state->minutes, state->seconds);
-            if (!quick_ticks_running && subsecond % 2) {
-                switch(state->selection) {
-                    case 0:
-                        buf[4] = buf[5] = ' ';
-                        break;
-                    case 1:
-                        buf[6] = buf[7] = ' ';
-                        break;
-                    case 2:
-                        buf[8] = buf[9] = ' ';
-                        break;
-                    default:
-                        break;
-                }
-            }
             break;
     }
+    bool blink = state->mode == cd_setting && !quick_ticks_running && state->selection < CD_SELECTIONS;
+    // stop a blink that's ending before drawing, so it doesn't restore stale digits over the new ones.
+    if (!blink) watch_stop_segment_animation();
     watch_display_string(buf, 0);
+    if (blink) {
+        watch_start_position_blink(4 + state->selection * 2, 2, 250);
+    }
 }
 
 static void pause(countdown_state_t *state) {
@@ -191,23 +179,23 @@ bool countdown_face_loop(movement_event_t event, movement_settings_t *settings,
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_TICK:
             if (quick_ticks_running) {
                 if (watch_get_pin_level(BTN_ALARM))
                     settings_increment(state);
                 else
-                    abort_quick_ticks(state);
+                    abort_quick_ticks();
             }
 
             if (state->mode == cd_running) {
                 state->now_ts++;
             }
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_MODE_BUTTON_UP:
-            abort_quick_ticks(state);
+            abort_quick_ticks();
             movement_move_to_next_face();
             break;
         case EVENT_LIGHT_BUTTON_UP:
@@ -221,7 +209,6 @@ bool countdown_face_loop(movement_event_t event, movement_settings_t *settings,
                     break;
                 case cd_reset:
                     state->mode = cd_setting;
-                    movement_request_tick_frequency(4);
                     button_beep(settings);
                     break;
                 case cd_setting:
@@ -230,12 +217,11 @@ bool countdown_face_loop(movement_event_t event, movement_settings_t *settings,
                         state->selection = 0;
                         state->mode = cd_reset;
                         store_countdown(state);
-                        movement_request_tick_frequency(1);
                         button_beep(settings);
                     }
                     break;
             }
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_ALARM_BUTTON_UP:
             switch(state->mode) {
@@ -255,7 +241,7 @@ bool countdown_face_loop(movement_event_t event, movement_settings_t *settings,
                     settings_increment(state);
                     break;
             }
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_ALARM_LONG_PRESS:
             if (state->mode == cd_setting) {
@@ -279,13 +265,13 @@ bool countdown_face_loop(movement_event_t event, movement_settings_t *settings,
             }
             break;
         case EVENT_ALARM_LONG_UP:
-            abort_quick_ticks(state);
+            abort_quick_ticks();
             break;
         case EVENT_BACKGROUND_TASK:
             ring(state);
             break;
         case EVENT_TIMEOUT:
-            abort_quick_ticks(state);
+            abort_quick_ticks();
             movement_move_to_face(0);
             break;
         case EVENT_LOW_ENERGY_UPDATE:
@@ -308,4 +294,5 @@ void countdown_face_resign(movement_settings_t *settings, void *context) {
         state->mode = cd_reset;
         store_countdown(state);
     }
+    watch_stop_segment_animation();
 }
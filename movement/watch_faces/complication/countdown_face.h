@@ -76,6 +76,7 @@ void countdown_face_resign(movement_settings_t *settings, void *context);
     countdown_face_loop, \
     countdown_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // COUNTDOWN_FACE_H_
@@ -25,16 +25,20 @@
 #include <stdlib.h>
 #include <string.h>
 #include "counter_face.h"
+#include "checkpoint.h"
 #include "watch.h"
 
 void counter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
+    // counts the counters set up so far; unlike the face index, it doesn't change when other faces are added.
+    static uint8_t instances = 0;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(counter_state_t));
         memset(*context_ptr, 0, sizeof(counter_state_t));
         counter_state_t *state = (counter_state_t *)*context_ptr;
         state->beep_on = true;
+        checkpoint_register(STORE_KEY('c', 'n', 't', '0' + instances++), state, sizeof(counter_state_t), 1);
     }
 }
 
@@ -23,6 +23,7 @@
  */
 
 #include "habit_face.h"
+#include "checkpoint.h"
 #include "watch_private_display.h"
 #include "watch_rtc.h"
 #include "watch_slcd.h"
@@ -52,6 +53,9 @@ void habit_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
                       void **context_ptr) {
   (void)settings;
   (void)watch_face_index;
+  // counts the habit faces set up so far; unlike the face index, it doesn't
+  // change when other faces are added.
+  static uint8_t instances = 0;
   if (*context_ptr == NULL) {
     *context_ptr = malloc(sizeof(habit_state_t));
     memset(*context_ptr, 0, sizeof(habit_state_t));
@@ -59,6 +63,8 @@ void habit_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     state->lookback = 0;
     state->last_update = watch_utility_offset_timestamp(
         today_unix(settings->bit.time_zone), -24, 0, 0);
+    checkpoint_register(STORE_KEY('h', 'b', 't', '0' + instances++), state,
+                        sizeof(habit_state_t), 1);
   }
 }
 
@@ -22,15 +22,11 @@
  * SOFTWARE.
  */
 
-// Emulator only: need time() to seed the random number generator
-#if __EMSCRIPTEN__
-#include <time.h>
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include "watch_private_display.h"
 #include "invaders_face.h"
+#include "entropy.h"
 
 #define INVADERS_FACE_WAVES_PER_STAGE 9 // number of waves per stage (there are two stages)
 #define INVADERS_FACE_WAVE_INVADERS 16  // number of invaders attacking per wave
@@ -84,11 +80,7 @@ static uint16_t _score;                 // score of the current game
 
 /// @brief return a random number. 0 <= return_value < num_values
 static inline uint8_t _get_rand_num(uint8_t num_values) {
-#if __EMSCRIPTEN__
-    return rand() % num_values;
-#else
-    return arc4random_uniform(num_values);
-#endif
+    return entropy_uniform(num_values);
 }
 
 /// @brief callback function to re-enable light and alarm buttons after playing a sound sequence
@@ -213,11 +205,6 @@ void invaders_face_setup(movement_settings_t *settings, uint8_t watch_face_index
         // default: sound on
         state->sound_on = true;
     }
-#if __EMSCRIPTEN__
-    // simulator only: seed the randon number generator
-    time_t t;
-    srand((unsigned) time(&t));
-#endif
 }
 
 void invaders_face_activate(movement_settings_t *settings, void *context) {
@@ -236,6 +223,8 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
             _display_score("GA", state->highscore);
             break;
         case EVENT_TICK:
+            // moving the invaders redraws most of the screen; commit it as a single frame below.
+            watch_begin_display_frame();
             _ticks++;
             switch (_current_state) {
                 case invaders_state_in_wave_break:
@@ -315,6 +304,7 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
             }
             break;
         case EVENT_ALARM_BUTTON_DOWN:
+            watch_begin_display_frame();
             if (!_signals.suspend_buttons) {
                 switch (_current_state) {
                     case invaders_state_game_over:
@@ -416,6 +406,7 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
             // You can override any of these behaviors by adding a case for these events to this switch statement.
             return movement_default_loop_handler(event, settings);
     }
+    watch_commit_display_frame();
 
     // return true if the watch can enter standby mode. Generally speaking, you should always return true.
     // Exceptions:
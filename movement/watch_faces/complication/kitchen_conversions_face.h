@@ -82,6 +82,7 @@ void kitchen_conversions_face_resign(movement_settings_t *settings, void *contex
     kitchen_conversions_face_loop,                      \
     kitchen_conversions_face_resign,                    \
     NULL,                                               \
+    NULL,                                               \
 })
 
 #endif // KITCHEN_CONVERSIONS_FACE_H_
@@ -66,6 +66,7 @@ void moon_phase_face_resign(movement_settings_t *settings, void *context);
     moon_phase_face_loop, \
     moon_phase_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // MOON_PHASE_FACE_H_
@@ -57,6 +57,7 @@ void probability_face_resign(movement_settings_t *settings, void *context);
     probability_face_loop, \
     probability_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // PROBABILITY_FACE_H_
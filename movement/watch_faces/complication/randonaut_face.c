@@ -22,18 +22,12 @@
  * SOFTWARE.
  */
 
-// Emulator only: need time() to seed the random number generator.
-#if __EMSCRIPTEN__
-#include <time.h>
-#else
-#include "saml22j18a.h"
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include "filesystem.h"
 #include "randonaut_face.h"
+#include "entropy.h"
 
 #define R 6371 // Earth's radius in km
 #define PI 3.14159265358979323846
@@ -339,28 +333,15 @@ static void _generate_blindspot(randonaut_state_t *state) {
 /** @brief pseudo random number generator
  */
 static uint32_t _get_pseudo_entropy(uint32_t max) {
-    #if __EMSCRIPTEN__
-    return rand() % max;
-    #else
-    return arc4random_uniform(max);
-    #endif
+    return entropy_uniform(max);
 }
 
 /** @brief true random number generator
  */
 static uint32_t _get_true_entropy(void) {
-    #if __EMSCRIPTEN__
-    return rand() % INT32_MAX;
-    #else
-    hri_mclk_set_APBCMASK_TRNG_bit(MCLK);
-    hri_trng_set_CTRLA_ENABLE_bit(TRNG);
-
-    while (!hri_trng_get_INTFLAG_reg(TRNG, TRNG_INTFLAG_DATARDY)); // Wait for TRNG data to be ready
-
-    hri_trng_clear_CTRLA_ENABLE_bit(TRNG);
-    hri_mclk_clear_APBCMASK_TRNG_bit(MCLK);
-    return hri_trng_read_DATA_reg(TRNG); // Read a single 32-bit word from TRNG and return it
-    #endif
+    uint32_t word;
+    watch_trng_read(&word, 1); // Read a single 32-bit word from the TRNG
+    return word;
 }
 
 /** @brief get location from place.loc
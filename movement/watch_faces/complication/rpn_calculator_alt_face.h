@@ -90,6 +90,7 @@ void rpn_calculator_alt_face_resign(movement_settings_t *settings, void *context
     rpn_calculator_alt_face_loop, \
     rpn_calculator_alt_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // CALCULATOR_FACE_H_
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "ships_bell_face.h"
+#include "schedule.h"
 
 static void ships_bell_ring() {
     watch_date_time date_time = watch_rtc_get_date_time();
@@ -45,6 +46,34 @@ static void ships_bell_ring() {
     }
 }
 
+static bool _ships_bell_set_schedule(ships_bell_state_t *state) {
+    schedule_cron_t cron = { SCHEDULE_MINUTE(0) | SCHEDULE_MINUTE(30), SCHEDULE_ALL_HOURS, SCHEDULE_ALL_DAYS };
+
+    if (!state->on_watch) {
+        schedule_clear(state->watch_face_index, 1);
+        return schedule_set_cron(state->watch_face_index, 0, &cron);
+    }
+
+    // a watch rings every half hour for its four hours (twice a day), plus the eight bells at its end
+    uint8_t first_hour = (state->on_watch * 4) % 12;
+    cron.hours = 0;
+    for (uint8_t i = 0; i < 4; i++) cron.hours |= SCHEDULE_HOUR(first_hour + i) | SCHEDULE_HOUR(first_hour + i + 12);
+    if (!schedule_set_cron(state->watch_face_index, 0, &cron)) return false;
+    cron.minutes = SCHEDULE_MINUTE(0);
+    cron.hours = SCHEDULE_HOUR((first_hour + 4) % 12) | SCHEDULE_HOUR((first_hour + 4) % 12 + 12);
+    return schedule_set_cron(state->watch_face_index, 1, &cron);
+}
+
+static void ships_bell_update_schedule(ships_bell_state_t *state) {
+    // if the scheduler has run out of entries, half a bell schedule is worse than none: turn the bell off.
+    if (state->bell_enabled && !_ships_bell_set_schedule(state)) state->bell_enabled = false;
+
+    if (!state->bell_enabled) {
+        schedule_clear(state->watch_face_index, 0);
+        schedule_clear(state->watch_face_index, 1);
+    }
+}
+
 static void ships_bell_draw(ships_bell_state_t *state) {
     char buf[8];
 
@@ -63,11 +92,11 @@ static void ships_bell_draw(ships_bell_state_t *state) {
 
 void ships_bell_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr) {
     (void) settings;
-    (void) watch_face_index;
 
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(ships_bell_state_t));
         memset(*context_ptr, 0, sizeof(ships_bell_state_t));
+        ((ships_bell_state_t *) *context_ptr)->watch_face_index = watch_face_index;
     }
 }
 
@@ -94,11 +123,13 @@ bool ships_bell_face_loop(movement_event_t event, movement_settings_t *settings,
             break;
         case EVENT_ALARM_BUTTON_UP:
             state->bell_enabled = !state->bell_enabled;
+            ships_bell_update_schedule(state);
             if (state->bell_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
             else watch_clear_indicator(WATCH_INDICATOR_BELL);
             break;
         case EVENT_ALARM_LONG_PRESS:
             state->on_watch = (state->on_watch + 1) % 4;
+            ships_bell_update_schedule(state);
             ships_bell_draw(state);
             break;
         case EVENT_TIMEOUT:
@@ -127,28 +158,3 @@ void ships_bell_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
     (void) context;
 }
-
-bool ships_bell_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-
-    ships_bell_state_t *state = (ships_bell_state_t *) context;
-    if (!state->bell_enabled) return false;
-
-    watch_date_time date_time = watch_rtc_get_date_time();
-    if (!(date_time.unit.minute == 0 || date_time.unit.minute == 30)) return false;
-
-    date_time.unit.hour %= 12;
-    switch (state->on_watch) {
-        case 1:
-            return (date_time.unit.hour >= 4 && date_time.unit.hour < 8) ||
-                   (date_time.unit.hour == 8 && date_time.unit.minute == 0);
-        case 2:
-            return (date_time.unit.hour >= 8 && date_time.unit.hour < 12) ||
-                   (date_time.unit.hour == 0 && date_time.unit.minute == 0);
-        case 3:
-            return (date_time.unit.hour >= 0 && date_time.unit.hour < 4) ||
-                   (date_time.unit.hour == 4 && date_time.unit.minute == 0);
-        default:
-            return true;
-    }
-}
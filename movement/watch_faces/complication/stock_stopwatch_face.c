@@ -39,15 +39,6 @@
        turns on on each button press or it doesn't.
 */
 
-#if __EMSCRIPTEN__
-#include <emscripten.h>
-#include <emscripten/html5.h>
-#else
-#include "../../../watch-library/hardware/include/saml22j18a.h"
-#include "../../../watch-library/hardware/include/component/tc.h"
-#include "../../../watch-library/hardware/hri/hri_tc_l22.h"
-#endif
-
 // distant future for background task: January 1, 2083
 static const watch_date_time distant_future = {
     .unit = {0, 0, 0, 1, 1, 63}
@@ -62,67 +53,26 @@ static uint8_t _hours;
 static bool _colon;
 static bool _is_running;
 
-#if __EMSCRIPTEN__
-
-static long _em_interval_id = 0;
+static watch_timer_t _cb_timer;
 
-void em_cb_handler(void *userData) {
-    // interrupt handler for emscripten 128 Hz callbacks
-    (void) userData;
+static void _cb_handler(void *context) {
+    // timer callback at 128 Hz
+    (void) context;
     _ticks++;
 }
 
-static void _cb_initialize() { }
-
-static inline void _cb_stop() {
-    emscripten_clear_interval(_em_interval_id);
-    _em_interval_id = 0;
-    _is_running = false;
-}
-
 static inline void _cb_start() {
-    // initiate 128 hz callback
-    _em_interval_id = emscripten_set_interval(em_cb_handler, (double)(1000/128), (void *)NULL);
-}
-
-#else
-
-static inline void _cb_start() {
-    // start the TC2 timer
-    hri_tc_set_CTRLA_ENABLE_bit(TC2);
+    // start the 128 Hz timer
+    watch_timer_start(&_cb_timer, WATCH_TIMER_HZ(128), WATCH_TIMER_HZ(128), _cb_handler, NULL);
     _is_running = true;
 }
 
 static inline void _cb_stop() {
-    // stop the TC2 timer
-    hri_tc_clear_CTRLA_ENABLE_bit(TC2);
+    // stop the 128 Hz timer
+    watch_timer_stop(&_cb_timer);
     _is_running = false;
 }
 
-static void _cb_initialize() {
-    // setup and initialize TC2 for a 64 Hz interrupt
-    hri_mclk_set_APBCMASK_TC2_bit(MCLK);
-    hri_gclk_write_PCHCTRL_reg(GCLK, TC2_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3 | GCLK_PCHCTRL_CHEN);
-    _cb_stop();
-    hri_tc_write_CTRLA_reg(TC2, TC_CTRLA_SWRST);
-    hri_tc_wait_for_sync(TC2, TC_SYNCBUSY_SWRST);
-    hri_tc_write_CTRLA_reg(TC2, TC_CTRLA_PRESCALER_DIV64 | // 32 Khz divided by 64 divided by 4 results in a 128 Hz interrupt
-                           TC_CTRLA_MODE_COUNT8 | 
-                           TC_CTRLA_RUNSTDBY);
-    hri_tccount8_write_PER_reg(TC2, 3);
-    hri_tc_set_INTEN_OVF_bit(TC2);
-    NVIC_ClearPendingIRQ(TC2_IRQn);
-    NVIC_EnableIRQ (TC2_IRQn);
-}
-
-void TC2_Handler(void) {
-    // interrupt handler for TC2 (globally!)
-    _ticks++;
-    TC2->COUNT8.INTFLAG.reg |= TC_INTFLAG_OVF;
-}
-
-#endif
-
 static inline void _button_beep(movement_settings_t *settings) {
     // play a beep as confirmation for a button press (if applicable)
     if (settings->bit.button_should_sound) watch_buzzer_play_note(BUZZER_NOTE_C7, 50);
@@ -213,10 +163,6 @@ void stock_stopwatch_face_setup(movement_settings_t *settings, uint8_t watch_fac
     _is_running = _colon = false;
         state->light_on_button = true;
     }
-    if (!_is_running) {
-        // prepare the 128 Hz callback source
-        _cb_initialize();
-    }
 }
 
 void stock_stopwatch_face_activate(movement_settings_t *settings, void *context) {
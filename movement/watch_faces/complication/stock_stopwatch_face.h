@@ -63,18 +63,13 @@ void stock_stopwatch_face_activate(movement_settings_t *settings, void *context)
 bool stock_stopwatch_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void stock_stopwatch_face_resign(movement_settings_t *settings, void *context);
 
-#if __EMSCRIPTEN__
-void em_cb_handler(void *userData);
-#else
-void TC2_Handler(void);
-#endif
-
 #define stock_stopwatch_face ((const watch_face_t){ \
     stock_stopwatch_face_setup, \
     stock_stopwatch_face_activate, \
     stock_stopwatch_face_loop, \
     stock_stopwatch_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // STOCK_STOPWATCH_FACE_H_
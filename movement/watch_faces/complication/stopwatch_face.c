@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "stopwatch_face.h"
+#include "checkpoint.h"
 #include "watch.h"
 #include "watch_utility.h"
 
@@ -38,9 +39,13 @@ static const watch_date_time distant_future = {
 void stopwatch_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
+    // counts the stopwatches set up so far; unlike the face index, it doesn't change when other faces are added.
+    static uint8_t instances = 0;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(stopwatch_state_t));
         memset(*context_ptr, 0, sizeof(stopwatch_state_t));
+        // a running stopwatch only remembers when it started, so after a reset it picks up right where it was.
+        checkpoint_register(STORE_KEY('s', 't', 'w', '0' + instances++), *context_ptr, sizeof(stopwatch_state_t), 1);
     }
 }
 
@@ -56,6 +56,7 @@ void stopwatch_face_resign(movement_settings_t *settings, void *context);
     stopwatch_face_loop, \
     stopwatch_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // STOPWATCH_FACE_H_
@@ -25,14 +25,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include "tally_face.h"
+#include "checkpoint.h"
 #include "watch.h"
 
 void tally_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
+    // counts the tallies set up so far; unlike the face index, it doesn't change when other faces are added.
+    static uint8_t instances = 0;
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(tally_state_t));
         memset(*context_ptr, 0, sizeof(tally_state_t));
+        checkpoint_register(STORE_KEY('t', 'l', 'y', '0' + instances++), *context_ptr, sizeof(tally_state_t), 1);
     }
 }
 
@@ -23,14 +23,10 @@
  * SOFTWARE.
  */
 
-// Emulator only: need time() to seed the random number generator.
-#if __EMSCRIPTEN__
-#include <time.h>
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include "tarot_face.h"
+#include "entropy.h"
 
 #define TAROT_ANIMATION_TICK_FREQUENCY 8
 #define FLIPPED_BIT_POS 7
@@ -139,42 +135,19 @@ static void tarot_display(tarot_state_t *state) {
 }
 
 static uint8_t get_rand_num(uint8_t num_values) {
-    // Emulator: use rand. Hardware: use arc4random.
-#if __EMSCRIPTEN__
-    return rand() % num_values;
-#else
-    return arc4random_uniform(num_values);
-#endif
-}
-
-static uint8_t draw_one_card(tarot_state_t *state) {
-    if (state->major_arcana_only) {
-        return get_rand_num(NUM_MAJOR_ARCANA);
-    } else {
-        return get_rand_num(NUM_TAROT_CARDS);
-    }
-}
-
-static bool already_drawn(tarot_state_t *state, uint8_t drawn_card) {
-    for (int i = 0; state->drawn_cards[i] != 0xff && i < state->num_cards_to_draw; i++) {
-        if ((state->drawn_cards[i] & ~FLIPPED_MASK) == drawn_card) {
-            return true;
-        }
-    }
-
-    return false;
+    return entropy_uniform(num_values);
 }
 
 static void pick_cards(tarot_state_t *state) {
-    uint8_t card;
+    // shuffle the deck and deal off the top, so no card can come up twice
+    uint8_t deck[NUM_TAROT_CARDS];
+    uint8_t deck_size = state->major_arcana_only ? NUM_MAJOR_ARCANA : NUM_TAROT_CARDS;
+
+    for (uint8_t i = 0; i < deck_size; i++) deck[i] = i;
+    entropy_shuffle(deck, deck_size, sizeof(uint8_t));
 
     for (int i = 0; i < state->num_cards_to_draw; i++) {
-        card = draw_one_card(state);
-        while (already_drawn(state, card)) {
-            card = draw_one_card(state);
-        }
-        card |= get_rand_num(2) << FLIPPED_BIT_POS; // randomly flip the card
-        state->drawn_cards[i] = card;
+        state->drawn_cards[i] = deck[i] | (get_rand_num(2) << FLIPPED_BIT_POS); // randomly flip the card
     }
 }
 
@@ -215,10 +188,6 @@ void tarot_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
         *context_ptr = malloc(sizeof(tarot_state_t));
         memset(*context_ptr, 0, sizeof(tarot_state_t));
     }
-    // Emulator only: Seed random number generator
-    #if __EMSCRIPTEN__
-    srand(time(NULL));
-    #endif
 }
 
 void tarot_face_activate(movement_settings_t *settings, void *context) {
@@ -58,6 +58,13 @@ void tempchart_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
 
 }
 
+void tempchart_face_resume(movement_settings_t *settings, void *context) {
+    // The chart stays in RAM across sleep, so unlike setup there's no need to read it back from
+    // the filesystem, and the thermistor is only switched on while we take a reading.
+    (void) settings;
+    (void) context;
+}
+
 void tempchart_face_activate(movement_settings_t *settings, void *context) {
     // same as above: silence the warning, we don't need to check the settings.
     (void) settings;
@@ -117,7 +124,7 @@ bool tempchart_face_loop(movement_event_t event, movement_settings_t *settings,
             tempchart_state.stat[date_time.unit.hour+temp*24]++;
 
             if (date_time.unit.hour == 0 && date_time.unit.minute == 10)
-                tempchart_save();
+                filesystem_schedule_write(tempchart_save, FILESYSTEM_WRITE_DELAY);
 
             break;
 
@@ -45,6 +45,7 @@ void tempchart_face_activate(movement_settings_t *settings, void *context);
 bool tempchart_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void tempchart_face_resign(movement_settings_t *settings, void *context);
 bool tempchart_face_wants_background_task(movement_settings_t *settings, void *context);
+void tempchart_face_resume(movement_settings_t *settings, void *context);
 
 
 #define tempchart_face ((const watch_face_t){ \
@@ -53,6 +54,7 @@ bool tempchart_face_wants_background_task(movement_settings_t *settings, void *c
     tempchart_face_loop, \
     tempchart_face_resign, \
     tempchart_face_wants_background_task, \
+    tempchart_face_resume, \
 })
 
 #endif // TEMPCHART_FACE_H_
@@ -65,7 +65,7 @@ static void _start(timer_state_t *state, movement_settings_t *settings, bool wit
     if (with_beep) watch_buzzer_play_sequence((int8_t *)_sound_seq_start, NULL);
 }
 
-static void _draw(timer_state_t *state, uint8_t subsecond) {
+static void _draw(timer_state_t *state) {
     char buf[14];
     uint32_t delta;
     div_t result;
@@ -112,13 +112,16 @@ static void _draw(timer_state_t *state, uint8_t subsecond) {
             break;
     }
     buf[0] = 49 + state->current_timer;
-    if (state->mode == setting && subsecond % 2) {
+    bool blink = state->mode == setting && !state->quick_cycle;
+    // stop a blink that's ending before drawing, so it doesn't put back stale digits.
+    if (!blink) watch_stop_segment_animation();
+    watch_display_string(buf, 3);
+    if (blink) {
         // blink the current settings value
-        if (state->settings_state == 0) buf[0] = ' ';
-        else if (state->settings_state == 1 || state->settings_state == 5) buf[6] = ' ';
-        else buf[(state->settings_state - 1) * 2 - 1] = buf[(state->settings_state - 1) * 2] = ' ';
+        if (state->settings_state == 0) watch_start_position_blink(3, 1, 250);
+        else if (state->settings_state == 1 || state->settings_state == 5) watch_start_position_blink(9, 1, 250);
+        else watch_start_position_blink((state->settings_state - 1) * 2 + 2, 2, 250);
     }
-    watch_display_string(buf, 3);
     // set lap indicator when we have a looping timer
     if (state->timers[state->current_timer].unit.repeat) watch_set_indicator(WATCH_INDICATOR_LAP);
     else watch_clear_indicator(WATCH_INDICATOR_LAP);
@@ -177,7 +180,7 @@ static void _settings_increment(timer_state_t *state) {
 static void _abort_quick_cycle(timer_state_t *state) {
     if (state->quick_cycle) {
         state->quick_cycle = false;
-        movement_request_tick_frequency(4);
+        movement_request_tick_frequency(1);
     }
 }
 
@@ -221,22 +224,19 @@ void timer_face_activate(movement_settings_t *settings, void *context) {
 bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     (void) settings;
     timer_state_t *state = (timer_state_t *)context;
-    uint8_t subsecond = event.subsecond;
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-            _draw(state, event.subsecond);
+            _draw(state);
             break;
         case EVENT_TICK:
             if (state->mode == running) state->now_ts++;
             else if (state->mode == pausing) state->pausing_seconds++;
             else if (state->quick_cycle) {
-                if (watch_get_pin_level(BTN_ALARM)) {
-                    _settings_increment(state);
-                    subsecond = 0;
-                } else _abort_quick_cycle(state);
+                if (watch_get_pin_level(BTN_ALARM)) _settings_increment(state);
+                else _abort_quick_cycle(state);
             }
-            _draw(state, subsecond);
+            _draw(state);
             break;
         case EVENT_LIGHT_BUTTON_DOWN:
             switch (state->mode) {
@@ -256,7 +256,7 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
                 default:
                     break;
             }
-            _draw(state, event.subsecond);
+            _draw(state);
             break;
         case EVENT_LIGHT_BUTTON_UP:
             if (state->mode == waiting) movement_illuminate_led();
@@ -284,10 +284,9 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
                 }
                 case setting:
                     _settings_increment(state);
-                    subsecond = 0;
                     break;
             }
-            _draw(state, subsecond);
+            _draw(state);
             break;
         case EVENT_LIGHT_LONG_PRESS:
             if (state->mode == waiting) {
@@ -295,11 +294,10 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
                 state->mode = setting;
                 state->settings_state = 0;
                 state->erase_timer_flag = false;
-                movement_request_tick_frequency(4);
             } else if (state->mode == setting) {
                 _resume_setting(state);
             }
-            _draw(state, event.subsecond);
+            _draw(state);
             break;
         case EVENT_BACKGROUND_TASK:
             // play the alarm
@@ -336,7 +334,7 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
                 default:
                     break;
             }
-            _draw(state, event.subsecond);
+            _draw(state);
             break;
         case EVENT_ALARM_LONG_UP:
             _abort_quick_cycle(state);
@@ -361,4 +359,5 @@ void timer_face_resign(movement_settings_t *settings, void *context) {
         state->settings_state = 0;
         state->mode = waiting;
     }
+    watch_stop_segment_animation();
 }
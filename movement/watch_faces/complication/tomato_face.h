@@ -77,6 +77,7 @@ void tomato_face_resign(movement_settings_t *settings, void *context);
     tomato_face_loop, \
     tomato_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // TOMATO_FACE_H_
@@ -25,11 +25,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include "toss_up_face.h"
-#if __EMSCRIPTEN__
-#include <time.h>
-#else
-#include "saml22j18a.h"
-#endif
 
 static const char heads[] = { '8', 'h', '4', 'E', '(' };
 static const char tails[] = { '0', '+', 'N', '3', ')' };
@@ -247,18 +242,9 @@ uint8_t divine_bit(void) {
 /** @brief get 32 True Random Number bits
  */
 uint32_t get_true_entropy(void) {
-    #if __EMSCRIPTEN__
-    return rand() % INT32_MAX;
-    #else
-    hri_mclk_set_APBCMASK_TRNG_bit(MCLK);
-    hri_trng_set_CTRLA_ENABLE_bit(TRNG);
-
-    while (!hri_trng_get_INTFLAG_reg(TRNG, TRNG_INTFLAG_DATARDY)); // Wait for TRNG data to be ready
-
-    hri_trng_clear_CTRLA_ENABLE_bit(TRNG);
-    hri_mclk_clear_APBCMASK_TRNG_bit(MCLK);
-    return hri_trng_read_DATA_reg(TRNG); // Read a single 32-bit word from TRNG and return it
-    #endif
+    uint32_t word;
+    watch_trng_read(&word, 1); // Read a single 32-bit word from the TRNG
+    return word;
 }
 
 // COIN FUNCTIONS /////////////////////////////////////////////////////////////
@@ -61,14 +61,13 @@ static void _update_display(totp_state_t *totp_state) {
     uint8_t valid_for;
 
     result = div(totp_state->timestamp, timesteps[totp_state->current_index]);
-    if (result.quot != totp_state->steps) {
-        totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-        totp_state->steps = result.quot;
-    }
     valid_for = timesteps[totp_state->current_index] - result.rem;
-    sprintf(buf, "%c%c%2d%06lu", labels[totp_state->current_index][0], labels[totp_state->current_index][1], valid_for, totp_state->current_code);
+    sprintf(buf, "%c%c%2d%06lu", labels[totp_state->current_index][0], labels[totp_state->current_index][1], valid_for, totp_cache_get_code(&totp_state->cache, &totp_state->ctx, result.quot));
 
     watch_display_string(buf, 0);
+
+    // with the display up to date, use the rest of the tick to get the next code ready before it's needed.
+    totp_cache_prefetch(&totp_state->cache, &totp_state->ctx, result.quot);
 }
 
 void totp_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
@@ -81,9 +80,9 @@ void totp_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     memset(context, 0, sizeof(totp_state_t));
     totp_state_t *totp_state = (totp_state_t *)context;
-    TOTP(keys, key_sizes[0], timesteps[0], algorithms[0]);
+    totp_ctx_init(&totp_state->ctx, keys, key_sizes[0], timesteps[0], algorithms[0]);
+    totp_cache_invalidate(&totp_state->cache);
     totp_state->timestamp = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), movement_timezone_offsets[settings->bit.time_zone] * 60);
-    totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
 }
 
 bool totp_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -109,7 +108,8 @@ bool totp_face_loop(movement_event_t event, movement_settings_t *settings, void
                 totp_state->current_key_offset = 0;
                 totp_state->current_index = 0;
             }
-            TOTP(keys + totp_state->current_key_offset, key_sizes[totp_state->current_index], timesteps[totp_state->current_index], algorithms[totp_state->current_index]);
+            totp_ctx_init(&totp_state->ctx, keys + totp_state->current_key_offset, key_sizes[totp_state->current_index], timesteps[totp_state->current_index], algorithms[totp_state->current_index]);
+            totp_cache_invalidate(&totp_state->cache);
             _update_display(totp_state);
             break;
         case EVENT_ALARM_BUTTON_DOWN:
@@ -54,13 +54,14 @@
  */
 
 #include "movement.h"
+#include "TOTP.h"
 
 typedef struct {
     uint32_t timestamp;
-    uint8_t steps;
-    uint32_t current_code;
     uint8_t current_index;
     uint8_t current_key_offset;
+    totp_ctx ctx;
+    totp_cache cache;
 } totp_state_t;
 
 void totp_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -74,6 +75,7 @@ void totp_face_resign(movement_settings_t *settings, void *context);
     totp_face_loop, \
     totp_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // TOTP_FACE_H_
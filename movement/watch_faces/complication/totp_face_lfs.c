@@ -42,11 +42,13 @@
 const char* TOTP_URI_START = "otpauth://totp/";
 
 struct totp_record {
-    uint8_t *secret;
+    uint8_t *secret;        // only held while parsing; once the record is valid, ctx replaces it
     size_t secret_size;
     char label[2];
     uint32_t period;
     hmac_alg algorithm;
+    totp_ctx ctx;
+    totp_cache cache;
 };
 
 static struct totp_record totp_records[MAX_TOTP_RECORDS];
@@ -159,12 +161,20 @@ static void totp_face_lfs_read_file(char *filename) {
         } while ((param = strtok_r(NULL, "&", &param_saveptr)));
 
         if (error) {
+            if (totp_records[num_totp_records].secret_size) free(totp_records[num_totp_records].secret);
             totp_records[num_totp_records].secret_size = 0;
             continue;
         }
 
         // If we found a probably valid TOTP record, keep it. 
         if (totp_records[num_totp_records].secret_size) {
+            struct totp_record *record = &totp_records[num_totp_records];
+            // hash the key once, here, so that generating codes later doesn't have to.
+            totp_ctx_init(&record->ctx, record->secret, record->secret_size, record->period, record->algorithm);
+            totp_cache_invalidate(&record->cache);
+            memset(record->secret, 0, record->secret_size);
+            free(record->secret);
+            record->secret = NULL;
             num_totp_records += 1;
         } else {
             printf("TOTP missing secret: %s\n", line);
@@ -192,9 +202,20 @@ static void totp_face_set_record(totp_lfs_state_t *totp_state, int i) {
     }
 
     totp_state->current_index = i;
-    TOTP(totp_records[i].secret, totp_records[i].secret_size, totp_records[i].period, totp_records[i].algorithm);
-    totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-    totp_state->steps = totp_state->timestamp / totp_records[i].period;
+}
+
+// Called once the display is up to date: does one code's worth of work so that rollovers and account switches are lookups.
+// The visible account comes first, then the others take turns.
+static void totp_face_prefetch(totp_lfs_state_t *totp_state) {
+    struct totp_record *record = &totp_records[totp_state->current_index];
+
+    if (totp_cache_prefetch(&record->cache, &record->ctx, totp_state->timestamp / record->period)) return;
+
+    for (int i = 0; i < num_totp_records; i++) {
+        totp_state->prefetch_index = (totp_state->prefetch_index + 1) % num_totp_records;
+        record = &totp_records[totp_state->prefetch_index];
+        if (totp_cache_prefetch(&record->cache, &record->ctx, totp_state->timestamp / record->period)) return;
+    }
 }
 
 void totp_face_lfs_activate(movement_settings_t *settings, void *context) {
@@ -224,15 +245,13 @@ static void totp_face_display(totp_lfs_state_t *totp_state) {
     }
 
     div_t result = div(totp_state->timestamp, totp_records[index].period);
-    if (result.quot != totp_state->steps) {
-        totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-        totp_state->steps = result.quot;
-    }
+    uint32_t code = totp_cache_get_code(&totp_records[index].cache, &totp_records[index].ctx, result.quot);
     uint8_t valid_for = totp_records[index].period - result.rem;
 
-    sprintf(buf, "%c%c%2d%06lu", totp_records[index].label[0], totp_records[index].label[1], valid_for, totp_state->current_code);
+    sprintf(buf, "%c%c%2d%06lu", totp_records[index].label[0], totp_records[index].label[1], valid_for, code);
 
     watch_display_string(buf, 0);
+    totp_face_prefetch(totp_state);
 }
 
 bool totp_face_lfs_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -252,6 +271,7 @@ bool totp_face_lfs_loop(movement_event_t event, movement_settings_t *settings, v
             movement_move_to_face(0);
             break;
         case EVENT_ALARM_BUTTON_UP:
+            if (num_totp_records == 0) break;
             totp_face_set_record(totp_state, (totp_state->current_index + 1) % num_totp_records);
             totp_face_display(totp_state);
             break;
@@ -53,9 +53,8 @@
 
 typedef struct {
     uint32_t timestamp;
-    uint8_t steps;
-    uint32_t current_code;
     uint8_t current_index;
+    uint8_t prefetch_index;
 } totp_lfs_state_t;
 
 void totp_face_lfs_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -69,6 +68,7 @@ void totp_face_lfs_resign(movement_settings_t *settings, void *context);
     totp_face_lfs_loop, \
     totp_face_lfs_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // TOTP_FACE_LFS_H_
@@ -51,6 +51,7 @@ void tuning_tones_face_resign(movement_settings_t *settings, void *context);
     tuning_tones_face_loop, \
     tuning_tones_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // TUNING_TONES_FACE_H_
@@ -27,6 +27,7 @@
 #include "wake_face.h"
 #include "watch.h"
 #include "watch_utility.h"
+#include "schedule.h"
 
 //
 // Private
@@ -56,13 +57,23 @@ void _wake_face_update_display(movement_settings_t *settings, wake_face_state_t
     watch_display_string(lcdbuf, 0);
 }
 
+static
+void _wake_face_update_schedule(wake_face_state_t *state) {
+    if ( state->mode ) {
+        schedule_cron_t cron = { SCHEDULE_MINUTE(state->minute), SCHEDULE_HOUR(state->hour), SCHEDULE_ALL_DAYS };
+        // no free entry in the scheduler means this alarm would never ring; show it as off instead.
+        if (!schedule_set_cron(state->watch_face_index, 0, &cron)) state->mode = 0;
+    } else {
+        schedule_clear(state->watch_face_index, 0);
+    }
+}
+
 //
 // Exported
 //
 
 void wake_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr) {
     (void) settings;
-    (void) watch_face_index;
 
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(wake_face_state_t));
@@ -72,6 +83,7 @@ void wake_face_setup(movement_settings_t *settings, uint8_t watch_face_index, vo
         state->hour = 5;
         state->minute = 0;
         state->mode = 0;
+        state->watch_face_index = watch_face_index;
     }
 }
 
@@ -84,25 +96,6 @@ void wake_face_resign(movement_settings_t *settings, void *context) {
     (void) context;
 }
 
-bool wake_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    wake_face_state_t *state = (wake_face_state_t *)context;
-
-    bool rc = false;
-    if ( state->mode ) {
-        watch_date_time now = watch_rtc_get_date_time();
-        rc = state->hour==now.unit.hour && state->minute==now.unit.minute;
-        // We’re at the mercy of the wants_background_task handler
-        // In Safari, the emulator triggers at the ›end‹ of the minute
-        // Converting to Unix timestamps and taking a difference between now and wake
-        // is not an easy win — because the timestamp for wake has to rely on now
-        // for its date. So first we’d have to see if the TOD of wake is after that
-        // of now. If it is, take tomorrow’s date, calculating month and year rollover
-        // if need be.
-    }
-    return rc;
-}
-
 bool wake_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     (void) settings;
     wake_face_state_t *state = (wake_face_state_t *)context;
@@ -114,18 +107,22 @@ bool wake_face_loop(movement_event_t event, movement_settings_t *settings, void
         break;
     case EVENT_LIGHT_BUTTON_UP:
         state->hour = (state->hour + 1) % 24;
+        _wake_face_update_schedule(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_LIGHT_LONG_PRESS:
         state->hour = (state->hour + 6) % 24;
+        _wake_face_update_schedule(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_ALARM_BUTTON_UP:
         state->minute = (state->minute + 10) % 60;
+        _wake_face_update_schedule(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_ALARM_LONG_PRESS:
         state->mode ^= 1;
+        _wake_face_update_schedule(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_BACKGROUND_TASK:
@@ -27,13 +27,15 @@
 #include "accelerometer_data_acquisition_face.h"
 #include "watch_utility.h"
 #include "lis2dw.h"
-#include "spiflash.h"
+#include "spiflash_log.h"
 
 #define ACCELEROMETER_RANGE LIS2DW_RANGE_4_G
 #define ACCELEROMETER_LPMODE LIS2DW_LP_MODE_2
 #define ACCELEROMETER_FILTER LIS2DW_BANDWIDTH_FILTER_DIV2
 #define ACCELEROMETER_LOW_NOISE true
 #define SECONDS_TO_RECORD 15
+#define ACCELEROMETER_INT1_PIN A0   // INT1 on the Motion Express board
+#define ACCELEROMETER_FIFO_THRESHOLD 25 // one second of data at 25 Hz
 
 static const char activity_types[][3] = {
     "TE",   // Testing
@@ -56,46 +58,39 @@ static const char activity_types[][3] = {
 static void update(accelerometer_data_acquisition_state_t *state);
 static void update_settings(accelerometer_data_acquisition_state_t *state);
 static void advance_current_setting(accelerometer_data_acquisition_state_t *state);
-static void start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings);
+static bool start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings);
 static void continue_reading(accelerometer_data_acquisition_state_t *state);
 static void finish_reading(accelerometer_data_acquisition_state_t *state);
-static bool wait_for_flash_ready(void);
-static int16_t get_next_available_page(void);
-static void write_buffer_to_page(uint8_t *buf, uint16_t page);
 static void write_page(accelerometer_data_acquisition_state_t *state);
-static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint8_t centiseconds);
+static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading);
 
 void accelerometer_data_acquisition_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     accelerometer_data_acquisition_state_t *state = (accelerometer_data_acquisition_state_t *)*context_ptr;
+    spi_flash_init();
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(accelerometer_data_acquisition_state_t));
         memset(*context_ptr, 0, sizeof(accelerometer_data_acquisition_state_t));
         state = (accelerometer_data_acquisition_state_t *)*context_ptr;
         state->beep_with_countdown = true;
         state->countdown_length = 3;
+        // the log's position stays cached in RAM from here on, so we only have to scan the flash once.
+        spi_flash_log_mount(&state->log, 0, SPI_FLASH_NUM_SECTORS, false);
+        memset(state->records, 0xFF, sizeof(state->records));
     }
-    spi_flash_init();
-    wait_for_flash_ready();
-    uint8_t buf[256] = {0xFF};
-    spi_flash_read_data(0, buf, 256);
-    if (buf[0] & 0xF0) {
-        // mark first four pages as used
-        buf[0] = 0x0F;
-        wait_for_flash_ready();
-        watch_set_pin_level(A3, false);
-        spi_flash_command(CMD_ENABLE_WRITE);
-        wait_for_flash_ready();
-        spi_flash_write_data(0, buf, 256);
-    }
+}
 
+void accelerometer_data_acquisition_face_resume(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+    // sleep mode turned the SPI bus off; everything else we set up at boot is still in our context.
+    spi_flash_init();
 }
 
 void accelerometer_data_acquisition_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
-    accelerometer_data_acquisition_state_t *state = (accelerometer_data_acquisition_state_t *)context;
-    state->next_available_page = get_next_available_page();
+    (void) context;
 }
 
 bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -117,7 +112,7 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
                     }
                     break;
                 case ACCELEROMETER_DATA_ACQUISITION_MODE_COUNTDOWN:
-                    if (state->next_available_page < 0) {
+                    if (spi_flash_log_is_full(&state->log)) {
                         state->countdown_ticks = 0;
                         state->repeat_ticks = 0;
                         state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE;
@@ -127,11 +122,20 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
                         printf("countdown: %d\n", state->countdown_ticks);
                         if (state->countdown_ticks == 0) {
                             // at zero, begin reading
-                            state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_SENSING;
-                            state->reading_ticks = SECONDS_TO_RECORD + 1;
-                            // also beep if the user asked for it
-                            if (state->beep_with_countdown) watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
-                            start_reading(state, settings);
+                            if (start_reading(state, settings)) {
+                                state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_SENSING;
+                                state->reading_ticks = SECONDS_TO_RECORD + 1;
+                                // also beep if the user asked for it
+                                if (state->beep_with_countdown) watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
+                            } else {
+                                // the accelerometer is busy; give up, and say so.
+                                state->repeat_ticks = 0;
+                                state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE;
+                                watch_buzzer_play_note(BUZZER_NOTE_C4, 250);
+                                update(state);
+                                watch_display_string("  bUSY", 4);
+                                break;
+                            }
                         } else if (state->countdown_ticks < 3) {
                             // beep for last two ticks before reading
                             if (state->beep_with_countdown) watch_buzzer_play_note(BUZZER_NOTE_C5, 75);
@@ -259,14 +263,14 @@ static void update(accelerometer_data_acquisition_state_t *state) {
     sprintf(buf, "%s%2dre%2d#o",
             activity_types[state->activity_type_index],
             ticks,
-            (8192 - state->next_available_page) / 82);
+            spi_flash_log_get_free_pages(&state->log) / ACCELEROMETER_DATA_ACQUISITION_PAGES_PER_PERCENT);
     watch_display_string(buf, 0);
 
     watch_set_colon();
 
     // special case: display full if full, <1% if nearly full
-    if (state->next_available_page < 0) watch_display_string(" FUL", 6);
-    else if (state->next_available_page > 8110) watch_display_string("<1", 6);
+    if (spi_flash_log_is_full(&state->log)) watch_display_string(" FUL", 6);
+    else if (spi_flash_log_get_free_pages(&state->log) < ACCELEROMETER_DATA_ACQUISITION_PAGES_PER_PERCENT) watch_display_string("<1", 6);
 
     // Bell if beep enabled
     if (state->beep_with_countdown) watch_set_indicator(WATCH_INDICATOR_BELL);
@@ -329,91 +333,15 @@ static void advance_current_setting(accelerometer_data_acquisition_state_t *stat
     }
 }
 
-static int16_t get_next_available_page(void) {
-    uint8_t buf[256] = {0};
-
-    uint16_t page = 0;
-    for(int16_t i = 0; i < 4; i++) {
-        wait_for_flash_ready();
-        spi_flash_read_data(i * 256, buf, 256);
-        for(int16_t j = 0; j < 256; j++) {
-            if(buf[j] == 0) {
-                page += 8;
-            } else {
-                page += __builtin_clz(((uint32_t)buf[j]) << 24);
-                break;
-            }
-        }
-    }
-
-    if (page >= 8192) return -1;
-
-    return page;
-}
-
-static void write_buffer_to_page(uint8_t *buf, uint16_t page) {
-    uint32_t address = 256 * page;
-
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_command(CMD_ENABLE_WRITE);
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_write_data(address, buf, 256);
-    wait_for_flash_ready();
-
-    uint8_t buf2[256];
-    watch_set_pin_level(A3, false);
-    spi_flash_read_data(address, buf2, 256);
-    wait_for_flash_ready();
-
-    uint8_t used_pages[256] = {0xFF};
-    uint16_t address_to_mark_used = page / 8;
-    uint8_t header_page = address_to_mark_used / 256;
-    uint8_t used_byte = 0x7F >> (page % 8);
-    uint8_t offset_in_buf = address_to_mark_used % 256;
-
-    printf("\twrite 256 bytes to address %ld, page %d.\n", address, page);
-    for(int i = 0; i < 256; i++) {
-        if (buf[i] != buf2[i]) {
-            printf("\tData mismatch detected at offset  %d: %d != %d.\n", i, buf[i], buf2[i]);
-        }
-    }
-
-    watch_set_pin_level(A3, false);
-    spi_flash_read_data(header_page * 256, used_pages, 256);
-    used_pages[offset_in_buf] = used_byte;
-    watch_set_pin_level(A3, false);
-    spi_flash_command(CMD_ENABLE_WRITE);
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_write_data(header_page * 256, used_pages, 256);
-    wait_for_flash_ready();
-}
-
-static bool wait_for_flash_ready(void) {
-    watch_set_pin_level(A3, false);
-    bool ok = true;
-    uint8_t read_status_response[1] = {0x00};
-    do {
-        ok = spi_flash_read_command(CMD_READ_STATUS, read_status_response, 1);
-    } while ((read_status_response[0] & 0x3) != 0);
-    delay_ms(1); // why do i need this?
-    watch_set_pin_level(A3, true);
-    return ok;
-}
-
 static void write_page(accelerometer_data_acquisition_state_t *state) {
-    if (state->next_available_page > 0) {
-        write_buffer_to_page((uint8_t *)(state->records), state->next_available_page);
-        wait_for_flash_ready();
-        state->next_available_page++;
+    if (!spi_flash_log_append(&state->log, state->records, sizeof(state->records))) {
+        printf("\tLog is full, dropped a page.\n");
     }
     state->pos = 0;
     memset(state->records, 0xFF, sizeof(state->records));
 }
 
-static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint8_t centiseconds) {
+static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading) {
     accelerometer_data_acquisition_record_t record;
     record.data.x.record_type = ACCELEROMETER_DATA_ACQUISITION_DATA;
     record.data.y.lpmode = ACCELEROMETER_LPMODE;
@@ -421,16 +349,19 @@ static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw
     record.data.x.accel = (reading.x >> 2) + 8192;
     record.data.y.accel = (reading.y >> 2) + 8192;
     record.data.z.accel = (reading.z >> 2) + 8192;
-    record.data.counter = 100 * (SECONDS_TO_RECORD - state->reading_ticks + 1) + centiseconds;
+    // samples arrive at exactly 25 Hz as the accelerometer sees it, so each one is 4 centiseconds after the last.
+    record.data.counter = 100 + 4 * state->samples_logged++;
     printf("logged data point for %d\n", record.data.counter);
     state->records[state->pos++] = record;
-    if (state->pos >= 32) {
+    if (state->pos >= ACCELEROMETER_DATA_ACQUISITION_RECORDS_PER_PAGE) {
         write_page(state);
     }
 }
 
-static void start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings) {
+static bool start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings) {
     printf("Start reading\n");
+    // another face (like the activity counter) may be streaming from the accelerometer; don't pull it out from under them.
+    if (!lis2dw_stream_is_available(state)) return false;
     watch_enable_i2c();
     lis2dw_begin();
     lis2dw_set_data_rate(LIS2DW_DATA_RATE_25_HZ);
@@ -438,7 +369,6 @@ static void start_reading(accelerometer_data_acquisition_state_t *state, movemen
     lis2dw_set_low_power_mode(ACCELEROMETER_LPMODE);
     lis2dw_set_bandwidth_filtering(ACCELEROMETER_FILTER);
     if (ACCELEROMETER_LOW_NOISE) lis2dw_set_low_noise_mode(true);
-    lis2dw_enable_fifo();
 
     accelerometer_data_acquisition_record_t record;
     watch_date_time date_time = watch_rtc_get_date_time();
@@ -451,29 +381,33 @@ static void start_reading(accelerometer_data_acquisition_state_t *state, movemen
     record.header.timestamp = state->starting_timestamp;
 
     state->records[state->pos++] = record;
-    lis2dw_fifo_t fifo;
-    lis2dw_read_fifo(&fifo); // dump the fifo, this starts a fresh round of data in continue_reading
+    state->samples_logged = 0;
+    // the FIFO's threshold interrupt wakes us once per second of data, and the batch is drained in the background.
+    return lis2dw_start_stream(state, ACCELEROMETER_INT1_PIN, false, ACCELEROMETER_FIFO_THRESHOLD);
 }
 
 static void continue_reading(accelerometer_data_acquisition_state_t *state) {
     printf("Continue reading\n");
-    lis2dw_fifo_t fifo;
-    lis2dw_read_fifo(&fifo);
-
-    fifo.count = min(fifo.count, 25); // hacky, but we need a consistent data rate; if we got a 26th data point, chuck it.
-    uint8_t offset = 4 * (25 - fifo.count); // also hacky: we're sometimes short at the start. align to beginning of next second.
-    // TODO: use the threshold interrupt for this, will mean we get consistent 25 Hz data as the accelerometer sees it.
+    lis2dw_fifo_t *fifo;
 
-    for(int i = 0; i < fifo.count; i++) {
-        log_data_point(state, fifo.readings[i], i * 4 + offset);
+    while ((fifo = lis2dw_stream_get_batch()) != NULL) {
+        for(int i = 0; i < fifo->count; i++) {
+            log_data_point(state, fifo->readings[i]);
+        }
+        lis2dw_stream_release_batch();
     }
 }
 
 static void finish_reading(accelerometer_data_acquisition_state_t *state) {
     printf("Finish reading\n");
+    // pick up any batch that was still being drained on the last tick
+    watch_i2c_wait_for_idle();
+    continue_reading(state);
     if (state->pos != 0) {
         write_page(state);
     }
+    if (lis2dw_stream_get_dropped_batches()) printf("Dropped %d batches\n", lis2dw_stream_get_dropped_batches());
+    lis2dw_stop_stream(state);
     lis2dw_set_data_rate(LIS2DW_DATA_RATE_POWERDOWN);
     watch_disable_i2c();
 
@@ -32,6 +32,7 @@
  */
 
 #include "movement.h"
+#include "spiflash_log.h"
 
 #define ACCELEROMETER_DATA_ACQUISITION_INVALID ((uint64_t)(0b11))   // all bits are 1 when the flash is erased
 #define ACCELEROMETER_DATA_ACQUISITION_HEADER ((uint64_t)(0b10))
@@ -67,6 +68,9 @@ typedef union {
     uint64_t value;
 } accelerometer_data_acquisition_record_t;
 
+#define ACCELEROMETER_DATA_ACQUISITION_RECORDS_PER_PAGE (SPI_FLASH_LOG_PAYLOAD_SIZE / sizeof(accelerometer_data_acquisition_record_t))
+#define ACCELEROMETER_DATA_ACQUISITION_PAGES_PER_PERCENT ((SPI_FLASH_NUM_SECTORS * SPI_FLASH_PAGES_PER_SECTOR + 99) / 100)
+
 typedef enum {
     ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE,
     ACCELEROMETER_DATA_ACQUISITION_MODE_COUNTDOWN,
@@ -90,14 +94,15 @@ typedef struct {
     bool beep_with_countdown;   // should we beep at the countdown
     uint8_t countdown_length;   // how many seconds to count down
     uint16_t repeat_interval;   // how many seconds to wait for a repeat
-    // info about the flash chip
-    int16_t next_available_page;
+    // the log on the flash chip
+    spi_flash_log_t log;
     // transient properties
     uint8_t countdown_ticks;
     uint8_t repeat_ticks;
     uint8_t reading_ticks;
     uint32_t starting_timestamp;
-    accelerometer_data_acquisition_record_t records[32];
+    uint16_t samples_logged;
+    accelerometer_data_acquisition_record_t records[ACCELEROMETER_DATA_ACQUISITION_RECORDS_PER_PAGE];
     uint16_t pos;
 } accelerometer_data_acquisition_state_t;
 
@@ -105,6 +110,7 @@ void accelerometer_data_acquisition_face_setup(movement_settings_t *settings, ui
 void accelerometer_data_acquisition_face_activate(movement_settings_t *settings, void *context);
 bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void accelerometer_data_acquisition_face_resign(movement_settings_t *settings, void *context);
+void accelerometer_data_acquisition_face_resume(movement_settings_t *settings, void *context);
 
 #define accelerometer_data_acquisition_face ((const watch_face_t){ \
     accelerometer_data_acquisition_face_setup, \
@@ -112,6 +118,7 @@ void accelerometer_data_acquisition_face_resign(movement_settings_t *settings, v
     accelerometer_data_acquisition_face_loop, \
     accelerometer_data_acquisition_face_resign, \
     NULL, \
+    accelerometer_data_acquisition_face_resume, \
 })
 
 #endif // ACCELEROMETER_DATA_ACQUISITION_FACE_H_
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "activity_counter_face.h"
+#include "lis2dw.h"
+#include "watch.h"
+
+#define ACTIVITY_COUNTER_INT1_PIN A0     // INT1 on the Motion Express board
+#define ACTIVITY_COUNTER_FIFO_THRESHOLD 25 // one second of data at 25 Hz
+
+static const char activity_counter_labels[ACTIVITY_NUM_CLASSES][3] = {
+    "ID",   // Idle
+    "WA",   // Walking
+    "RU",   // Running
+    "AC",   // Active, but not walking or running
+};
+
+// the stream calls us from its interrupt, whichever face is on screen, so it needs to know where the totals are.
+static activity_counter_state_t *_activity_counter_state;
+
+static void _activity_counter_face_update_display(activity_counter_state_t *state) {
+    char buf[14];
+
+    if (state->page == 0) {
+        sprintf(buf, "%s  %6lu", activity_counter_labels[activity_get_class(&state->activity)], state->activity.steps % 1000000);
+        watch_clear_colon();
+    } else {
+        // pages 1 through 4 show the time spent in each class, as hours and minutes on either side of the colon...
+        uint32_t minutes = state->activity.seconds[state->page - 1] / 60;
+        if (minutes < 100 * 60) {
+            sprintf(buf, "%s  %2lu%02lu  ", activity_counter_labels[state->page - 1], minutes / 60, minutes % 60);
+            watch_set_colon();
+        } else {
+            // ...or, past 99 hours, as whole hours.
+            sprintf(buf, "%s  %4luhr", activity_counter_labels[state->page - 1], (minutes / 60) % 10000);
+            watch_clear_colon();
+        }
+    }
+    watch_display_string(buf, 0);
+}
+
+static void _activity_counter_face_consume_batches(void) {
+    lis2dw_fifo_t *fifo;
+
+    while ((fifo = lis2dw_stream_get_batch()) != NULL) {
+        for(int i = 0; i < fifo->count; i++) {
+            activity_add_sample(&_activity_counter_state->activity, fifo->readings[i].x, fifo->readings[i].y, fifo->readings[i].z);
+        }
+        lis2dw_stream_release_batch();
+    }
+}
+
+void activity_counter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    (void) watch_face_index;
+    if (*context_ptr == NULL) {
+        *context_ptr = malloc(sizeof(activity_counter_state_t));
+        memset(*context_ptr, 0, sizeof(activity_counter_state_t));
+        activity_init(&((activity_counter_state_t *)*context_ptr)->activity);
+    }
+    _activity_counter_state = (activity_counter_state_t *)*context_ptr;
+
+    // setup runs at boot and again after every wake from sleep mode, which turns the I2C bus off; either way,
+    // (re)start the stream here and leave it running, so the totals keep counting whatever face is on screen.
+    // if some other face is streaming, leave the sensor to it.
+    if (!lis2dw_stream_is_available(_activity_counter_state)) return;
+    watch_enable_i2c();
+    if (!lis2dw_begin()) {
+        // no accelerometer on this board, so there's nothing to count.
+        watch_disable_i2c();
+        return;
+    }
+    lis2dw_set_data_rate(LIS2DW_DATA_RATE_25_HZ);
+    lis2dw_set_range(LIS2DW_RANGE_4_G);
+    lis2dw_set_low_power_mode(LIS2DW_LP_MODE_2);
+    lis2dw_set_low_noise_mode(true);
+    if (lis2dw_start_stream(_activity_counter_state, ACTIVITY_COUNTER_INT1_PIN, false, ACTIVITY_COUNTER_FIFO_THRESHOLD)) {
+        lis2dw_stream_set_batch_callback(_activity_counter_state, _activity_counter_face_consume_batches);
+    }
+}
+
+void activity_counter_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    activity_counter_state_t *state = (activity_counter_state_t *)context;
+    state->page = 0;
+}
+
+bool activity_counter_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    activity_counter_state_t *state = (activity_counter_state_t *)context;
+
+    switch (event.event_type) {
+        case EVENT_ALARM_BUTTON_UP:
+            state->page = (state->page + 1) % (ACTIVITY_NUM_CLASSES + 1);
+            _activity_counter_face_update_display(state);
+            break;
+        case EVENT_ALARM_LONG_PRESS:
+            // keep the interrupt from counting into the totals while we clear them.
+            lis2dw_stream_set_batch_callback(state, NULL);
+            activity_init(&state->activity);
+            lis2dw_stream_set_batch_callback(state, _activity_counter_face_consume_batches);
+            state->page = 0;
+            _activity_counter_face_update_display(state);
+            break;
+        case EVENT_ACTIVATE:
+        case EVENT_TICK:
+            _activity_counter_face_update_display(state);
+            break;
+        default:
+            return movement_default_loop_handler(event, settings);
+    }
+
+    return true;
+}
+
+void activity_counter_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+    // the stream stays on; see setup.
+}
@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ACTIVITY_COUNTER_FACE_H_
+#define ACTIVITY_COUNTER_FACE_H_
+
+/*
+ * ACTIVITY COUNTER
+ *
+ * Counts steps and tallies time spent idle, walking, running and otherwise moving, using the
+ * accelerometer on a Sensor Watch Motion board. The classifier runs on the watch, one FIFO batch
+ * at a time, and only the totals are kept; raw samples never leave the accelerometer's FIFO.
+ *
+ * The accelerometer streams at 25 Hz and wakes the watch once per second of data, and each batch is
+ * classified as soon as it arrives, so the totals keep counting whichever face is on screen. Low
+ * energy mode turns the I2C bus off, though, so counting pauses while the watch sleeps and picks up
+ * again when it wakes. There is only one accelerometer stream, and this face holds it from boot, so
+ * another face that streams from the accelerometer (like the data acquisition face) shows "bUSY"
+ * instead of recording. On a board without an accelerometer, the face doesn't stream, and its totals
+ * stay at zero.
+ *
+ * The top left shows the current activity: ID (idle), WA (walking), RU (running) or AC (active).
+ * The main display shows the step count. Press Alarm to cycle through the hours and minutes spent in
+ * each activity, and long-press Alarm to reset all totals.
+ */
+
+#include "movement.h"
+#include "activity.h"
+
+typedef struct {
+    activity_state_t activity;
+    uint8_t page;
+} activity_counter_state_t;
+
+void activity_counter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void activity_counter_face_activate(movement_settings_t *settings, void *context);
+bool activity_counter_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void activity_counter_face_resign(movement_settings_t *settings, void *context);
+
+#define activity_counter_face ((const watch_face_t){ \
+    activity_counter_face_setup, \
+    activity_counter_face_activate, \
+    activity_counter_face_loop, \
+    activity_counter_face_resign, \
+    NULL, \
+    NULL, \
+})
+
+#endif // ACTIVITY_COUNTER_FACE_H_
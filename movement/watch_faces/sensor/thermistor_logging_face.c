@@ -30,11 +30,13 @@
 
 static void _thermistor_logging_face_log_data(thermistor_logger_state_t *logger_state) {
     thermistor_driver_enable();
+    // let the ADC take its samples while we work out when this is and where it goes.
+    bool started = thermistor_driver_start_reading();
     watch_date_time date_time = watch_rtc_get_date_time();
     size_t pos = logger_state->data_points % THERMISTOR_LOGGING_NUM_DATA_POINTS;
 
     logger_state->data[pos].timestamp.reg = date_time.reg;
-    logger_state->data[pos].temperature_c = thermistor_driver_get_temperature();
+    logger_state->data[pos].temperature_c = started ? thermistor_driver_finish_reading() : thermistor_driver_get_temperature();
     logger_state->data_points++;
 
     thermistor_driver_disable();
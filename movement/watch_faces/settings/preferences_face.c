@@ -26,12 +26,13 @@
 #include "preferences_face.h"
 #include "watch.h"
 
-#define PREFERENCES_FACE_NUM_PREFEFENCES (7)
+#define PREFERENCES_FACE_NUM_PREFEFENCES (8)
 const char preferences_face_titles[PREFERENCES_FACE_NUM_PREFEFENCES][11] = {
     "CL        ",   // Clock: 12 or 24 hour
     "BT  Beep  ",   // Buttons: should they beep?
     "TO        ",   // Timeout: how long before we snap back to the clock face?
     "LE        ",   // Low Energy mode: how long before it engages?
+    "LE  SeC   ",   // Low Energy mode: should the seconds keep counting?
     "LT        ",   // Light: duration
 #ifdef WATCH_IS_BLUE_BOARD
     "LT   blu  ",   // Light: blue component (for watches with blue LED)
@@ -50,7 +51,6 @@ void preferences_face_setup(movement_settings_t *settings, uint8_t watch_face_in
 void preferences_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     *((uint8_t *)context) = 0;
-    movement_request_tick_frequency(4); // we need to manually blink some pixels
 }
 
 bool preferences_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -66,6 +66,10 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
             return false;
         case EVENT_LIGHT_BUTTON_DOWN:
             current_page = (current_page + 1) % PREFERENCES_FACE_NUM_PREFEFENCES;
+#ifndef WATCH_SLCD_USE_DMA
+            // without SLCD_DMA=1 the display can't count the seconds on its own, so don't offer to.
+            if (current_page == 4) current_page++;
+#endif
             *((uint8_t *)context) = current_page;
             break;
         case EVENT_ALARM_BUTTON_UP:
@@ -82,13 +86,18 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
                 case 3:
                     settings->bit.le_interval = settings->bit.le_interval + 1;
                     break;
+#ifdef WATCH_SLCD_USE_DMA
                 case 4:
-                    settings->bit.led_duration = settings->bit.led_duration + 1;
+                    settings->bit.le_seconds = !(settings->bit.le_seconds);
                     break;
+#endif
                 case 5:
-                    settings->bit.led_green_color = settings->bit.led_green_color + 1;
+                    settings->bit.led_duration = settings->bit.led_duration + 1;
                     break;
                 case 6:
+                    settings->bit.led_green_color = settings->bit.led_green_color + 1;
+                    break;
+                case 7:
                     settings->bit.led_red_color = settings->bit.led_red_color + 1;
                     break;
             }
@@ -102,83 +111,104 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
 
     watch_display_string((char *)preferences_face_titles[current_page], 0);
 
-    // blink active setting on even-numbered quarter-seconds
-    if (event.subsecond % 2) {
-        char buf[8];
-        switch (current_page) {
-            case 0:
-                if (settings->bit.clock_mode_24h) watch_display_string("24h", 4);
-                else watch_display_string("12h", 4);
-                break;
-            case 1:
-                if (settings->bit.button_should_sound) watch_display_string("y", 9);
-                else watch_display_string("n", 9);
-                break;
-            case 2:
-                switch (settings->bit.to_interval) {
-                    case 0:
-                        watch_display_string("60 SeC", 4);
-                        break;
-                    case 1:
-                        watch_display_string("2 n&in", 4);
-                        break;
-                    case 2:
-                        watch_display_string("5 n&in", 4);
-                        break;
-                    case 3:
-                        watch_display_string("30n&in", 4);
-                        break;
-                }
-                break;
-            case 3:
-                switch (settings->bit.le_interval) {
-                    case 0:
-                        watch_display_string(" Never", 4);
-                        break;
-                    case 1:
-                        watch_display_string("1 hour", 4);
-                        break;
-                    case 2:
-                        watch_display_string("2 hour", 4);
-                        break;
-                    case 3:
-                        watch_display_string("6 hour", 4);
-                        break;
-                    case 4:
-                        watch_display_string("12 hr", 4);
-                        break;
-                    case 5:
-                        watch_display_string(" 1 day", 4);
-                        break;
-                    case 6:
-                        watch_display_string(" 2 day", 4);
-                        break;
-                    case 7:
-                        watch_display_string(" 7 day", 4);
-                        break;
-                }
-                break;
-            case 4:
-                if (settings->bit.led_duration) {
-                    sprintf(buf, " %1d SeC", settings->bit.led_duration * 2 - 1);
-                    watch_display_string(buf, 4);
-                } else {
-                    watch_display_string("no LEd", 4);
-                }
-                break;
-            case 5:
-                sprintf(buf, "%2d", settings->bit.led_green_color);
-                watch_display_string(buf, 8);
-                break;
-            case 6:
-                sprintf(buf, "%2d", settings->bit.led_red_color);
-                watch_display_string(buf, 8);
-                break;
-        }
+    char buf[8];
+    switch (current_page) {
+        case 0:
+            if (settings->bit.clock_mode_24h) watch_display_string("24h", 4);
+            else watch_display_string("12h", 4);
+            break;
+        case 1:
+            if (settings->bit.button_should_sound) watch_display_string("y", 9);
+            else watch_display_string("n", 9);
+            break;
+        case 2:
+            switch (settings->bit.to_interval) {
+                case 0:
+                    watch_display_string("60 SeC", 4);
+                    break;
+                case 1:
+                    watch_display_string("2 n&in", 4);
+                    break;
+                case 2:
+                    watch_display_string("5 n&in", 4);
+                    break;
+                case 3:
+                    watch_display_string("30n&in", 4);
+                    break;
+            }
+            break;
+        case 3:
+            switch (settings->bit.le_interval) {
+                case 0:
+                    watch_display_string(" Never", 4);
+                    break;
+                case 1:
+                    watch_display_string("1 hour", 4);
+                    break;
+                case 2:
+                    watch_display_string("2 hour", 4);
+                    break;
+                case 3:
+                    watch_display_string("6 hour", 4);
+                    break;
+                case 4:
+                    watch_display_string("12 hr", 4);
+                    break;
+                case 5:
+                    watch_display_string(" 1 day", 4);
+                    break;
+                case 6:
+                    watch_display_string(" 2 day", 4);
+                    break;
+                case 7:
+                    watch_display_string(" 7 day", 4);
+                    break;
+            }
+            break;
+#ifdef WATCH_SLCD_USE_DMA
+        case 4:
+            if (settings->bit.le_seconds) watch_display_string("y", 9);
+            else watch_display_string("n", 9);
+            break;
+#endif
+        case 5:
+            if (settings->bit.led_duration) {
+                sprintf(buf, " %1d SeC", settings->bit.led_duration * 2 - 1);
+                watch_display_string(buf, 4);
+            } else {
+                watch_display_string("no LEd", 4);
+            }
+            break;
+        case 6:
+            sprintf(buf, "%2d", settings->bit.led_green_color);
+            watch_display_string(buf, 8);
+            break;
+        case 7:
+            sprintf(buf, "%2d", settings->bit.led_red_color);
+            watch_display_string(buf, 8);
+            break;
+    }
+
+    // blink the active setting; this doesn't need fast ticks, and redrawing the same setting keeps the blink in step.
+    switch (current_page) {
+        case 0:
+            watch_start_position_blink(4, 3, 250);
+            break;
+        case 1:
+        case 4:
+            watch_start_position_blink(9, 1, 250);
+            break;
+        case 6:
+        case 7:
+            watch_start_position_blink(8, 2, 250);
+            break;
+        default:
+            watch_start_position_blink(4, 6, 250);
+            break;
     }
 
     // on LED color select screns, preview the color.
-    if (current_page >= 5) {
+    if (current_page >= 6) {
         watch_set_led_color(settings->bit.led_red_color ? (0xF | settings->bit.led_red_color << 4) : 0,
                             settings->bit.led_green_color ? (0xF | settings->bit.led_green_color << 4) : 0);
         // return false so the watch stays awake (needed for the PWM driver to function).
@@ -192,6 +222,7 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
 void preferences_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
     (void) context;
+    watch_stop_segment_animation();
     watch_set_led_off();
     watch_store_backup_data(settings->reg, 0);
 }
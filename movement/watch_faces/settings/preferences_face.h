@@ -59,6 +59,9 @@
  *      lose the seconds indicator while it is asleep. This setting allows
  *      you to make a tradeoff between the device’s responsiveness and its
  *      longevity.
+ *      A second LE screen, “SeC”, chooses whether the seconds keep counting
+ *      while asleep. If Y, the display hardware advances them on its own
+ *      without waking the watch, for a small cost in battery life.
  *
  *  LT - Light.
  *      This setting has three screens.
@@ -89,6 +92,7 @@ void preferences_face_resign(movement_settings_t *settings, void *context);
     preferences_face_loop, \
     preferences_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // PREFERENCES_FACE_H_
@@ -73,10 +73,19 @@ static void _handle_alarm_button(movement_settings_t *settings, watch_date_time
 static void _abort_quick_ticks() {
     if (_quick_ticks_running) {
         _quick_ticks_running = false;
-        movement_request_tick_frequency(4);
+        movement_request_tick_frequency(1);
     }
 }
 
+static void _blink_time_zone(void) {
+    // the time zone page blinks the whole offset, colon and all.
+    watch_segments_t segments = {0};
+    for (uint8_t position = 4; position < 10; position++) watch_segments_add_position(&segments, position);
+    watch_segments_add_pixel(&segments, 1, 16);
+    const watch_segments_t frames[2] = { watch_get_segments(segments), {{0}} };
+    watch_start_segment_animation(segments, frames, 2, 250);
+}
+
 void set_time_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
@@ -86,7 +95,6 @@ void set_time_face_setup(movement_settings_t *settings, uint8_t watch_face_index
 void set_time_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     *((uint8_t *)context) = 0;
-    movement_request_tick_frequency(4);
     _quick_ticks_running = false;
 }
 
@@ -130,6 +138,11 @@ bool set_time_face_loop(movement_event_t event, movement_settings_t *settings, v
             return movement_default_loop_handler(event, settings);
     }
 
+    // the blink shows what was on screen when it started, so stop it before drawing if it's ending.
+    if (_quick_ticks_running) watch_stop_segment_animation();
+    // the alarm button may have just set the clock, and at 1 Hz the next tick is too far off to show it.
+    date_time = watch_rtc_get_date_time();
+
     char buf[11];
     if (current_page < 3) {
         watch_set_colon();
@@ -147,41 +160,40 @@ bool set_time_face_loop(movement_event_t event, movement_settings_t *settings, v
         watch_clear_indicator(WATCH_INDICATOR_PM);
         sprintf(buf, "%s  %2d%02d%02d", set_time_face_titles[current_page], date_time.unit.year + 20, date_time.unit.month, date_time.unit.day);
     } else {
-        if (event.subsecond % 2) {
-            watch_clear_colon();
-            sprintf(buf, "%s        ", set_time_face_titles[current_page]);
-        } else {
-            watch_set_colon();
-            sprintf(buf, "%s %3d%02d  ", set_time_face_titles[current_page], (int8_t) (movement_timezone_offsets[settings->bit.time_zone] / 60), (int8_t) (movement_timezone_offsets[settings->bit.time_zone] % 60) * (movement_timezone_offsets[settings->bit.time_zone] < 0 ? -1 : 1));
-        }
+        watch_set_colon();
+        sprintf(buf, "%s %3d%02d  ", set_time_face_titles[current_page], (int8_t) (movement_timezone_offsets[settings->bit.time_zone] / 60), (int8_t) (movement_timezone_offsets[settings->bit.time_zone] % 60) * (movement_timezone_offsets[settings->bit.time_zone] < 0 ? -1 : 1));
     }
 
+    watch_display_string(buf, 0);
+
     // blink up the parameter we're setting
-    if (event.subsecond % 2 && !_quick_ticks_running) {
+    if (!_quick_ticks_running) {
         switch (current_page) {
             case 0:
             case 3:
-                buf[4] = buf[5] = ' ';
+                watch_start_position_blink(4, 2, 250);
                 break;
             case 1:
             case 4:
-                buf[6] = buf[7] = ' ';
+                watch_start_position_blink(6, 2, 250);
                 break;
             case 2:
             case 5:
-                buf[8] = buf[9] = ' ';
+                watch_start_position_blink(8, 2, 250);
+                break;
+            case 6:
+                _blink_time_zone();
                 break;
         }
     }
 
-    watch_display_string(buf, 0);
-
     return true;
 }
 
 void set_time_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
     (void) context;
+    watch_stop_segment_animation();
     watch_set_led_off();
     watch_store_backup_data(settings->reg, 0);
 }
@@ -55,6 +55,7 @@ void set_time_face_resign(movement_settings_t *settings, void *context);
     set_time_face_loop, \
     set_time_face_resign, \
     NULL, \
+    NULL, \
 })
 
 #endif // SET_TIME_FACE_H_
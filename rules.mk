@@ -8,7 +8,9 @@ SUBMODULES = tinyusb
 
 COBRA = cobra -f
 
-ifndef EMSCRIPTEN
+ifdef HEADLESS
+all: $(BUILD)/$(BIN)
+else ifndef EMSCRIPTEN
 all: $(BUILD)/$(BIN).elf $(BUILD)/$(BIN).hex $(BUILD)/$(BIN).bin $(BUILD)/$(BIN).uf2 size
 else
 all: $(BUILD)/$(BIN).html
@@ -22,6 +24,10 @@ $(BUILD)/$(BIN).html: $(OBJS)
 		-s EXPORTED_FUNCTIONS=_main \
 		--shell-file=$(TOP)/watch-library/simulator/shell.html
 
+$(BUILD)/$(BIN): $(OBJS)
+	@echo LD $@
+	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@
+
 $(BUILD)/$(BIN).elf: $(OBJS)
 	@echo LD $@
 	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Builds an asset pack for Movement (see movement/asset.h) and wraps it in a UF2 that the bootloader
+# writes to the asset region, so you can drag it onto the WATCHBOOT drive just like a firmware update.
+#
+#   python3 utils/asset_pack.py -o assets.uf2 tarot=tarot.bin kitchen.bin
+#
+# Each asset is given as name=path, or just a path, in which case its file name (minus the extension)
+# is its name. Names can be at most 15 characters long.
+import sys
+import os.path
+import struct
+import argparse
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import uf2conv
+
+# keep these in step with movement/asset.h and the linker script.
+ASSET_PACK_MAGIC = 0x5041564D # "MVAP"
+ASSET_PACK_VERSION = 1
+ASSET_NAME_LENGTH = 16
+ASSET_REGION_START = 0x00040000 - 0x2000 - 0x8000
+ASSET_REGION_SIZE = 0x8000
+
+HEADER_FORMAT = "<IHHII"
+ENTRY_FORMAT = "<%dsII" % ASSET_NAME_LENGTH
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def align(n):
+    return (n + 3) & ~3
+
+
+def build_pack(assets):
+    names = sorted(assets.keys(), key=lambda name: name.encode("ascii"))
+    index_end = struct.calcsize(HEADER_FORMAT) + len(names) * struct.calcsize(ENTRY_FORMAT)
+    index = b""
+    blobs = b""
+    offset = align(index_end)
+    for name in names:
+        data = assets[name]
+        index += struct.pack(ENTRY_FORMAT, name.encode("ascii"), offset, len(data))
+        blobs += data + b"\x00" * (align(len(data)) - len(data))
+        offset += align(len(data))
+    body = index + b"\x00" * (align(index_end) - index_end) + blobs
+    size = struct.calcsize(HEADER_FORMAT) + len(body)
+    header = struct.pack(HEADER_FORMAT, ASSET_PACK_MAGIC, ASSET_PACK_VERSION, len(names), size, fnv1a(body))
+    return header + body
+
+
+def list_pack(pack):
+    magic, version, count, size, checksum = struct.unpack_from(HEADER_FORMAT, pack)
+    if magic != ASSET_PACK_MAGIC or version != ASSET_PACK_VERSION:
+        print("not an asset pack (or a different version)")
+        return
+    body = pack[struct.calcsize(HEADER_FORMAT):size]
+    print("%d assets, %d of %d bytes, checksum %s" % (count, size, ASSET_REGION_SIZE,
+          "ok" if fnv1a(body) == checksum else "BAD"))
+    for i in range(count):
+        name, offset, length = struct.unpack_from(ENTRY_FORMAT, pack, struct.calcsize(HEADER_FORMAT) + i * struct.calcsize(ENTRY_FORMAT))
+        print("%-15s %6d bytes at %d" % (name.rstrip(b"\x00").decode("ascii"), length, offset))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build a Movement asset pack.")
+    parser.add_argument("assets", metavar="[NAME=]FILE", nargs="*", help="files to put in the pack")
+    parser.add_argument("-o", "--output", metavar="FILE", help="write the pack as a UF2 file for the asset region")
+    parser.add_argument("-b", "--binary", metavar="FILE", help="write the raw pack as well, e.g. to inspect it")
+    parser.add_argument("-l", "--list", metavar="FILE", help="list the contents of an existing pack (raw or UF2) and exit")
+    args = parser.parse_args()
+
+    if args.list:
+        with open(args.list, "rb") as f:
+            pack = f.read()
+        if uf2conv.is_uf2(pack):
+            pack = uf2conv.convert_from_uf2(pack)
+        list_pack(pack)
+        return
+
+    if not args.assets or not (args.output or args.binary):
+        parser.error("give at least one asset, and -o and/or -b")
+
+    assets = {}
+    for spec in args.assets:
+        if "=" in spec:
+            name, path = spec.split("=", 1)
+        else:
+            path = spec
+            name = os.path.splitext(os.path.basename(path))[0]
+        try:
+            encoded = name.encode("ascii")
+        except UnicodeEncodeError:
+            parser.error("asset name %r must be ASCII" % name)
+        if not encoded or len(encoded) >= ASSET_NAME_LENGTH:
+            parser.error("asset name %r must be 1 to %d characters long" % (name, ASSET_NAME_LENGTH - 1))
+        if name in assets:
+            parser.error("more than one asset is named %r" % name)
+        with open(path, "rb") as f:
+            assets[name] = f.read()
+
+    pack = build_pack(assets)
+    if len(pack) > ASSET_REGION_SIZE:
+        sys.exit("the pack is %d bytes, but the asset region only holds %d" % (len(pack), ASSET_REGION_SIZE))
+
+    if args.binary:
+        with open(args.binary, "wb") as f:
+            f.write(pack)
+    if args.output:
+        # same family ID as the firmware build (none), just a different base address.
+        uf2conv.appstartaddr = ASSET_REGION_START
+        with open(args.output, "wb") as f:
+            f.write(uf2conv.convert_to_uf2(pack))
+    print("packed %d assets in %d of %d bytes" % (len(assets), len(pack), ASSET_REGION_SIZE))
+
+
+if __name__ == "__main__":
+    main()
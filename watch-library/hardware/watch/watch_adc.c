@@ -25,20 +25,119 @@
 #include "watch_adc.h"
 #include "driver_init.h"
 
+// the reference the user asked for, and the reference the ADC is actually configured with. watch_get_vcc_voltage
+// borrows INTREF without changing the requested reference; we only switch back when a pin is next measured, so
+// repeated battery checks don't pay for two reference changes (and two throwaway conversions) every time.
+static watch_adc_reference_voltage _requested_reference;
+static watch_adc_reference_voltage _active_reference;
+static bool _reference_needs_settling;
+
+static volatile bool _conversion_in_progress;
+static volatile uint16_t _conversion_result;
+static watch_adc_cb_t _conversion_callback;
+
 static void _watch_sync_adc(void) {
     while (ADC->SYNCBUSY.reg);
 }
 
-static uint16_t _watch_get_analog_value(uint16_t channel) {
+static inline uint32_t _watch_adc_get_reference_voltage(const watch_adc_reference_voltage reference) {
+    switch (reference) {
+        case ADC_REFERENCE_INTREF:
+            return ADC_REFCTRL_REFSEL_INTREF_Val;
+            break;
+        case ADC_REFERENCE_VCC_DIV1POINT6:
+            return ADC_REFCTRL_REFSEL_INTVCC0_Val;
+            break;
+        case ADC_REFERENCE_VCC_DIV2:
+            return ADC_REFCTRL_REFSEL_INTVCC1_Val;
+            break;
+        case ADC_REFERENCE_VCC:
+            return ADC_REFCTRL_REFSEL_INTVCC2_Val;
+            break;
+    }
+
+    return 0;
+}
+
+static int16_t _watch_adc_get_channel(const uint8_t pin) {
+    switch (pin) {
+        case A0:
+            return ADC_INPUTCTRL_MUXPOS_AIN12_Val;
+        case A1:
+            return ADC_INPUTCTRL_MUXPOS_AIN9_Val;
+        case A2:
+            return ADC_INPUTCTRL_MUXPOS_AIN10_Val;
+        case A3:
+            return ADC_INPUTCTRL_MUXPOS_AIN11_Val;
+        case A4:
+            return ADC_INPUTCTRL_MUXPOS_AIN8_Val;
+        default:
+            return -1;
+    }
+}
+
+static void _watch_start_conversion(uint16_t channel) {
     if (ADC->INPUTCTRL.bit.MUXPOS != channel) {
         ADC->INPUTCTRL.bit.MUXPOS = channel;
         _watch_sync_adc();
     }
 
+    _conversion_in_progress = true;
     ADC->SWTRIG.bit.START = 1;
-    while (!ADC->INTFLAG.bit.RESRDY); // wait for "result ready" flag
+}
+
+static void _watch_wait_for_conversion(void) {
+    // idle sleep stops the CPU but keeps GCLK0 (and thus the ADC) running; RESRDY wakes us.
+    // interrupts are masked while we check the flag so the result can't sneak in between the
+    // check and the WFI; a pending interrupt still wakes the core, and we service it on unmask.
+    __disable_irq();
+    while (_conversion_in_progress) {
+        sleep(2);
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+
+static uint16_t _watch_get_analog_value(uint16_t channel) {
+    _watch_start_conversion(channel);
+    _watch_wait_for_conversion();
+
+    return _conversion_result;
+}
+
+static void _watch_adc_apply_reference(watch_adc_reference_voltage reference) {
+    if (reference != _active_reference) {
+        ADC->CTRLA.bit.ENABLE = 0;
+        _watch_sync_adc();
+
+        if (reference == ADC_REFERENCE_INTREF) SUPC->VREF.bit.VREFOE = 1;
+        else SUPC->VREF.bit.VREFOE = 0;
 
-    return ADC->RESULT.reg;
+        ADC->REFCTRL.bit.REFSEL = _watch_adc_get_reference_voltage(reference);
+        ADC->CTRLA.bit.ENABLE = 1;
+        _watch_sync_adc();
+        _active_reference = reference;
+        _reference_needs_settling = true;
+    }
+
+    if (_reference_needs_settling) {
+        // throw away one measurement after reference change (the channel doesn't matter).
+        _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDCOREVCC);
+        _reference_needs_settling = false;
+    }
+}
+
+void ADC_Handler(void) {
+    // reading RESULT clears the RESRDY flag.
+    _conversion_result = ADC->RESULT.reg;
+    _conversion_in_progress = false;
+
+    if (_conversion_callback != NULL) {
+        watch_adc_cb_t callback = _conversion_callback;
+        _conversion_callback = NULL;
+        callback(_conversion_result);
+    }
 }
 
 void watch_enable_adc(void) {
@@ -75,8 +174,17 @@ void watch_enable_adc(void) {
     ADC->INTENSET.reg = ADC_INTENSET_RESRDY;
     ADC->CTRLA.bit.ENABLE = 1;
     _watch_sync_adc();
-    // throw away one measurement after reference change (the channel doesn't matter).
-    _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDCOREVCC);
+
+    _conversion_in_progress = false;
+    _conversion_callback = NULL;
+    NVIC_ClearPendingIRQ(ADC_IRQn);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    // the first conversion after a reference change has to be thrown away, but there's no sense in doing that
+    // here: if the first thing we measure is VCC, the reference will change again anyway. Defer it until then.
+    _requested_reference = ADC_REFERENCE_VCC;
+    _active_reference = ADC_REFERENCE_VCC;
+    _reference_needs_settling = true;
 }
 
 void watch_enable_analog_input(const uint8_t pin) {
@@ -103,20 +211,29 @@ void watch_enable_analog_input(const uint8_t pin) {
 }
 
 uint16_t watch_get_analog_pin_level(const uint8_t pin) {
-    switch (pin) {
-        case A0:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN12_Val);
-        case A1:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN9_Val);
-        case A2:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN10_Val);
-        case A3:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN11_Val);
-        case A4:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN8_Val);
-        default:
-            return 0;
-    }
+    int16_t channel = _watch_adc_get_channel(pin);
+    if (channel < 0) return 0;
+
+    _watch_adc_apply_reference(_requested_reference);
+
+    return _watch_get_analog_value(channel);
+}
+
+bool watch_start_analog_pin_conversion(const uint8_t pin, uint16_t samples, watch_adc_cb_t callback) {
+    int16_t channel = _watch_adc_get_channel(pin);
+    if (channel < 0 || _conversion_in_progress) return false;
+
+    if (samples) watch_set_analog_num_samples(samples);
+    _watch_adc_apply_reference(_requested_reference);
+
+    _conversion_callback = callback;
+    _watch_start_conversion(channel);
+
+    return true;
+}
+
+bool watch_is_analog_conversion_in_progress(void) {
+    return _conversion_in_progress;
 }
 
 void watch_set_analog_num_samples(uint16_t samples) {
@@ -125,7 +242,7 @@ void watch_set_analog_num_samples(uint16_t samples) {
     // if only one bit is set, counting the trailing zeroes is equivalent to log2(samples)
     uint8_t sample_val = __builtin_ctz(samples);
     // make sure the desired value is within range and set it, if so.
-    if (sample_val <= ADC_AVGCTRL_SAMPLENUM_1024_Val) {
+    if (sample_val <= ADC_AVGCTRL_SAMPLENUM_1024_Val && sample_val != ADC->AVGCTRL.bit.SAMPLENUM) {
         ADC->AVGCTRL.bit.SAMPLENUM = sample_val;
         _watch_sync_adc();
     }
@@ -139,51 +256,18 @@ void watch_set_analog_sampling_length(uint8_t cycles) {
     _watch_sync_adc();
 }
 
-static inline uint32_t _watch_adc_get_reference_voltage(const watch_adc_reference_voltage reference) {
-    switch (reference) {
-        case ADC_REFERENCE_INTREF:
-            return ADC_REFCTRL_REFSEL_INTREF_Val;
-            break;
-        case ADC_REFERENCE_VCC_DIV1POINT6:
-            return ADC_REFCTRL_REFSEL_INTVCC0_Val;
-            break;
-        case ADC_REFERENCE_VCC_DIV2:
-            return ADC_REFCTRL_REFSEL_INTVCC1_Val;
-            break;
-        case ADC_REFERENCE_VCC:
-            return ADC_REFCTRL_REFSEL_INTVCC2_Val;
-            break;
-    }
-
-    return 0;
-}
-
 void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference) {
-    ADC->CTRLA.bit.ENABLE = 0;
-
-    if (reference == ADC_REFERENCE_INTREF) SUPC->VREF.bit.VREFOE = 1;
-    else SUPC->VREF.bit.VREFOE = 0;
-
-    ADC->REFCTRL.bit.REFSEL = _watch_adc_get_reference_voltage(reference);
-    ADC->CTRLA.bit.ENABLE = 1;
-    _watch_sync_adc();
-    // throw away one measurement after reference change (the channel doesn't matter).
-    _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDCOREVCC);
+    _requested_reference = reference;
+    _watch_adc_apply_reference(reference);
 }
 
 uint16_t watch_get_vcc_voltage(void) {
-    // stash the previous reference so we can restore it when we're done.
-    uint8_t oldref = ADC->REFCTRL.bit.REFSEL;
-
-    // if we weren't already using the internal reference voltage, select it now.
-    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(ADC_REFERENCE_INTREF);
+    // measure against INTREF; the requested reference is restored lazily, the next time a pin is read.
+    _watch_adc_apply_reference(ADC_REFERENCE_INTREF);
 
     // get the data
     uint32_t raw_val = _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val);
 
-    // restore the old reference, if needed.
-    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(oldref);
-
     return (uint16_t)((raw_val * 1000) / (1024 * 1 << ADC->AVGCTRL.bit.SAMPLENUM));
 }
 
@@ -192,8 +276,14 @@ inline void watch_disable_analog_input(const uint8_t pin) {
 }
 
 inline void watch_disable_adc(void) {
+    NVIC_DisableIRQ(ADC_IRQn);
+    _conversion_in_progress = false;
+    _conversion_callback = NULL;
+
     ADC->CTRLA.bit.ENABLE = 0;
     _watch_sync_adc();
+    // watch_get_vcc_voltage leaves INTREF selected; don't keep its output buffer running once we're done.
+    SUPC->VREF.bit.VREFOE = 0;
 
     MCLK->APBCMASK.reg &= ~MCLK_APBCMASK_ADC;
 }
@@ -184,6 +184,7 @@ void watch_enter_deep_sleep_mode(void) {
 
 void watch_enter_backup_mode(void) {
     watch_rtc_disable_all_periodic_callbacks();
+    watch_timer_stop_all();
     _watch_disable_all_peripherals_except_slcd();
     slcd_sync_deinit(&SEGMENT_LCD_0);
     hri_mclk_clear_APBCMASK_SLCD_bit(SLCD);
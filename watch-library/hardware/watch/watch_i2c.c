@@ -24,51 +24,275 @@
 
 #include "watch_i2c.h"
 
+#define WATCH_I2C_CMD_READ 2
+#define WATCH_I2C_CMD_STOP 3
+
 struct io_descriptor *I2C_0_io;
 
+typedef enum {
+    WATCH_I2C_PHASE_ADDRESS = 0,    // waiting for the device to acknowledge its write address
+    WATCH_I2C_PHASE_REGISTER,       // waiting for the device to acknowledge the register address
+    WATCH_I2C_PHASE_DATA,           // moving data bytes
+} watch_i2c_phase_t;
+
+typedef struct {
+    uint8_t addr;
+    uint8_t reg;
+    bool raw;       // no register address: a plain write or read, as watch_i2c_send and watch_i2c_receive do.
+    bool read;
+    uint8_t *buf;
+    uint16_t length;
+    watch_i2c_cb_t callback;
+    void *context;
+} watch_i2c_transaction_t;
+
+// transactions are queued in a small ring buffer and run back to back from the SERCOM interrupt.
+static watch_i2c_transaction_t _i2c_queue[WATCH_I2C_QUEUE_LENGTH];
+static volatile uint8_t _i2c_queue_head;
+static volatile uint8_t _i2c_queue_count;
+static volatile watch_i2c_phase_t _i2c_phase;
+static volatile uint16_t _i2c_position;
+
+static void _watch_i2c_sync(void) {
+    hri_sercomi2cm_wait_for_sync(SERCOM1, SERCOM_I2CM_SYNCBUSY_SYSOP);
+}
+
+static void _watch_i2c_start_transaction(void) {
+    watch_i2c_transaction_t *transaction = &_i2c_queue[_i2c_queue_head];
+
+    _i2c_phase = transaction->raw ? WATCH_I2C_PHASE_DATA : WATCH_I2C_PHASE_ADDRESS;
+    _i2c_position = 0;
+
+    // smart mode: reading DATA acknowledges the byte and starts the next one.
+    hri_sercomi2cm_set_CTRLB_SMEN_bit(SERCOM1);
+    hri_sercomi2cm_clear_CTRLB_ACKACT_bit(SERCOM1);
+    _watch_i2c_sync();
+
+    // register transactions begin by writing the register address, even reads; raw ones go straight to the data.
+    bool read_now = transaction->raw && transaction->read;
+    hri_sercomi2cm_write_ADDR_reg(SERCOM1, (transaction->addr << 1) | read_now | (hri_sercomi2cm_read_ADDR_reg(SERCOM1) & SERCOM_I2CM_ADDR_HS));
+}
+
+static void _watch_i2c_finish_transaction(watch_i2c_status_t status) {
+    watch_i2c_transaction_t transaction = _i2c_queue[_i2c_queue_head];
+
+    _i2c_queue_head = (_i2c_queue_head + 1) % WATCH_I2C_QUEUE_LENGTH;
+    _i2c_queue_count--;
+
+    if (_i2c_queue_count) {
+        _watch_i2c_start_transaction();
+    } else {
+        // nothing to do until the next transaction is queued.
+        hri_sercomi2cm_clear_INTEN_reg(SERCOM1, SERCOM_I2CM_INTENCLR_MB | SERCOM_I2CM_INTENCLR_SB | SERCOM_I2CM_INTENCLR_ERROR);
+    }
+
+    if (transaction.callback != NULL) transaction.callback(status, transaction.context);
+}
+
+static void _watch_i2c_stop(void) {
+    hri_sercomi2cm_clear_CTRLB_SMEN_bit(SERCOM1);
+    hri_sercomi2cm_write_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+    _watch_i2c_sync();
+}
+
+void SERCOM1_Handler(void) {
+    watch_i2c_transaction_t *transaction = &_i2c_queue[_i2c_queue_head];
+    uint8_t flags = hri_sercomi2cm_read_INTFLAG_reg(SERCOM1);
+    uint16_t status = hri_sercomi2cm_read_STATUS_reg(SERCOM1);
+
+    if (_i2c_queue_count == 0) {
+        hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, flags);
+        return;
+    }
+
+    if ((flags & SERCOM_I2CM_INTFLAG_ERROR) || (status & (SERCOM_I2CM_STATUS_ARBLOST | SERCOM_I2CM_STATUS_BUSERR))) {
+        hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, flags);
+        _watch_i2c_stop();
+        _watch_i2c_finish_transaction(WATCH_I2C_STATUS_BUS_ERROR);
+        return;
+    }
+
+    if (flags & SERCOM_I2CM_INTFLAG_MB) {
+        if (status & SERCOM_I2CM_STATUS_RXNACK) {
+            hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_MB);
+            _watch_i2c_stop();
+            _watch_i2c_finish_transaction(WATCH_I2C_STATUS_NACK);
+            return;
+        }
+
+        switch (_i2c_phase) {
+            case WATCH_I2C_PHASE_ADDRESS:
+                _i2c_phase = WATCH_I2C_PHASE_REGISTER;
+                hri_sercomi2cm_write_DATA_reg(SERCOM1, transaction->reg);
+                break;
+            case WATCH_I2C_PHASE_REGISTER:
+                _i2c_phase = WATCH_I2C_PHASE_DATA;
+                if (transaction->read) {
+                    // repeated start with the read address; bytes arrive via the SB flag.
+                    hri_sercomi2cm_write_ADDR_reg(SERCOM1, (transaction->addr << 1) | 1 | (hri_sercomi2cm_read_ADDR_reg(SERCOM1) & SERCOM_I2CM_ADDR_HS));
+                    break;
+                }
+                // a write continues straight into its payload.
+                // fall through
+            case WATCH_I2C_PHASE_DATA:
+                if (_i2c_position < transaction->length) {
+                    hri_sercomi2cm_write_DATA_reg(SERCOM1, transaction->buf[_i2c_position++]);
+                } else {
+                    hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_MB);
+                    _watch_i2c_stop();
+                    _watch_i2c_finish_transaction(WATCH_I2C_STATUS_OK);
+                }
+                break;
+        }
+    } else if (flags & SERCOM_I2CM_INTFLAG_SB) {
+        if (_i2c_position + 1 >= transaction->length) {
+            // last byte: NACK it and release the bus, then collect it.
+            hri_sercomi2cm_set_CTRLB_ACKACT_bit(SERCOM1);
+            _watch_i2c_stop();
+            transaction->buf[_i2c_position++] = hri_sercomi2cm_read_DATA_reg(SERCOM1);
+            hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_SB);
+            _watch_i2c_finish_transaction(WATCH_I2C_STATUS_OK);
+        } else {
+            // in smart mode, this read ACKs the byte and clocks in the next one.
+            transaction->buf[_i2c_position++] = hri_sercomi2cm_read_DATA_reg(SERCOM1);
+        }
+    }
+}
+
+static bool _watch_i2c_enqueue(int16_t addr, uint8_t reg, bool raw, bool read, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    if (length == 0 && read) return false;
+
+    bool queued = false;
+
+    CRITICAL_SECTION_ENTER()
+    if (_i2c_queue_count < WATCH_I2C_QUEUE_LENGTH) {
+        watch_i2c_transaction_t *transaction = &_i2c_queue[(_i2c_queue_head + _i2c_queue_count) % WATCH_I2C_QUEUE_LENGTH];
+        transaction->addr = addr;
+        transaction->reg = reg;
+        transaction->raw = raw;
+        transaction->read = read;
+        transaction->buf = buf;
+        transaction->length = length;
+        transaction->callback = callback;
+        transaction->context = context;
+
+        if (_i2c_queue_count++ == 0) {
+            hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_MB | SERCOM_I2CM_INTFLAG_SB | SERCOM_I2CM_INTFLAG_ERROR);
+            hri_sercomi2cm_set_INTEN_reg(SERCOM1, SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_SB | SERCOM_I2CM_INTENSET_ERROR);
+            _watch_i2c_start_transaction();
+        }
+        queued = true;
+    }
+    CRITICAL_SECTION_LEAVE()
+
+    return queued;
+}
+
 void watch_enable_i2c(void) {
     I2C_0_init();
     i2c_m_sync_get_io_descriptor(&I2C_0, &I2C_0_io);
     i2c_m_sync_enable(&I2C_0);
+
+    _i2c_queue_head = 0;
+    _i2c_queue_count = 0;
+    NVIC_ClearPendingIRQ(SERCOM1_IRQn);
+    NVIC_EnableIRQ(SERCOM1_IRQn);
 }
 
 void watch_disable_i2c(void) {
+    watch_i2c_wait_for_idle();
+    NVIC_DisableIRQ(SERCOM1_IRQn);
+
     i2c_m_sync_disable(&I2C_0);
 	hri_mclk_clear_APBCMASK_SERCOM1_bit(MCLK);
 }
 
+bool watch_i2c_queue_read(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    return _watch_i2c_enqueue(addr, reg, false, true, buf, length, callback, context);
+}
+
+bool watch_i2c_queue_write(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    return _watch_i2c_enqueue(addr, reg, false, false, buf, length, callback, context);
+}
+
+bool watch_i2c_is_busy(void) {
+    return _i2c_queue_count != 0;
+}
+
+void watch_i2c_wait_for_idle(void) {
+    // the SERCOM keeps running in idle sleep, and each byte raises an interrupt that wakes us back up.
+    __disable_irq();
+    while (_i2c_queue_count) {
+        sleep(2);
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+
+typedef struct {
+    volatile bool done;
+    volatile watch_i2c_status_t status;
+} watch_i2c_blocking_t;
+
+static void _watch_i2c_blocking_callback(watch_i2c_status_t status, void *context) {
+    watch_i2c_blocking_t *blocking = (watch_i2c_blocking_t *)context;
+    blocking->status = status;
+    blocking->done = true;
+}
+
+// the blocking calls go through the queue too, so the bus only ever has one owner: an interrupt that queues
+// work while we wait (like a sensor's FIFO drain) just gets in line behind us, and never starts a transfer
+// on a bus that's mid-transaction. we wait for our own transaction, not for the queue to empty.
+static watch_i2c_status_t _watch_i2c_run(int16_t addr, uint8_t reg, bool raw, bool read, uint8_t *buf, uint16_t length) {
+    watch_i2c_blocking_t blocking = { false, WATCH_I2C_STATUS_BUS_ERROR };
+
+    if (!_watch_i2c_enqueue(addr, reg, raw, read, buf, length, _watch_i2c_blocking_callback, &blocking)) {
+        // the queue is full; let it drain and try once more.
+        watch_i2c_wait_for_idle();
+        if (!_watch_i2c_enqueue(addr, reg, raw, read, buf, length, _watch_i2c_blocking_callback, &blocking)) return WATCH_I2C_STATUS_BUS_ERROR;
+    }
+
+    // the SERCOM keeps running in idle sleep, and each byte raises an interrupt that wakes us back up.
+    __disable_irq();
+    while (!blocking.done) {
+        sleep(2);
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+
+    return blocking.status;
+}
+
+watch_i2c_status_t watch_i2c_read_burst(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length) {
+    return _watch_i2c_run(addr, reg, false, true, buf, length);
+}
+
 void watch_i2c_send(int16_t addr, uint8_t *buf, uint16_t length) {
-    i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
-    io_write(I2C_0_io, buf, length);
+    _watch_i2c_run(addr, 0, true, false, buf, length);
 }
 
 void watch_i2c_receive(int16_t addr, uint8_t *buf, uint16_t length) {
-    i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
-    io_read(I2C_0_io, buf, length);
+    _watch_i2c_run(addr, 0, true, true, buf, length);
 }
 
 void watch_i2c_write8(int16_t addr, uint8_t reg, uint8_t data) {
-    uint8_t buf[2];
-    buf[0] = reg;
-    buf[1] = data;
-
-    watch_i2c_send(addr, (uint8_t *)&buf, 2);
+    _watch_i2c_run(addr, reg, false, false, &data, 1);
 }
 
 uint8_t watch_i2c_read8(int16_t addr, uint8_t reg) {
-    uint8_t data;
+    uint8_t data = 0;
 
-    watch_i2c_send(addr, (uint8_t *)&reg, 1);
-    watch_i2c_receive(addr, (uint8_t *)&data, 1);
+    _watch_i2c_run(addr, reg, false, true, (uint8_t *)&data, 1);
 
     return data;
 }
 
 uint16_t watch_i2c_read16(int16_t addr, uint8_t reg) {
-    uint16_t data;
+    uint16_t data = 0;
 
-    watch_i2c_send(addr, (uint8_t *)&reg, 1);
-    watch_i2c_receive(addr, (uint8_t *)&data, 2);
+    _watch_i2c_run(addr, reg, false, true, (uint8_t *)&data, 2);
 
     return data;
 }
@@ -77,17 +301,15 @@ uint32_t watch_i2c_read24(int16_t addr, uint8_t reg) {
     uint32_t data;
     data = 0;
 
-    watch_i2c_send(addr, (uint8_t *)&reg, 1);
-    watch_i2c_receive(addr, (uint8_t *)&data, 3);
+    _watch_i2c_run(addr, reg, false, true, (uint8_t *)&data, 3);
 
     return data << 8;
 }
 
 uint32_t watch_i2c_read32(int16_t addr, uint8_t reg) {
-    uint32_t data;
+    uint32_t data = 0;
 
-    watch_i2c_send(addr, (uint8_t *)&reg, 1);
-    watch_i2c_receive(addr, (uint8_t *)&data, 4);
+    _watch_i2c_run(addr, reg, false, true, (uint8_t *)&data, 4);
 
     return data;
 }
@@ -22,7 +22,10 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "watch_slcd.h"
+#include "watch_rtc.h"
+#include "watch_timer.h"
 #include "watch_private_display.h"
 #include "hpl_slcd_config.h"
 
@@ -33,25 +36,162 @@ static void _sync_slcd(void) {
     while (SLCD->SYNCBUSY.reg);
 }
 
+// The most ISDATA words one frame of segment data can take: one per byte of segment data it touches, and at
+// most three bytes (segment pins 0-23) on each of the three commons.
+#define WATCH_SLCD_MAX_WORDS_PER_FRAME 9
+
+static watch_segments_t _animation_segments;
+static uint8_t _animation_num_frames;
+static uint32_t _animation_frame_duration;
+#ifdef WATCH_SLCD_USE_DMA
+// Segment animations are fed to the SLCD by DMA channel 0, one frame's worth of ISDATA words at a time.
+#define WATCH_SLCD_ANIMATION_CHANNEL 0
+static uint32_t _animation_data[WATCH_MAX_ANIMATION_FRAMES * WATCH_SLCD_MAX_WORDS_PER_FRAME];
+static uint32_t _animation_first_frame[WATCH_SLCD_MAX_WORDS_PER_FRAME];
+static uint8_t _animation_words_per_frame;
+// the frame size automated bit mapping is set up for, or 0 if it's off. changing it means disabling the SLCD.
+static uint8_t _animation_abm_words = 0;
+static bool _animation_running = false;
+#else
+// Without the DMA path, segment animations are stepped by a software timer.
+static watch_timer_t _animation_timer;
+static watch_segments_t _animation_frames[WATCH_MAX_ANIMATION_FRAMES];
+static uint8_t _animation_frame;
+#endif
+
+// While a frame is open, pixel writes land here; dirty marks the segments to write when it's committed.
+static bool _frame_open = false;
+static uint32_t _frame_data[3];
+static uint32_t _frame_dirty[3];
+
+#ifdef WATCH_SLCD_USE_DMA
+// The low energy seconds use DMA channels 1 (units) and 2 (tens), and event channels 0 and 1 to trigger them.
+#define WATCH_SLCD_SECONDS_UNITS_CHANNEL 1
+#define WATCH_SLCD_SECONDS_TENS_CHANNEL 2
+#define WATCH_SLCD_SECONDS_EVSYS_CHANNEL 0
+static uint32_t _lp_seconds_data[16][WATCH_SLCD_MAX_WORDS_PER_FRAME];
+static DmacDescriptor _lp_seconds_descriptors[16] __attribute__((aligned(16)));
+static bool _lp_seconds_running = false;
+
+// the DMAC reads each channel's first descriptor from this table, indexed by channel number.
+#define WATCH_SLCD_DMA_CHANNELS 3
+static DmacDescriptor _dmac_descriptors[WATCH_SLCD_DMA_CHANNELS] __attribute__((aligned(16)));
+static DmacDescriptor _dmac_writeback[WATCH_SLCD_DMA_CHANNELS] __attribute__((aligned(16)));
+
+static void _watch_enable_dmac(void) {
+    MCLK->AHBMASK.reg |= MCLK_AHBMASK_DMAC;
+    if (!DMAC->CTRL.bit.DMAENABLE) {
+        DMAC->BASEADDR.reg = (uint32_t)_dmac_descriptors;
+        DMAC->WRBADDR.reg = (uint32_t)_dmac_writeback;
+        DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN0;
+    }
+}
+
+static void _watch_disable_dma_channel(uint8_t channel) {
+    DMAC->CHID.reg = channel;
+    DMAC->CHCTRLA.reg = 0;
+    while (DMAC->CHCTRLA.bit.ENABLE);
+}
+
+static void _watch_halt_segment_animation(void) {
+    if (!_animation_running) return;
+    _watch_disable_dma_channel(WATCH_SLCD_ANIMATION_CHANNEL);
+
+    // ABMEN is enable-protected, so leave automated bit mapping on; with frame counter 2 stopped, it never asks for data.
+    SLCD->CTRLD.bit.FC2EN = 0;
+    _sync_slcd();
+
+    _animation_running = false;
+}
+
+static void _watch_halt_lp_seconds(void) {
+    if (!_lp_seconds_running) return;
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_1].reg = 0;
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_2].reg = 0;
+    EVSYS->CHANNEL[WATCH_SLCD_SECONDS_EVSYS_CHANNEL].reg = 0;
+    EVSYS->CHANNEL[WATCH_SLCD_SECONDS_EVSYS_CHANNEL + 1].reg = 0;
+    _watch_disable_dma_channel(WATCH_SLCD_SECONDS_UNITS_CHANNEL);
+    _watch_disable_dma_channel(WATCH_SLCD_SECONDS_TENS_CHANNEL);
+
+    _lp_seconds_running = false;
+}
+#else
+static void _watch_halt_segment_animation(void) {
+    watch_timer_stop(&_animation_timer);
+}
+#endif
+
 void watch_enable_display(void) {
+    // re-initializing the SLCD resets it, which ends any animation it was running.
+    _watch_halt_segment_animation();
+#ifdef WATCH_SLCD_USE_DMA
+    _watch_halt_lp_seconds();
+#endif
     SEGMENT_LCD_0_init();
+#ifdef WATCH_SLCD_USE_DMA
+    _animation_abm_words = 0;
+#endif
     slcd_sync_enable(&SEGMENT_LCD_0);
 }
 
 inline void watch_set_pixel(uint8_t com, uint8_t seg) {
+    if (_frame_open) {
+        _frame_data[com] |= 1ul << seg;
+        _frame_dirty[com] |= 1ul << seg;
+        return;
+    }
     slcd_sync_seg_on(&SEGMENT_LCD_0, SLCD_SEGID(com, seg));
 }
 
 inline void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    if (_frame_open) {
+        _frame_data[com] &= ~(1ul << seg);
+        _frame_dirty[com] |= 1ul << seg;
+        return;
+    }
     slcd_sync_seg_off(&SEGMENT_LCD_0, SLCD_SEGID(com, seg));
 }
 
+bool watch_get_pixel(uint8_t com, uint8_t seg) {
+    if (_frame_open && (_frame_dirty[com] & (1ul << seg))) return _frame_data[com] & (1ul << seg);
+    return ((uint32_t *)&SLCD->SDATAL0.reg)[com * 2 + (seg >> 5)] & (1ul << (seg & 0x1F));
+}
+
 void watch_clear_display(void) {
+    if (_frame_open) {
+        memset(_frame_data, 0, sizeof(_frame_data));
+        memset(_frame_dirty, 0xFF, sizeof(_frame_dirty));
+        return;
+    }
     SLCD->SDATAL0.reg = 0;
     SLCD->SDATAL1.reg = 0;
     SLCD->SDATAL2.reg = 0;
 }
 
+// with the shadow memory locked, the display keeps showing the last frame until we've written all three commons.
+static void _watch_write_segment_data(const uint32_t data[3], const uint32_t mask[3]) {
+    SLCD->CTRLC.bit.LOCK = 1;
+    SLCD->SDATAL0.reg = (SLCD->SDATAL0.reg & ~mask[0]) | (data[0] & mask[0]);
+    SLCD->SDATAL1.reg = (SLCD->SDATAL1.reg & ~mask[1]) | (data[1] & mask[1]);
+    SLCD->SDATAL2.reg = (SLCD->SDATAL2.reg & ~mask[2]) | (data[2] & mask[2]);
+    SLCD->CTRLC.bit.LOCK = 0;
+}
+
+void watch_set_segments(watch_segments_t segments, watch_segments_t lit) {
+    _watch_write_segment_data(lit.com, segments.com);
+}
+
+void watch_begin_display_frame(void) {
+    memset(_frame_dirty, 0, sizeof(_frame_dirty));
+    _frame_open = true;
+}
+
+void watch_commit_display_frame(void) {
+    if (!_frame_open) return;
+    _frame_open = false;
+    _watch_write_segment_data(_frame_data, _frame_dirty);
+}
+
 void watch_start_character_blink(char character, uint32_t duration) {
     SLCD->CTRLD.bit.FC0EN = 0;
     _sync_slcd();
@@ -99,3 +239,256 @@ void watch_stop_tick_animation(void) {
     slcd_sync_stop_animation(&SEGMENT_LCD_0, segs, 1);
     watch_display_character(' ', 8);
 }
+
+static bool _watch_segment_animation_matches(watch_segments_t segments, uint8_t num_frames, uint32_t frame_duration) {
+    return watch_segment_animation_is_running() &&
+           !memcmp(&segments, &_animation_segments, sizeof(watch_segments_t)) &&
+           num_frames == _animation_num_frames &&
+           frame_duration == _animation_frame_duration;
+}
+
+#ifdef WATCH_SLCD_USE_DMA
+// one ISDATA write for each byte of segment data the animation touches, in every frame, packed frame by frame.
+// bits set in SDMASK protect a segment, so only the segments in the set are ever written. each word is written
+// whole, so a DMA transfer that reads the data while we rewrite it gets either the old word or the new one.
+static uint8_t _watch_build_animation_data(watch_segments_t segments, const watch_segments_t frames[], uint8_t num_frames) {
+    uint8_t words = 0;
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t byte = 0; byte < 3; byte++) {
+            if ((segments.com[com] >> (byte * 8)) & 0xFF) words++;
+        }
+    }
+
+    uint8_t word = 0;
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t byte = 0; byte < 3; byte++) {
+            uint8_t mask = (segments.com[com] >> (byte * 8)) & 0xFF;
+            if (!mask) continue;
+            for (uint8_t frame = 0; frame < num_frames; frame++) {
+                uint8_t data = (frames[frame].com[com] >> (byte * 8)) & mask;
+                _animation_data[frame * words + word] = SLCD_ISDATA_OFF(com * 8 + byte) | SLCD_ISDATA_SDMASK(~mask) | SLCD_ISDATA_SDATA(data);
+            }
+            word++;
+        }
+    }
+
+    // keep the first frame around to restore when we stop.
+    memcpy(_animation_first_frame, _animation_data, words * sizeof(uint32_t));
+    return words;
+}
+
+void watch_start_segment_animation(watch_segments_t segments, const watch_segments_t frames[], uint8_t num_frames, uint32_t frame_duration) {
+    if (num_frames == 0 || num_frames > WATCH_MAX_ANIMATION_FRAMES) {
+        _watch_halt_segment_animation();
+        return;
+    }
+    if (frame_duration < SLCD_FC_MIN_MS) frame_duration = SLCD_FC_MIN_MS;
+    if (frame_duration > SLCD_FC_MAX_MS) frame_duration = SLCD_FC_MAX_MS;
+
+    // the same animation with new frames (e.g. a blinking digit that changed): swap the data under the DMA
+    // and let it carry on, rather than stopping the controller and starting over.
+    if (_watch_segment_animation_matches(segments, num_frames, frame_duration)) {
+        _watch_build_animation_data(segments, frames, num_frames);
+        return;
+    }
+
+    _watch_halt_segment_animation();
+    uint8_t words = _watch_build_animation_data(segments, frames, num_frames);
+    if (!words) return;
+    _animation_words_per_frame = words;
+
+    // the descriptor points back at itself, so the DMA loops over the frames until we stop it.
+    _watch_enable_dmac();
+    DmacDescriptor *descriptor = &_dmac_descriptors[WATCH_SLCD_ANIMATION_CHANNEL];
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = words * num_frames;
+    // with SRCINC set, SRCADDR is the address just past the last beat.
+    descriptor->SRCADDR.reg = (uint32_t)&_animation_data[words * num_frames];
+    descriptor->DSTADDR.reg = (uint32_t)&SLCD->ISDATA.reg;
+    descriptor->DESCADDR.reg = (uint32_t)descriptor;
+
+    DMAC->CHID.reg = WATCH_SLCD_ANIMATION_CHANNEL;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+    while (DMAC->CHCTRLA.bit.SWRST);
+    DMAC->CHCTRLB.reg = DMAC_CHCTRLB_TRIGSRC(SLCD_DMAC_ID_ABMDRDY) | DMAC_CHCTRLB_TRIGACT_BEAT | DMAC_CHCTRLB_LVL(0);
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_RUNSTDBY | DMAC_CHCTRLA_ENABLE;
+
+    // frame counter 2 paces the frames; each overflow asks the DMA for one frame's worth of words.
+    if (frame_duration <= SLCD_FC_BYPASS_MAX_MS) {
+        SLCD->FC2.reg = SLCD_FC2_PB | ((frame_duration / (1000 / SLCD_FRAME_FREQUENCY)) - 1);
+    } else {
+        SLCD->FC2.reg = (((frame_duration / (1000 / SLCD_FRAME_FREQUENCY)) / 8 - 1));
+    }
+
+    // ABMCFG and ABMEN are enable-protected, so only disable the controller when the frame size changes.
+    if (words != _animation_abm_words) {
+        SLCD->CTRLA.bit.ENABLE = 0;
+        _sync_slcd();
+        SLCD->ABMCFG.reg = SLCD_ABMCFG_FCS_FC2 | SLCD_ABMCFG_SIZE(words);
+        SLCD->CTRLC.bit.ABMEN = 1;
+        SLCD->CTRLA.bit.ENABLE = 1;
+        _sync_slcd();
+        _animation_abm_words = words;
+    }
+    SLCD->CTRLD.bit.FC2EN = 1;
+    _sync_slcd();
+
+    _animation_segments = segments;
+    _animation_num_frames = num_frames;
+    _animation_frame_duration = frame_duration;
+    _animation_running = true;
+}
+
+bool watch_segment_animation_is_running(void) {
+    return _animation_running;
+}
+
+void watch_stop_segment_animation(void) {
+    if (!_animation_running) return;
+    _watch_halt_segment_animation();
+    // put the segments back the way the first frame draws them.
+    for (uint8_t i = 0; i < _animation_words_per_frame; i++) {
+        SLCD->ISDATA.reg = _animation_first_frame[i];
+    }
+}
+#else
+static void _watch_segment_animation_callback(void *context) {
+    (void) context;
+    _animation_frame = (_animation_frame + 1) % _animation_num_frames;
+    watch_set_segments(_animation_segments, _animation_frames[_animation_frame]);
+}
+
+void watch_start_segment_animation(watch_segments_t segments, const watch_segments_t frames[], uint8_t num_frames, uint32_t frame_duration) {
+    if (num_frames == 0 || num_frames > WATCH_MAX_ANIMATION_FRAMES) {
+        _watch_halt_segment_animation();
+        return;
+    }
+
+    // the same animation with new frames (e.g. a blinking digit that changed): swap them in and carry on from
+    // the frame we're on, drawing it again in case the caller just drew over it.
+    if (_watch_segment_animation_matches(segments, num_frames, frame_duration)) {
+        CRITICAL_SECTION_ENTER()
+        memcpy(_animation_frames, frames, num_frames * sizeof(watch_segments_t));
+        watch_set_segments(segments, _animation_frames[_animation_frame]);
+        CRITICAL_SECTION_LEAVE()
+        return;
+    }
+
+    _watch_halt_segment_animation();
+    memcpy(_animation_frames, frames, num_frames * sizeof(watch_segments_t));
+    _animation_segments = segments;
+    _animation_num_frames = num_frames;
+    _animation_frame_duration = frame_duration;
+    _animation_frame = 0;
+    watch_set_segments(segments, frames[0]);
+    watch_timer_start(&_animation_timer, WATCH_TIMER_MS(frame_duration), WATCH_TIMER_MS(frame_duration), _watch_segment_animation_callback, NULL);
+}
+
+bool watch_segment_animation_is_running(void) {
+    return watch_timer_is_running(&_animation_timer);
+}
+
+void watch_stop_segment_animation(void) {
+    if (!watch_segment_animation_is_running()) return;
+    _watch_halt_segment_animation();
+    // put the segments back the way the first frame draws them.
+    watch_set_segments(_animation_segments, _animation_frames[0]);
+}
+#endif
+
+#ifdef WATCH_SLCD_USE_DMA
+// builds the ISDATA words that draw each digit in a position, and a ring of descriptors that writes one digit per trigger.
+static void _watch_build_lp_seconds_ring(DmacDescriptor *ring, uint32_t (*data)[WATCH_SLCD_MAX_WORDS_PER_FRAME], uint8_t num_digits, uint8_t position, bool event_on_zero) {
+    watch_segments_t segments = {0};
+    watch_segments_add_position(&segments, position);
+
+    for (uint8_t digit = 0; digit < num_digits; digit++) {
+        watch_segments_t lit = {0};
+        watch_segments_add_character(&lit, '0' + digit, position);
+        uint8_t words = 0;
+        for (uint8_t com = 0; com < 3; com++) {
+            for (uint8_t byte = 0; byte < 3; byte++) {
+                uint8_t mask = (segments.com[com] >> (byte * 8)) & 0xFF;
+                if (!mask) continue;
+                uint8_t sdata = (lit.com[com] >> (byte * 8)) & mask;
+                data[digit][words++] = SLCD_ISDATA_OFF(com * 8 + byte) | SLCD_ISDATA_SDMASK(~mask) | SLCD_ISDATA_SDATA(sdata);
+            }
+        }
+
+        ring[digit].BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_SRCINC |
+                                 ((event_on_zero && digit == 0) ? DMAC_BTCTRL_EVOSEL_BLOCK : DMAC_BTCTRL_EVOSEL_DISABLE);
+        ring[digit].BTCNT.reg = words;
+        ring[digit].SRCADDR.reg = (uint32_t)&data[digit][words];
+        ring[digit].DSTADDR.reg = (uint32_t)&SLCD->ISDATA.reg;
+        ring[digit].DESCADDR.reg = (uint32_t)&ring[(digit + 1) % num_digits];
+    }
+}
+
+static void _watch_start_lp_seconds_channel(uint8_t channel, bool event_output) {
+    DMAC->CHID.reg = channel;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+    while (DMAC->CHCTRLA.bit.SWRST);
+    DMAC->CHCTRLB.reg = DMAC_CHCTRLB_TRIGSRC_DISABLE | DMAC_CHCTRLB_TRIGACT_BLOCK | DMAC_CHCTRLB_LVL(0) |
+                        DMAC_CHCTRLB_EVIE | DMAC_CHCTRLB_EVACT_TRIG | (event_output ? DMAC_CHCTRLB_EVOE : 0);
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_RUNSTDBY | DMAC_CHCTRLA_ENABLE;
+}
+
+void watch_start_lp_seconds(uint8_t second) {
+    _watch_halt_lp_seconds();
+    if (second > 59) return;
+
+    // ten descriptors for the units digit, where only the one that writes a 0 fires an event; and six for the tens.
+    _watch_build_lp_seconds_ring(&_lp_seconds_descriptors[0], &_lp_seconds_data[0], 10, 9, true);
+    _watch_build_lp_seconds_ring(&_lp_seconds_descriptors[10], &_lp_seconds_data[10], 6, 8, false);
+
+    // each channel starts from its table entry, so seed it with a copy of the descriptor for the next digit.
+    _watch_enable_dmac();
+    _dmac_descriptors[WATCH_SLCD_SECONDS_UNITS_CHANNEL] = _lp_seconds_descriptors[(second % 10 + 1) % 10];
+    _dmac_descriptors[WATCH_SLCD_SECONDS_TENS_CHANNEL] = _lp_seconds_descriptors[10 + (second / 10 + 1) % 6];
+    _watch_start_lp_seconds_channel(WATCH_SLCD_SECONDS_UNITS_CHANNEL, true);
+    _watch_start_lp_seconds_channel(WATCH_SLCD_SECONDS_TENS_CHANNEL, false);
+
+    // the RTC's 1 Hz event advances the units; the units channel's event advances the tens.
+    // EVCTRL is enable-protected, so only stop the RTC the first time through.
+    if (!RTC->MODE2.EVCTRL.bit.PEREO7) {
+        watch_rtc_enable(false);
+        RTC->MODE2.EVCTRL.reg |= RTC_MODE2_EVCTRL_PEREO7;
+        watch_rtc_enable(true);
+    }
+    MCLK->APBCMASK.reg |= MCLK_APBCMASK_EVSYS;
+    EVSYS->CHANNEL[WATCH_SLCD_SECONDS_EVSYS_CHANNEL].reg = EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_RTC_PER_7) |
+                                                           EVSYS_CHANNEL_PATH_ASYNCHRONOUS |
+                                                           EVSYS_CHANNEL_EDGSEL_NO_EVT_OUTPUT |
+                                                           EVSYS_CHANNEL_RUNSTDBY;
+    EVSYS->CHANNEL[WATCH_SLCD_SECONDS_EVSYS_CHANNEL + 1].reg = EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_DMAC_CH_1) |
+                                                               EVSYS_CHANNEL_PATH_ASYNCHRONOUS |
+                                                               EVSYS_CHANNEL_EDGSEL_NO_EVT_OUTPUT |
+                                                               EVSYS_CHANNEL_RUNSTDBY;
+    // user channel numbers are one-based; zero means no channel.
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_1].reg = EVSYS_USER_CHANNEL(WATCH_SLCD_SECONDS_EVSYS_CHANNEL + 1);
+    EVSYS->USER[EVSYS_ID_USER_DMAC_CH_2].reg = EVSYS_USER_CHANNEL(WATCH_SLCD_SECONDS_EVSYS_CHANNEL + 2);
+
+    _lp_seconds_running = true;
+}
+
+bool watch_lp_seconds_is_running(void) {
+    return _lp_seconds_running;
+}
+
+void watch_stop_lp_seconds(void) {
+    _watch_halt_lp_seconds();
+}
+#else
+// without the DMA path the display can't count on its own, so this never starts; callers check
+// watch_lp_seconds_is_running and draw what they would without it.
+void watch_start_lp_seconds(uint8_t second) {
+    (void) second;
+}
+
+bool watch_lp_seconds_is_running(void) {
+    return false;
+}
+
+void watch_stop_lp_seconds(void) {
+}
+#endif
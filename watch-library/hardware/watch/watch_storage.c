@@ -92,3 +92,11 @@ bool watch_storage_sync(void) {
 
     return true;
 }
+
+extern const uint8_t _sassets[];
+extern const uint8_t _eassets[];
+
+const uint8_t *watch_storage_get_assets(uint32_t *size) {
+    if (size != NULL) *size = _eassets - _sassets;
+    return _sassets;
+}
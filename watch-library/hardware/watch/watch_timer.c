@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "watch_timer.h"
+#include "../../../watch-library/hardware/include/saml22j18a.h"
+#include "../../../watch-library/hardware/include/component/tc.h"
+#include "../../../watch-library/hardware/hri/hri_tc_l22.h"
+
+// TC0 runs the USB task, and TC2 and TC3 are reserved for devices on the 9-pin connector, so the timer service
+// owns TC1. It counts GCLK3 (32 kHz) divided by 16 in 16-bit mode, and we extend that to 32 bits by counting
+// overflows, which come around every 32 seconds while any timer is pending.
+static volatile uint32_t _watch_timer_epoch;
+static bool _watch_timer_enabled = false;
+
+static uint16_t _watch_timer_read_count(void) {
+    hri_tc_set_CTRLB_CMD_bf(TC1, TC_CTRLBSET_CMD_READSYNC_Val);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_CTRLB);
+    return hri_tccount16_read_COUNT_reg(TC1);
+}
+
+void _watch_timer_counter_enable(void) {
+    if (_watch_timer_enabled) return;
+
+    hri_mclk_set_APBCMASK_TC1_bit(MCLK);
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC1_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3 | GCLK_PCHCTRL_CHEN);
+    hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_SWRST);
+    hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_PRESCALER_DIV16 | // 32 kHz divided by 16 is 2048 Hz
+                           TC_CTRLA_MODE_COUNT16 |
+                           TC_CTRLA_RUNSTDBY);
+    hri_tc_set_INTEN_OVF_bit(TC1);
+    _watch_timer_epoch = 0;
+    NVIC_ClearPendingIRQ(TC1_IRQn);
+    NVIC_EnableIRQ(TC1_IRQn);
+    hri_tc_set_CTRLA_ENABLE_bit(TC1);
+    _watch_timer_enabled = true;
+}
+
+void _watch_timer_counter_disable(void) {
+    if (!_watch_timer_enabled) return;
+
+    hri_tc_clear_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+    NVIC_DisableIRQ(TC1_IRQn);
+    NVIC_ClearPendingIRQ(TC1_IRQn);
+    // release the clock channel too, so nothing keeps GCLK3 requested in standby on our behalf.
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC1_GCLK_ID, 0);
+    hri_mclk_clear_APBCMASK_TC1_bit(MCLK);
+    _watch_timer_enabled = false;
+}
+
+uint32_t _watch_timer_counter_now(void) {
+    if (!_watch_timer_enabled) return 0;
+
+    uint16_t count = _watch_timer_read_count();
+    uint32_t epoch = _watch_timer_epoch;
+    if (hri_tc_get_INTFLAG_OVF_bit(TC1)) {
+        // the counter wrapped and the interrupt hasn't accounted for it yet; re-read so count and epoch agree.
+        count = _watch_timer_read_count();
+        epoch += 0x10000;
+    }
+
+    return epoch + count;
+}
+
+void _watch_timer_counter_arm(uint32_t deadline) {
+    int32_t remaining = (int32_t)(deadline - _watch_timer_counter_now());
+
+    if (remaining <= 0) {
+        NVIC_SetPendingIRQ(TC1_IRQn);
+        return;
+    }
+    if (remaining > 0xFFFF) {
+        // too far out for the compare register; the overflow interrupt will come back and arm it later.
+        hri_tc_clear_INTEN_MC0_bit(TC1);
+        return;
+    }
+
+    hri_tccount16_write_CC_reg(TC1, 0, (uint16_t)deadline);
+    hri_tc_clear_INTFLAG_MC0_bit(TC1);
+    hri_tc_set_INTEN_MC0_bit(TC1);
+    // CC0 takes a few slow clocks to sync; if the counter got there first, the match would be a full wrap late.
+    if ((int32_t)(deadline - _watch_timer_counter_now()) <= 0) NVIC_SetPendingIRQ(TC1_IRQn);
+}
+
+void TC1_Handler(void) {
+    if (hri_tc_get_INTFLAG_OVF_bit(TC1)) {
+        hri_tc_clear_INTFLAG_OVF_bit(TC1);
+        _watch_timer_epoch += 0x10000;
+    }
+    hri_tc_clear_INTFLAG_MC0_bit(TC1);
+    _watch_timer_service();
+}
@@ -0,0 +1,42 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HEADLESS_EMSCRIPTEN_H_
+#define HEADLESS_EMSCRIPTEN_H_
+
+/*
+ * The headless build compiles the simulator's code paths natively. This header stands in for
+ * emscripten.h: inline JavaScript compiles away (EM_ASM_INT and EM_ASM_DOUBLE evaluate to zero,
+ * which faces already treat as "no location" and movement treats as UTC), and the clock functions
+ * are backed by the replayer's virtual clock in watch/headless.c.
+ */
+
+#define EMSCRIPTEN_KEEPALIVE
+#define EM_ASM(...) ((void)0)
+#define EM_ASM_INT(...) (0)
+#define EM_ASM_DOUBLE(...) (0.0)
+
+double emscripten_get_now(void);
+
+#endif // HEADLESS_EMSCRIPTEN_H_
@@ -0,0 +1,322 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Headless replayer: runs the simulator build of the firmware natively against a trace recorded
+ * in the simulator (see simulator/watch/watch_trace.h), on a virtual clock, and prints what the
+ * watch did. Usage:
+ *
+ *     watch [--until MS] [TRACE]
+ *
+ * TRACE is a file, or - for standard input; without one, the watch simply runs. Output is one
+ * event per line, prefixed with virtual milliseconds: `frame <com0> <com1> <com2>` (the LCD segment
+ * bitmap, printed whenever it changes), `buzzer <period>`, `led <red> <green>`, and the recorded
+ * inputs as they are applied. Ticks and alarms are not replayed from the trace; the virtual RTC
+ * regenerates them, and the totals are compared at the end. Anything the firmware itself prints
+ * goes to standard error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "watch.h"
+#include "watch_main_loop.h"
+#include "headless.h"
+
+#define HEADLESS_SETTLE_MS 2000
+
+typedef enum {
+    TRACE_BUTTON,
+    TRACE_ADC,
+} trace_event_type_t;
+
+typedef struct {
+    double ms;
+    trace_event_type_t type;
+    uint8_t pin;
+    uint16_t value;
+} trace_event_t;
+
+static trace_event_t *events;
+static size_t event_count;
+static size_t next_event;
+
+static uint32_t *trng_words;
+static size_t trng_count;
+static size_t next_trng_word;
+
+// last ADC reading applied for each pin, plus one; zero means the trace has not set it yet.
+static uint32_t adc_values[256];
+
+static bool has_time;
+static watch_date_time start_time;
+static double trace_end_ms;
+static uint32_t recorded_ticks, recorded_alarms;
+static uint32_t replayed_ticks, replayed_alarms;
+
+static double end_ms;
+
+static bool frame_requested;
+static bool sleeping = true;
+static bool blocked;
+
+static void *_headless_grow(void *array, size_t count, size_t size) {
+    // capacity starts at 16 and doubles, so it only runs out when count reaches a power of two.
+    if (count != 0 && (count < 16 || (count & (count - 1)) != 0)) return array;
+    void *grown = realloc(array, (count < 16 ? 16 : count * 2) * size);
+    if (grown == NULL) {
+        fprintf(stderr, "headless: out of memory\n");
+        exit(1);
+    }
+    return grown;
+}
+
+static uint8_t _headless_button_pin(char name) {
+    switch (name) {
+        case 'L': return BTN_LIGHT;
+        case 'M': return BTN_MODE;
+        case 'A': return BTN_ALARM;
+        default: return 0xFF;
+    }
+}
+
+static bool _headless_load_trace(FILE *file) {
+    char line[128];
+    unsigned line_number = 0;
+
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+
+        double ms;
+        char kind[8];
+        int consumed;
+        if (sscanf(line, "%lf %7s %n", &ms, kind, &consumed) < 2) goto invalid;
+        const char *args = line + consumed;
+        if (ms > trace_end_ms) trace_end_ms = ms;
+
+        unsigned long a, b;
+        char name;
+        if (strcmp(kind, "time") == 0) {
+            if (sscanf(args, "%lx", &a) != 1) goto invalid;
+            if (!has_time) start_time.reg = a;
+            has_time = true;
+        } else if (strcmp(kind, "tick") == 0) {
+            recorded_ticks++;
+        } else if (strcmp(kind, "alarm") == 0) {
+            recorded_alarms++;
+        } else if (strcmp(kind, "trng") == 0) {
+            if (sscanf(args, "%lx", &a) != 1) goto invalid;
+            trng_words = _headless_grow(trng_words, trng_count, sizeof(uint32_t));
+            trng_words[trng_count++] = a;
+        } else {
+            trace_event_t event = { .ms = ms };
+            if (strcmp(kind, "btn") == 0) {
+                if (sscanf(args, "%c %lu", &name, &a) != 2 || _headless_button_pin(name) == 0xFF) goto invalid;
+                event.type = TRACE_BUTTON;
+                event.pin = _headless_button_pin(name);
+                event.value = a != 0;
+            } else if (strcmp(kind, "adc") == 0) {
+                if (sscanf(args, "%lu %lu", &a, &b) != 2 || a >= HEADLESS_ADC_VCC) goto invalid;
+                event.type = TRACE_ADC;
+                event.pin = a;
+                event.value = b;
+            } else if (strcmp(kind, "vcc") == 0) {
+                if (sscanf(args, "%lu", &a) != 1) goto invalid;
+                event.type = TRACE_ADC;
+                event.pin = HEADLESS_ADC_VCC;
+                event.value = a;
+            } else {
+                goto invalid;
+            }
+            // the recorder writes events in order, but keep the list sorted in case a trace was edited by hand.
+            events = _headless_grow(events, event_count, sizeof(trace_event_t));
+            size_t i = event_count++;
+            while (i > 0 && events[i - 1].ms > ms) {
+                events[i] = events[i - 1];
+                i--;
+            }
+            events[i] = event;
+        }
+        continue;
+
+invalid:
+        fprintf(stderr, "headless: trace line %u is not valid: %s", line_number, line);
+        return false;
+    }
+
+    return true;
+}
+
+static void _headless_apply_event(const trace_event_t *event) {
+    switch (event->type) {
+        case TRACE_BUTTON:
+            headless_log("btn %c %d", event->pin == BTN_LIGHT ? 'L' : event->pin == BTN_MODE ? 'M' : 'A', event->value);
+            headless_inject_button(event->pin, event->value);
+            break;
+        case TRACE_ADC:
+            adc_values[event->pin] = (uint32_t)event->value + 1;
+            break;
+    }
+}
+
+// advances virtual time, applying recorded inputs as their moments come.
+static void _headless_replay_to(double ms) {
+    while (next_event < event_count && events[next_event].ms <= ms) {
+        headless_advance_to(events[next_event].ms);
+        _headless_apply_event(&events[next_event++]);
+    }
+    headless_advance_to(ms);
+}
+
+// virtual time of the next timer or recorded input, or the end of the replay if there is neither.
+static double _headless_next_wake(void) {
+    double next_ms = headless_next_deadline();
+    if (next_event < event_count && (next_ms < 0 || events[next_event].ms < next_ms)) next_ms = events[next_event].ms;
+    return next_ms < 0 ? end_ms : next_ms;
+}
+
+void headless_wait_for_interrupt(void) {
+    double next_ms = _headless_next_wake();
+    if (next_ms >= end_ms) {
+        _headless_replay_to(end_ms);
+        headless_finish();
+    }
+    _headless_replay_to(next_ms);
+}
+
+void headless_finish(void) {
+    headless_flush_display();
+    headless_comment("replayed %lu ticks and %lu alarms; the trace recorded %lu and %lu",
+                     (unsigned long)replayed_ticks, (unsigned long)replayed_alarms,
+                     (unsigned long)recorded_ticks, (unsigned long)recorded_alarms);
+    fflush(NULL);
+    exit(0);
+}
+
+void headless_count_tick(void) {
+    if (headless_now() <= trace_end_ms) replayed_ticks++;
+}
+
+void headless_count_alarm(void) {
+    if (headless_now() <= trace_end_ms) replayed_alarms++;
+}
+
+uint16_t headless_adc_value(uint8_t pin, uint16_t fallback) {
+    return adc_values[pin] ? adc_values[pin] - 1 : fallback;
+}
+
+bool headless_trng_word(uint32_t *word) {
+    if (next_trng_word >= trng_count) return false;
+    *word = trng_words[next_trng_word++];
+    return true;
+}
+
+void resume_main_loop(void) {
+    frame_requested = true;
+}
+
+void suspend_main_loop(void) {
+    frame_requested = false;
+}
+
+void main_loop_sleep(uint32_t ms) {
+    blocked = true;
+    _headless_replay_to(headless_now() + ms);
+    blocked = false;
+}
+
+bool main_loop_is_sleeping(void) {
+    return blocked;
+}
+
+void delay_ms(const uint16_t ms) {
+    main_loop_sleep(ms);
+}
+
+int main(int argc, char **argv) {
+    double until = -1;
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--until") == 0 && i + 1 < argc) {
+            until = atof(argv[++i]);
+        } else if (path == NULL) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [--until MS] [TRACE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (path != NULL) {
+        FILE *file = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+        if (file == NULL) {
+            perror(path);
+            return 1;
+        }
+        bool loaded = _headless_load_trace(file);
+        if (file != stdin) fclose(file);
+        if (!loaded) return 1;
+    }
+
+    headless_split_output();
+    end_ms = until >= 0 ? until : trace_end_ms + HEADLESS_SETTLE_MS;
+
+    if (has_time) watch_rtc_set_date_time(start_time);
+    app_init();
+    _watch_init();
+    app_setup();
+
+    frame_requested = true;
+    while (true) {
+        if (frame_requested) {
+            // same shape as the simulator's animation frame callback.
+            frame_requested = false;
+            if (sleeping) {
+                sleeping = false;
+                app_wake_from_standby();
+            }
+            if (app_loop()) {
+                app_prepare_for_standby();
+                sleeping = true;
+            } else {
+                frame_requested = true;
+            }
+        }
+
+        if (headless_now() >= end_ms) break;
+
+        double next_ms;
+        if (frame_requested) {
+            next_ms = headless_now() + HEADLESS_FRAME_MS;
+        } else {
+            // asleep: skip straight to whatever wakes us next.
+            next_ms = _headless_next_wake();
+        }
+        _headless_replay_to(next_ms < end_ms ? next_ms : end_ms);
+    }
+
+    headless_finish();
+}
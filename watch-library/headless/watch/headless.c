@@ -0,0 +1,197 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include "headless.h"
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+
+#define HEADLESS_MAX_TIMERS 32
+
+typedef struct {
+    void (*callback)(void *userData);
+    void *user_data;
+    double deadline;
+    double interval;    // zero for a one-shot timeout
+    uint32_t sequence;  // breaks ties between timers due at the same moment, oldest first
+    long id;            // zero when the slot is free
+} headless_timer_t;
+
+static headless_timer_t _timers[HEADLESS_MAX_TIMERS];
+static long _next_timer_id = 1;
+static uint32_t _next_sequence;
+static double _now;
+
+static FILE *_output;
+static uint32_t _segments[3];
+static uint32_t _emitted_segments[3];
+static bool _display_emitted;
+
+double headless_now(void) {
+    return _now;
+}
+
+static headless_timer_t *_headless_earliest_timer(void) {
+    headless_timer_t *earliest = NULL;
+    for (int i = 0; i < HEADLESS_MAX_TIMERS; i++) {
+        headless_timer_t *timer = &_timers[i];
+        if (!timer->id) continue;
+        if (earliest == NULL || timer->deadline < earliest->deadline ||
+            (timer->deadline == earliest->deadline && (int32_t)(timer->sequence - earliest->sequence) < 0)) {
+            earliest = timer;
+        }
+    }
+    return earliest;
+}
+
+double headless_next_deadline(void) {
+    headless_timer_t *timer = _headless_earliest_timer();
+    return timer ? timer->deadline : -1;
+}
+
+void headless_advance_to(double ms) {
+    headless_flush_display();
+
+    headless_timer_t *timer;
+    while ((timer = _headless_earliest_timer()) != NULL && timer->deadline <= ms) {
+        if (timer->deadline > _now) _now = timer->deadline;
+
+        void (*callback)(void *) = timer->callback;
+        void *user_data = timer->user_data;
+        if (timer->interval > 0) {
+            timer->deadline += timer->interval;
+            timer->sequence = _next_sequence++;
+        } else {
+            timer->id = 0;
+        }
+        // the callback may set or clear timers, including this one.
+        callback(user_data);
+        headless_flush_display();
+    }
+
+    if (ms > _now) _now = ms;
+}
+
+void headless_split_output(void) {
+    fflush(stdout);
+    int replay_fd = dup(STDOUT_FILENO);
+    if (replay_fd < 0 || (_output = fdopen(replay_fd, "w")) == NULL) return;
+    dup2(STDERR_FILENO, STDOUT_FILENO);
+}
+
+void headless_log(const char *format, ...) {
+    FILE *output = _output ? _output : stdout;
+    va_list args;
+    va_start(args, format);
+    fprintf(output, "%lu ", (unsigned long)_now);
+    vfprintf(output, format, args);
+    fputc('\n', output);
+    va_end(args);
+}
+
+void headless_comment(const char *format, ...) {
+    FILE *output = _output ? _output : stdout;
+    va_list args;
+    va_start(args, format);
+    fputs("# ", output);
+    vfprintf(output, format, args);
+    fputc('\n', output);
+    va_end(args);
+}
+
+void headless_set_segment(uint8_t com, uint8_t seg, bool on) {
+    if (com > 2 || seg > 31) return;
+    if (on) _segments[com] |= 1ul << seg;
+    else _segments[com] &= ~(1ul << seg);
+}
+
+bool headless_get_segment(uint8_t com, uint8_t seg) {
+    if (com > 2 || seg > 31) return false;
+    return _segments[com] & (1ul << seg);
+}
+
+void headless_flush_display(void) {
+    if (_display_emitted && memcmp(_segments, _emitted_segments, sizeof(_segments)) == 0) return;
+    memcpy(_emitted_segments, _segments, sizeof(_segments));
+    _display_emitted = true;
+
+    static const char *const indicator_names[] = { " SIGNAL", " BELL", " PM", " 24H", " LAP", " :" };
+    char text[11];
+    char names[40] = "";
+    uint8_t indicators;
+    headless_decode_display(_segments, text, &indicators);
+    for (uint8_t i = 0; i < sizeof(indicator_names) / sizeof(indicator_names[0]); i++) {
+        if (indicators & (1 << i)) strcat(names, indicator_names[i]);
+    }
+    headless_log("frame %08lx %08lx %08lx \"%s\"%s", (unsigned long)_segments[0], (unsigned long)_segments[1], (unsigned long)_segments[2], text, names);
+}
+
+double emscripten_get_now(void) {
+    return _now;
+}
+
+static long _headless_add_timer(void (*cb)(void *userData), double msecs, double interval, void *userData) {
+    for (int i = 0; i < HEADLESS_MAX_TIMERS; i++) {
+        headless_timer_t *timer = &_timers[i];
+        if (timer->id) continue;
+        timer->callback = cb;
+        timer->user_data = userData;
+        timer->deadline = _now + (msecs > 0 ? msecs : 0);
+        timer->interval = interval;
+        timer->sequence = _next_sequence++;
+        timer->id = _next_timer_id++;
+        return timer->id;
+    }
+    fprintf(stderr, "headless: out of timers\n");
+    return -1;
+}
+
+static void _headless_clear_timer(long id) {
+    if (id <= 0) return;
+    for (int i = 0; i < HEADLESS_MAX_TIMERS; i++) {
+        if (_timers[i].id == id) _timers[i].id = 0;
+    }
+}
+
+long emscripten_set_timeout(void (*cb)(void *userData), double msecs, void *userData) {
+    return _headless_add_timer(cb, msecs, 0, userData);
+}
+
+void emscripten_clear_timeout(long setTimeoutId) {
+    _headless_clear_timer(setTimeoutId);
+}
+
+long emscripten_set_interval(void (*cb)(void *userData), double intervalMsecs, void *userData) {
+    // an interval of zero would spin forever; browsers clamp these too.
+    if (intervalMsecs < 1) intervalMsecs = 1;
+    return _headless_add_timer(cb, intervalMsecs, intervalMsecs, userData);
+}
+
+void emscripten_clear_interval(long setIntervalId) {
+    _headless_clear_timer(setIntervalId);
+}
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HEADLESS_H_
+#define HEADLESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Shared state for the headless replayer. Time is virtual: nothing happens between timer
+ * deadlines, so a day of watch time replays in well under a second. The backends in this
+ * directory report what the watch would have shown (LCD segments, buzzer, LED) through the
+ * headless_log family, and pull recorded inputs (ADC readings, TRNG words) from the trace.
+ */
+
+/// Length of one simulated animation frame, in milliseconds.
+#define HEADLESS_FRAME_MS (1000.0 / 60.0)
+
+/// Virtual milliseconds since the replay started.
+double headless_now(void);
+
+/// Virtual time of the earliest pending timer, or a negative number if none are pending.
+double headless_next_deadline(void);
+
+/// Advances virtual time to `ms`, firing every timer that comes due on the way in order.
+void headless_advance_to(double ms);
+
+/// Keeps standard output for the replay's own lines, and sends anything the firmware prints
+/// (filesystem messages, debug printf) to standard error, so that runs can be diffed.
+void headless_split_output(void);
+
+/// Prints one line of replay output, prefixed with the current virtual time.
+void headless_log(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/// Prints a comment line (prefixed with #) to the replay output.
+void headless_comment(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/// Records a segment change; the frame is emitted before time next advances.
+void headless_set_segment(uint8_t com, uint8_t seg, bool on);
+
+/// Reads a segment back from the bitmap.
+bool headless_get_segment(uint8_t com, uint8_t seg);
+
+/// Emits a `frame` line if the display changed since the last one.
+void headless_flush_display(void);
+
+/// Reads a segment bitmap back as text: the ten character positions in the order they are numbered
+/// (weekday, day of month, then hours, minutes and seconds) with '?' where the segments lit match no
+/// character, and a mask of lit indicators with one bit per WatchIndicatorSegment, plus the colon.
+void headless_decode_display(const uint32_t segments[3], char text[11], uint8_t *indicators);
+
+/// Bit for the colon in the indicator mask returned by headless_decode_display.
+#define HEADLESS_INDICATOR_COLON (1 << 5)
+
+/// Counts an RTC periodic tick or alarm, for comparison against the recorded trace.
+void headless_count_tick(void);
+void headless_count_alarm(void);
+
+/// Blocks in standby until the next timer or recorded input fires, as the chip waits for an
+/// interrupt. Finishes the replay if nothing is left to wake us before it ends.
+void headless_wait_for_interrupt(void);
+
+/// Prints the replay summary and exits.
+void headless_finish(void) __attribute__((noreturn));
+
+/// Injects a button edge, exactly as the simulator's DOM event handlers would.
+void headless_inject_button(uint8_t pin, bool level);
+
+/// Pseudo-pin under which recorded VCC readings are kept.
+#define HEADLESS_ADC_VCC 0xFF
+
+/// Most recent ADC reading recorded for `pin`, or `fallback` if the trace has none yet.
+uint16_t headless_adc_value(uint8_t pin, uint16_t fallback);
+
+/// Next TRNG word recorded in the trace; returns false once they are used up.
+bool headless_trng_word(uint32_t *word);
+
+#endif // HEADLESS_H_
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_slcd.h"
+#include "watch_private_display.h"
+#include "headless.h"
+
+// the same table as watch_private_display.c, which keeps its copy private.
+static const uint8_t IndicatorPixels[][2] = {
+    { 0, 17 }, // WATCH_INDICATOR_SIGNAL
+    { 0, 16 }, // WATCH_INDICATOR_BELL
+    { 2, 17 }, // WATCH_INDICATOR_PM
+    { 2, 16 }, // WATCH_INDICATOR_24H
+    { 1, 10 }, // WATCH_INDICATOR_LAP
+};
+
+// Several characters share a segment pattern (0 and D, 5 and S...), so the first match wins. The
+// weekday positions usually hold letters and the rest usually hold digits, so each gets its own order.
+// The double quote is left out, since frame lines use it to delimit the text.
+static const char *const Letters_First = " ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_=/'()[]<>?^~!&*+,$#@`\\{|}";
+static const char *const Digits_First = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz-_=/'()[]<>?^~!&*+,$#@`\\{|}";
+
+static bool _headless_pixel(const uint32_t segments[3], uint8_t com, uint8_t seg) {
+    return (segments[com] >> seg) & 1;
+}
+
+// true if drawing `character` at `position` would leave that position's segments exactly as they are.
+static bool _headless_character_matches(const uint32_t segments[3], char character, uint8_t position) {
+    uint64_t segmap = Segment_Map[position];
+    uint8_t segdata = Character_Set[character - 0x20];
+    uint32_t drawn[3] = {0};
+    uint32_t touched[3] = {0};
+
+    // replay watch_display_character's writes, so that shared segments end up as the last write leaves them.
+    for (int i = 0; i < 8; i++) {
+        uint8_t com = (segmap & 0xFF) >> 6;
+        uint8_t seg = segmap & 0x3F;
+        if (com <= 2) {
+            touched[com] |= 1ul << seg;
+            if (segdata & 1) drawn[com] |= 1ul << seg;
+            else drawn[com] &= ~(1ul << seg);
+        }
+        segmap = segmap >> 8;
+        segdata = segdata >> 1;
+    }
+
+    for (int com = 0; com < 3; com++) {
+        if ((segments[com] & touched[com]) != drawn[com]) return false;
+    }
+    return true;
+}
+
+static char _headless_decode_character(const uint32_t segments[3], uint8_t position) {
+    // B and D are 8 and 0 plus a ninth segment, which position 0 keeps outside its map and position 1 inside.
+    if (position < 2 && _headless_pixel(segments, 0, position == 0 ? 15 : 12)) {
+        uint32_t without_ninth[3] = { segments[0] & ~(1ul << (position == 0 ? 15 : 12)), segments[1], segments[2] };
+        if (_headless_character_matches(without_ninth, '8', position)) return 'B';
+        if (_headless_character_matches(without_ninth, '0', position)) return 'D';
+    }
+
+    const char *candidates = position < 2 ? Letters_First : Digits_First;
+    for (const char *c = candidates; *c; c++) {
+        if (!_headless_character_matches(segments, *c, position)) continue;
+        // undo watch_display_character's substitutions where they would otherwise read back as punctuation.
+        if (position == 4 || position == 6) {
+            if (*c == '&') return '7';
+            if (*c == '!') return 'L';
+        }
+        return *c;
+    }
+
+    return '?';
+}
+
+void headless_decode_display(const uint32_t segments[3], char text[11], uint8_t *indicators) {
+    for (uint8_t position = 0; position < Num_Chars; position++) {
+        text[position] = _headless_decode_character(segments, position);
+    }
+    text[Num_Chars] = 0;
+
+    *indicators = 0;
+    for (uint8_t i = 0; i < sizeof(IndicatorPixels) / sizeof(IndicatorPixels[0]); i++) {
+        if (_headless_pixel(segments, IndicatorPixels[i][0], IndicatorPixels[i][1])) *indicators |= 1 << i;
+    }
+    if (_headless_pixel(segments, 1, 16)) *indicators |= HEADLESS_INDICATOR_COLON;
+}
@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Joey Castillo
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_rtc.h"
+#include "watch_utility.h"
+#include "watch_main_loop.h"
+#include "headless.h"
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+
+// The headless RTC counts virtual time from whatever the trace set it to. Timestamps are local
+// time with no offset, as the real RTC's calendar registers are.
+static uint32_t rtc_base_timestamp = 1577836800; // 2020-01-01 00:00:00, where a freshly reset RTC starts
+static double rtc_base_ms;
+static long tick_callbacks[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+static ext_irq_cb_t tick_functions[8];
+
+static long alarm_timeout_id = -1;
+static watch_date_time alarm_date_time;
+static watch_rtc_alarm_match alarm_mask;
+ext_irq_cb_t alarm_callback;
+ext_irq_cb_t btn_alarm_callback;
+ext_irq_cb_t a2_callback;
+ext_irq_cb_t a4_callback;
+
+static void watch_rtc_schedule_alarm(void);
+
+bool _watch_rtc_is_enabled(void) {
+    return true;
+}
+
+void _watch_rtc_init(void) {
+}
+
+static uint32_t watch_rtc_get_timestamp(void) {
+    return rtc_base_timestamp + (uint32_t)((headless_now() - rtc_base_ms) / 1000);
+}
+
+void watch_rtc_set_date_time(watch_date_time date_time) {
+    rtc_base_timestamp = watch_utility_date_time_to_unix_time(date_time, 0);
+    rtc_base_ms = headless_now();
+    // the hardware compares against the calendar continuously, so a pending alarm follows the new time.
+    if (alarm_callback) watch_rtc_schedule_alarm();
+}
+
+watch_date_time watch_rtc_get_date_time(void) {
+    return watch_utility_date_time_from_unix_time(watch_rtc_get_timestamp(), 0);
+}
+
+void watch_rtc_register_tick_callback(ext_irq_cb_t callback) {
+    watch_rtc_register_periodic_callback(callback, 1);
+}
+
+void watch_rtc_disable_tick_callback(void) {
+    watch_rtc_disable_periodic_callback(1);
+}
+
+static void watch_invoke_periodic_callback(void *userData) {
+    uint8_t per_n = (uintptr_t)userData;
+    headless_count_tick();
+    tick_functions[per_n]();
+    resume_main_loop();
+}
+
+void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequency) {
+    // we told them, it has to be a power of 2.
+    if (__builtin_popcount(frequency) != 1) return;
+
+    uint8_t per_n = __builtin_clz((frequency & 0xFF) << 24);
+    double interval = 1000.0 / frequency; // in msec
+
+    if (tick_callbacks[per_n] != -1) emscripten_clear_interval(tick_callbacks[per_n]);
+    tick_functions[per_n] = callback;
+    tick_callbacks[per_n] = emscripten_set_interval(watch_invoke_periodic_callback, interval, (void *)(uintptr_t)per_n);
+}
+
+void watch_rtc_disable_periodic_callback(uint8_t frequency) {
+    if (__builtin_popcount(frequency) != 1) return;
+    uint8_t per_n = __builtin_clz((frequency & 0xFF) << 24);
+    if (tick_callbacks[per_n] != -1) {
+        emscripten_clear_interval(tick_callbacks[per_n]);
+        tick_callbacks[per_n] = -1;
+    }
+}
+
+void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
+    for (int i = 0; i < 8; i++) {
+        if (tick_callbacks[i] != -1 && (mask & (1 << i)) != 0) {
+            emscripten_clear_interval(tick_callbacks[i]);
+            tick_callbacks[i] = -1;
+        }
+    }
+}
+
+void watch_rtc_disable_all_periodic_callbacks(void) {
+    watch_rtc_disable_matching_periodic_callbacks(0xFF);
+}
+
+static void watch_invoke_alarm_callback(void *userData) {
+    alarm_timeout_id = -1;
+    headless_count_alarm();
+    if (alarm_callback) alarm_callback();
+    resume_main_loop();
+    // re-arm from the calendar rather than on a fixed interval, in case the callback set the time.
+    if (alarm_callback && alarm_timeout_id == -1) watch_rtc_schedule_alarm();
+}
+
+static void watch_rtc_schedule_alarm(void) {
+    uint32_t period, offset;
+    switch (alarm_mask) {
+        case ALARM_MATCH_SS:
+            period = 60;
+            offset = alarm_date_time.unit.second;
+            break;
+        case ALARM_MATCH_MMSS:
+            period = 60 * 60;
+            offset = alarm_date_time.unit.minute * 60 + alarm_date_time.unit.second;
+            break;
+        case ALARM_MATCH_HHMMSS:
+            period = 24 * 60 * 60;
+            offset = alarm_date_time.unit.hour * 3600 + alarm_date_time.unit.minute * 60 + alarm_date_time.unit.second;
+            break;
+        default:
+            return;
+    }
+
+    // the match fires when the calendar rolls over into the matching second.
+    uint32_t now = watch_rtc_get_timestamp();
+    uint32_t next = now - now % period + offset;
+    if (next <= now) next += period;
+    double fire_ms = rtc_base_ms + (double)(next - rtc_base_timestamp) * 1000;
+
+    if (alarm_timeout_id != -1) emscripten_clear_timeout(alarm_timeout_id);
+    alarm_timeout_id = emscripten_set_timeout(watch_invoke_alarm_callback, fire_ms - headless_now(), NULL);
+}
+
+void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time alarm_time, watch_rtc_alarm_match mask) {
+    watch_rtc_disable_alarm_callback();
+    if (mask == ALARM_MATCH_DISABLED) return;
+
+    alarm_callback = callback;
+    alarm_date_time = alarm_time;
+    alarm_mask = mask;
+    watch_rtc_schedule_alarm();
+}
+
+void watch_rtc_disable_alarm_callback(void) {
+    alarm_callback = NULL;
+    alarm_mask = ALARM_MATCH_DISABLED;
+
+    if (alarm_timeout_id != -1) {
+        emscripten_clear_timeout(alarm_timeout_id);
+        alarm_timeout_id = -1;
+    }
+}
+
+void watch_rtc_enable(bool en)
+{
+    //Not simulated
+}
+
+void watch_rtc_freqcorr_write(int16_t value, int16_t sign)
+{
+    //Not simulated
+}
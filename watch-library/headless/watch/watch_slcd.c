@@ -0,0 +1,246 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Joey Castillo
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "watch_slcd.h"
+#include "watch_private_display.h"
+#include "hpl_slcd_config.h"
+#include "headless.h"
+
+#include <emscripten/html5.h>
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Segmented Display
+
+static char blink_character;
+static bool blink_state;
+static long blink_interval_id = - 1;
+static bool tick_state;
+static long tick_interval_id = -1;
+static watch_segments_t animation_segments;
+static watch_segments_t animation_frames[WATCH_MAX_ANIMATION_FRAMES];
+static uint8_t animation_num_frames;
+static uint32_t animation_frame_duration;
+static uint8_t animation_frame;
+static long animation_interval_id = -1;
+
+static bool frame_open = false;
+static uint32_t frame_data[3];
+static uint32_t frame_dirty[3];
+
+static uint8_t lp_seconds;
+static long lp_seconds_interval_id = -1;
+
+void watch_enable_display(void) {
+    // like the hardware, which resets the display controller here.
+    watch_stop_lp_seconds();
+    watch_clear_display();
+}
+
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    if (frame_open) {
+        frame_data[com] |= 1ul << seg;
+        frame_dirty[com] |= 1ul << seg;
+        return;
+    }
+    headless_set_segment(com, seg, true);
+}
+
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    if (frame_open) {
+        frame_data[com] &= ~(1ul << seg);
+        frame_dirty[com] |= 1ul << seg;
+        return;
+    }
+    headless_set_segment(com, seg, false);
+}
+
+bool watch_get_pixel(uint8_t com, uint8_t seg) {
+    if (frame_open && (frame_dirty[com] & (1ul << seg))) return frame_data[com] & (1ul << seg);
+    return headless_get_segment(com, seg);
+}
+
+void watch_clear_display(void) {
+    if (frame_open) {
+        memset(frame_data, 0, sizeof(frame_data));
+        memset(frame_dirty, 0xFF, sizeof(frame_dirty));
+        return;
+    }
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t seg = 0; seg < 32; seg++) {
+            headless_set_segment(com, seg, false);
+        }
+    }
+}
+
+static void watch_write_segment_data(const uint32_t data[3], const uint32_t mask[3]) {
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t seg = 0; seg < 32; seg++) {
+            if (mask[com] & (1ul << seg)) headless_set_segment(com, seg, data[com] & (1ul << seg));
+        }
+    }
+}
+
+void watch_set_segments(watch_segments_t segments, watch_segments_t lit) {
+    watch_write_segment_data(lit.com, segments.com);
+}
+
+void watch_begin_display_frame(void) {
+    memset(frame_dirty, 0, sizeof(frame_dirty));
+    frame_open = true;
+}
+
+void watch_commit_display_frame(void) {
+    if (!frame_open) return;
+    frame_open = false;
+    watch_write_segment_data(frame_data, frame_dirty);
+}
+
+static void watch_invoke_blink_callback(void *userData) {
+    blink_state = !blink_state;
+    watch_display_character(blink_state ? blink_character : ' ', 7);
+    watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+}
+
+void watch_start_character_blink(char character, uint32_t duration) {
+    if (blink_interval_id != -1) return;
+    watch_display_character(character, 7);
+    watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+
+    blink_state = true;
+    blink_character = character;
+    blink_interval_id = emscripten_set_interval(watch_invoke_blink_callback, (double)duration, NULL);
+}
+
+void watch_stop_blink(void) {
+    emscripten_clear_interval(blink_interval_id);
+    blink_interval_id = -1;
+    blink_state = false;
+}
+
+static void watch_invoke_tick_callback(void *userData) {
+    tick_state = !tick_state;
+    if (tick_state) {
+        watch_clear_pixel(0, 2);
+        watch_set_pixel(0, 3);
+    } else {
+        watch_clear_pixel(0, 3);
+        watch_set_pixel(0, 2);
+    }
+}
+
+void watch_start_tick_animation(uint32_t duration) {
+    if (tick_interval_id != -1) return;
+    watch_display_character(' ', 8);
+
+    tick_state = true;
+    tick_interval_id = emscripten_set_interval(watch_invoke_tick_callback, (double)duration, NULL);
+}
+
+bool watch_tick_animation_is_running(void) {
+    return tick_interval_id != -1;
+}
+
+void watch_stop_tick_animation(void) {
+    emscripten_clear_interval(tick_interval_id);
+    tick_interval_id = -1;
+    tick_state = false;
+
+    watch_display_character(' ', 8);
+}
+
+static void watch_show_animation_frame(uint8_t frame) {
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t seg = 0; seg < 32; seg++) {
+            if (!(animation_segments.com[com] & (1ul << seg))) continue;
+            if (animation_frames[frame].com[com] & (1ul << seg)) watch_set_pixel(com, seg);
+            else watch_clear_pixel(com, seg);
+        }
+    }
+}
+
+static void watch_invoke_animation_callback(void *userData) {
+    animation_frame = (animation_frame + 1) % animation_num_frames;
+    watch_show_animation_frame(animation_frame);
+}
+
+void watch_start_segment_animation(watch_segments_t segments, const watch_segments_t frames[], uint8_t num_frames, uint32_t frame_duration) {
+    // the same animation with new frames: swap them in and carry on from the frame we're on.
+    if (animation_interval_id != -1 && num_frames == animation_num_frames && frame_duration == animation_frame_duration &&
+        !memcmp(&segments, &animation_segments, sizeof(watch_segments_t))) {
+        memcpy(animation_frames, frames, num_frames * sizeof(watch_segments_t));
+        watch_show_animation_frame(animation_frame);
+        return;
+    }
+    if (animation_interval_id != -1) {
+        emscripten_clear_interval(animation_interval_id);
+        animation_interval_id = -1;
+    }
+    if (num_frames == 0 || num_frames > WATCH_MAX_ANIMATION_FRAMES) return;
+
+    animation_segments = segments;
+    memcpy(animation_frames, frames, num_frames * sizeof(watch_segments_t));
+    animation_num_frames = num_frames;
+    animation_frame_duration = frame_duration;
+    animation_frame = 0;
+    watch_show_animation_frame(0);
+    animation_interval_id = emscripten_set_interval(watch_invoke_animation_callback, (double)frame_duration, NULL);
+}
+
+bool watch_segment_animation_is_running(void) {
+    return animation_interval_id != -1;
+}
+
+void watch_stop_segment_animation(void) {
+    if (animation_interval_id == -1) return;
+    emscripten_clear_interval(animation_interval_id);
+    animation_interval_id = -1;
+
+    watch_show_animation_frame(0);
+}
+
+static void watch_invoke_lp_seconds_callback(void *userData) {
+    lp_seconds = (lp_seconds + 1) % 60;
+    watch_display_character_lp_seconds('0' + lp_seconds / 10, 8);
+    watch_display_character_lp_seconds('0' + lp_seconds % 10, 9);
+}
+
+void watch_start_lp_seconds(uint8_t second) {
+    watch_stop_lp_seconds();
+    if (second > 59) return;
+
+    lp_seconds = second;
+    lp_seconds_interval_id = emscripten_set_interval(watch_invoke_lp_seconds_callback, 1000.0, NULL);
+}
+
+bool watch_lp_seconds_is_running(void) {
+    return lp_seconds_interval_id != -1;
+}
+
+void watch_stop_lp_seconds(void) {
+    if (lp_seconds_interval_id == -1) return;
+    emscripten_clear_interval(lp_seconds_interval_id);
+    lp_seconds_interval_id = -1;
+}
@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "lis2dw.h"
 #include "watch.h"
 
@@ -58,11 +59,10 @@ bool lis2dw_have_new_data(void) {
 
 lis2dw_reading_t lis2dw_get_raw_reading(void) {
     uint8_t buffer[6];
-    uint8_t reg = LIS2DW_REG_OUT_X_L | 0x80; // set high bit for consecutive reads
     lis2dw_reading_t retval;
 
-    watch_i2c_send(LIS2DW_ADDRESS, &reg, 1);
-    watch_i2c_receive(LIS2DW_ADDRESS, (uint8_t *)&buffer, 6);
+    // IF_ADD_INC is set in lis2dw_begin, so all six output registers come back in one transaction.
+    watch_i2c_read_burst(LIS2DW_ADDRESS, LIS2DW_REG_OUT_X_L, (uint8_t *)&buffer, 6);
 
     retval.x = buffer[0];
     retval.x |= ((uint16_t)buffer[1]) << 8;
@@ -196,13 +196,171 @@ bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data) {
 
     fifo_data->count = temp & LIS2DW_FIFO_SAMPLE_COUNT;
 
-    for(int i = 0; i < fifo_data->count; i++) {
-        fifo_data->readings[i] = lis2dw_get_raw_reading();
+    // with the FIFO enabled and IF_ADD_INC set, the register address rolls back from OUT_Z_H to OUT_X_L, and
+    // each pass pops the next sample. so the whole FIFO drains in one burst, straight into the readings array
+    // (the samples are little-endian int16s in x, y, z order, which is exactly how lis2dw_reading_t is laid out).
+    if (fifo_data->count) {
+        watch_i2c_read_burst(LIS2DW_ADDRESS, LIS2DW_REG_OUT_X_L, (uint8_t *)fifo_data->readings, fifo_data->count * sizeof(lis2dw_reading_t));
     }
 
     return overrun;
 }
 
+static struct {
+    lis2dw_fifo_t *fifo_data;
+    watch_i2c_cb_t callback;
+    void *context;
+    uint8_t fifo_sample;
+} _lis2dw_fifo_request;
+
+static void _lis2dw_fifo_sample_read(watch_i2c_status_t status, void *context) {
+    (void) context;
+    lis2dw_fifo_t *fifo_data = _lis2dw_fifo_request.fifo_data;
+
+    fifo_data->count = (status == WATCH_I2C_STATUS_OK) ? (_lis2dw_fifo_request.fifo_sample & LIS2DW_FIFO_SAMPLE_COUNT) : 0;
+    if (fifo_data->count == 0 || !watch_i2c_queue_read(LIS2DW_ADDRESS, LIS2DW_REG_OUT_X_L, (uint8_t *)fifo_data->readings, fifo_data->count * sizeof(lis2dw_reading_t), _lis2dw_fifo_request.callback, _lis2dw_fifo_request.context)) {
+        if (_lis2dw_fifo_request.callback != NULL) _lis2dw_fifo_request.callback(status, _lis2dw_fifo_request.context);
+    }
+}
+
+bool lis2dw_start_fifo_read(lis2dw_fifo_t *fifo_data, watch_i2c_cb_t callback, void *context) {
+    _lis2dw_fifo_request.fifo_data = fifo_data;
+    _lis2dw_fifo_request.callback = callback;
+    _lis2dw_fifo_request.context = context;
+
+    return watch_i2c_queue_read(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE, &_lis2dw_fifo_request.fifo_sample, 1, _lis2dw_fifo_sample_read, NULL);
+}
+
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode, uint8_t threshold) {
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, (mode << 5) | (threshold & LIS2DW_FIFO_CTRL_FTH));
+}
+
+void lis2dw_configure_fifo_threshold_interrupt(bool on_int2, bool active_state) {
+    uint8_t configuration;
+
+    // route the FIFO threshold flag to the requested pin
+    if (on_int2) {
+        configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL5_INT2);
+        watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL5_INT2, configuration | LIS2DW_CTRL5_INT2_FTH);
+    } else {
+        configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1);
+        watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1, configuration | LIS2DW_CTRL4_INT1_FTH);
+    }
+
+    // the FIFO threshold signal follows the FIFO level, so it is never latched.
+    configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL3) & ~(LIS2DW_CTRL3_VAL_H_L_ACTIVE);
+    if (!active_state) configuration |= LIS2DW_CTRL3_VAL_H_L_ACTIVE;
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL3, configuration);
+
+    // enable interrupts
+    configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL7);
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL7, configuration | LIS2DW_CTRL7_VAL_INTERRUPTS_ENABLE);
+}
+
+void lis2dw_disable_fifo_threshold_interrupt(void) {
+    uint8_t configuration;
+
+    configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1);
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1, configuration & ~LIS2DW_CTRL4_INT1_FTH);
+    configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL5_INT2);
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL5_INT2, configuration & ~LIS2DW_CTRL5_INT2_FTH);
+}
+
+// Streaming: the FIFO runs in continuous mode and raises its threshold interrupt when it reaches the watermark.
+// The interrupt handler drains it in the background into one of two batches, so the CPU only wakes once per
+// watermark, and the face can take its time consuming one batch while the next one fills.
+static struct {
+    lis2dw_fifo_t batches[LIS2DW_STREAM_NUM_BATCHES];
+    volatile uint8_t head;          // the oldest batch that is ready to be consumed
+    volatile uint8_t count;         // the number of batches ready to be consumed
+    volatile bool draining;
+    volatile uint16_t dropped;      // the number of times a watermark arrived with nowhere to put it
+    uint8_t interrupt_pin;
+    void (*batch_callback)(void);
+    const void *owner;              // whoever started the stream, or NULL if it isn't running
+} _lis2dw_stream;
+
+static void _lis2dw_stream_drain(void);
+
+static void _lis2dw_stream_batch_complete(watch_i2c_status_t status, void *context) {
+    (void) context;
+    _lis2dw_stream.draining = false;
+    if (status == WATCH_I2C_STATUS_OK) {
+        _lis2dw_stream.count++;
+        if (_lis2dw_stream.batch_callback != NULL) _lis2dw_stream.batch_callback();
+    }
+
+    // if the FIFO already refilled past the watermark while we were busy, we won't see another edge.
+    if (watch_get_pin_level(_lis2dw_stream.interrupt_pin)) _lis2dw_stream_drain();
+}
+
+static void _lis2dw_stream_drain(void) {
+    if (_lis2dw_stream.draining) return;
+    if (_lis2dw_stream.count == LIS2DW_STREAM_NUM_BATCHES) {
+        _lis2dw_stream.dropped++;
+        return;
+    }
+
+    uint8_t slot = (_lis2dw_stream.head + _lis2dw_stream.count) % LIS2DW_STREAM_NUM_BATCHES;
+    _lis2dw_stream.draining = lis2dw_start_fifo_read(&_lis2dw_stream.batches[slot], _lis2dw_stream_batch_complete, NULL);
+}
+
+bool lis2dw_stream_is_available(const void *owner) {
+    return _lis2dw_stream.owner == NULL || _lis2dw_stream.owner == owner;
+}
+
+bool lis2dw_start_stream(const void *owner, uint8_t interrupt_pin, bool on_int2, uint8_t threshold) {
+    if (owner == NULL || !lis2dw_stream_is_available(owner)) return false;
+
+    memset(&_lis2dw_stream, 0, sizeof(_lis2dw_stream));
+    _lis2dw_stream.owner = owner;
+    _lis2dw_stream.interrupt_pin = interrupt_pin;
+
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF, 0);
+    lis2dw_configure_fifo_threshold_interrupt(on_int2, true);
+    watch_register_interrupt_callback(interrupt_pin, _lis2dw_stream_drain, INTERRUPT_TRIGGER_RISING);
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS, threshold);
+
+    return true;
+}
+
+lis2dw_fifo_t *lis2dw_stream_get_batch(void) {
+    if (_lis2dw_stream.count == 0) return NULL;
+    return &_lis2dw_stream.batches[_lis2dw_stream.head];
+}
+
+void lis2dw_stream_release_batch(void) {
+    CRITICAL_SECTION_ENTER()
+    if (_lis2dw_stream.count) {
+        _lis2dw_stream.head = (_lis2dw_stream.head + 1) % LIS2DW_STREAM_NUM_BATCHES;
+        _lis2dw_stream.count--;
+        // a watermark may have come and gone while both batches were full.
+        if (watch_get_pin_level(_lis2dw_stream.interrupt_pin)) _lis2dw_stream_drain();
+    }
+    CRITICAL_SECTION_LEAVE()
+}
+
+uint16_t lis2dw_stream_get_dropped_batches(void) {
+    return _lis2dw_stream.dropped;
+}
+
+void lis2dw_stream_set_batch_callback(const void *owner, void (*callback)(void)) {
+    if (owner == NULL || _lis2dw_stream.owner != owner) return;
+    _lis2dw_stream.batch_callback = callback;
+}
+
+void lis2dw_stop_stream(const void *owner) {
+    if (owner == NULL || _lis2dw_stream.owner != owner) return;
+
+    watch_register_interrupt_callback(_lis2dw_stream.interrupt_pin, NULL, INTERRUPT_TRIGGER_NONE);
+    watch_i2c_wait_for_idle();
+    lis2dw_disable_fifo_threshold_interrupt();
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF, 0);
+    // batches that were already drained stay available until the next call to lis2dw_start_stream.
+    _lis2dw_stream.draining = false;
+    _lis2dw_stream.owner = NULL;
+}
+
 void lis2dw_clear_fifo(void) {
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_OFF);
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH);
@@ -27,6 +27,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "watch_i2c.h"
 
 typedef struct {
     int16_t x;
@@ -45,6 +46,10 @@ typedef struct {
     lis2dw_reading_t readings[32];
 } lis2dw_fifo_t;
 
+#ifndef LIS2DW_STREAM_NUM_BATCHES
+#define LIS2DW_STREAM_NUM_BATCHES 2
+#endif
+
 typedef enum {
   LIS2DW_DATA_RATE_POWERDOWN = 0,
   LIS2DW_DATA_RATE_LOWEST = 0b0001, // 12.5 Hz in high performance mode, 1.6 Hz in low power
@@ -333,8 +338,43 @@ void lis2dw_enable_fifo(void);
 
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data);
 
+// drains the FIFO in the background; fifo_data is filled in by the time the callback fires.
+bool lis2dw_start_fifo_read(lis2dw_fifo_t *fifo_data, watch_i2c_cb_t callback, void *context);
+
 void lis2dw_clear_fifo(void);
 
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode, uint8_t threshold);
+
+void lis2dw_configure_fifo_threshold_interrupt(bool on_int2, bool active_state);
+
+void lis2dw_disable_fifo_threshold_interrupt(void);
+
+// streaming mode: wakes only when the FIFO reaches the threshold, and drains it in the background.
+// interrupt_pin is the watch pin wired to the LIS2DW's INT1 (or INT2, if on_int2 is true).
+// There is only one stream, and owner (any pointer unique to the caller, like a face's context) holds it until
+// it calls lis2dw_stop_stream. Returns false, and leaves the sensor alone, if someone else holds it; the same
+// owner may call it again to restart its own stream, say after waking from sleep.
+bool lis2dw_start_stream(const void *owner, uint8_t interrupt_pin, bool on_int2, uint8_t threshold);
+
+// true if the stream is free, or already held by owner. Check this before reconfiguring the sensor.
+bool lis2dw_stream_is_available(const void *owner);
+
+// returns the oldest complete batch of samples, or NULL if there isn't one yet.
+lis2dw_fifo_t *lis2dw_stream_get_batch(void);
+
+// call when you're done with the batch returned by lis2dw_stream_get_batch.
+void lis2dw_stream_release_batch(void);
+
+uint16_t lis2dw_stream_get_dropped_batches(void);
+
+// optional: called from the interrupt each time a batch is complete, so a consumer that has no loop of its own
+// running (say, a face that counts in the background) can take batches as they arrive. NULL turns it off,
+// and so does lis2dw_start_stream, so set it after starting the stream. Only the stream's owner can set it.
+void lis2dw_stream_set_batch_callback(const void *owner, void (*callback)(void));
+
+// does nothing unless owner holds the stream.
+void lis2dw_stop_stream(const void *owner);
+
 void lis2dw_configure_wakeup_int1(uint8_t threshold, bool latch, bool active_state);
 
 lis2dw_interrupt_source lis2dw_get_interrupt_source(void);
@@ -33,29 +33,24 @@ THE SOFTWARE.
 #include "opt3001.h"
 #include "watch_utility.h"
 
-uint16_t opt3001_readManufacturerID(uint8_t devaddr) {
-	uint8_t buf[2];
-	buf[0] = (uint8_t) OPT3001_MANUFACTURER_ID; 
-	watch_i2c_send(devaddr, buf, 1);
-	watch_i2c_receive(devaddr, buf, 2);
+// OPT3001 registers are big-endian; the pointer write and the read share one transaction via a repeated start.
+static uint16_t _opt3001_read16(uint8_t devaddr, uint8_t reg) {
+	uint8_t buf[2] = {0};
+	watch_i2c_read_burst(devaddr, reg, buf, 2);
     return ((uint16_t) buf[0] << 8) | ((uint16_t) buf[1]);
 }
 
+uint16_t opt3001_readManufacturerID(uint8_t devaddr) {
+    return _opt3001_read16(devaddr, OPT3001_MANUFACTURER_ID);
+}
+
 uint16_t opt3001_readDeviceID(uint8_t devaddr) {
-	uint8_t buf[2];
-   	buf[0] = (uint8_t) OPT3001_DEVICE_ID; 
-	watch_i2c_send(devaddr, buf, 1);
-	watch_i2c_receive(devaddr, buf, 2);
-    return ((uint16_t) buf[0] << 8) | ((uint16_t) buf[1]);
+    return _opt3001_read16(devaddr, OPT3001_DEVICE_ID);
 }
 
 opt3001_Config_t opt3001_readConfig(uint8_t devaddr) {
 	opt3001_Config_t config;
-	uint8_t buf[2];
-	buf[0] = (uint8_t) OPT3001_CONFIG; 
-	watch_i2c_send(devaddr, buf, 1);
-	watch_i2c_receive(devaddr, buf, 2);
-    config.rawData = ((uint16_t) buf[0] << 8) | ((uint16_t) buf[1]);
+    config.rawData = _opt3001_read16(devaddr, OPT3001_CONFIG);
 	return config;
 }
 
@@ -80,11 +75,7 @@ opt3001_t opt3001_readLowLimit(uint8_t devaddr) {
 opt3001_t opt3001_readRegister(uint8_t devaddr, opt3001_Command_t command) {
     opt3001_t result;
     opt3001_ER_t er;
-    uint8_t buf[2]; 
-	buf[0] = (uint8_t) command; 
-	watch_i2c_send(devaddr, buf, 1);
-	watch_i2c_receive(devaddr, buf, 2);
-    er.rawData = ((uint16_t) buf[0] << 8) | ((uint16_t) buf[1]);
+    er.rawData = _opt3001_read16(devaddr, command);
     result.raw = er;
     result.lux = 0.01*pow(2, er.Exponent)*er.Result;
     return result;
@@ -39,6 +39,7 @@ static void flash_disable(void) {
 }
 
 static bool transfer(uint8_t *command, uint32_t command_length, uint8_t *data_in, uint8_t *data_out, uint32_t data_length) {
+    flash_enable();
     bool status = watch_spi_write(command, command_length);
     if (status) {
         if (data_in != NULL && data_out != NULL) {
@@ -113,6 +114,16 @@ bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length)
     return status;
 }
 
+bool spi_flash_is_busy(void) {
+    uint8_t status = 0;
+    spi_flash_read_command(CMD_READ_STATUS, &status, 1);
+    return (status & SPI_FLASH_STATUS_BUSY) != 0;
+}
+
+void spi_flash_wait_for_ready(void) {
+    while (spi_flash_is_busy());
+}
+
 void spi_flash_init(void) {
 	gpio_set_pin_level(A3, true);
 	gpio_set_pin_direction(A3, GPIO_DIRECTION_OUT);
@@ -0,0 +1,225 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "spiflash_log.h"
+
+#define SPI_FLASH_LOG_ERASED_SEQUENCE 0xFFFFFFFF
+
+static uint16_t _spi_flash_log_total_pages(spi_flash_log_t *log) {
+    return log->num_sectors * SPI_FLASH_PAGES_PER_SECTOR;
+}
+
+static uint32_t _spi_flash_log_page_address(spi_flash_log_t *log, uint16_t page) {
+    return ((uint32_t)log->first_sector * SPI_FLASH_PAGES_PER_SECTOR + page) * SPI_FLASH_PAGE_SIZE;
+}
+
+static bool _spi_flash_log_is_erased(spi_flash_log_t *log, uint16_t sector) {
+    return (log->erased[sector / 8] & (1 << (sector % 8))) != 0;
+}
+
+static void _spi_flash_log_erase_sector(spi_flash_log_t *log, uint16_t sector) {
+    spi_flash_wait_for_ready();
+    spi_flash_command(CMD_ENABLE_WRITE);
+    spi_flash_sector_command(CMD_SECTOR_ERASE, _spi_flash_log_page_address(log, sector * SPI_FLASH_PAGES_PER_SECTOR));
+    // we don't wait for the erase to finish here; every other operation waits for the flash to be ready first.
+    log->erased[sector / 8] |= 1 << (sector % 8);
+}
+
+static uint16_t _spi_flash_log_crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+    // CRC-16/CCITT
+    while (length--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t _spi_flash_log_page_crc(const spi_flash_log_page_header_t *header, const uint8_t *payload) {
+    uint8_t header_bytes[6];
+    memcpy(header_bytes, &header->sequence, 4);
+    memcpy(header_bytes + 4, &header->length, 2);
+    return _spi_flash_log_crc16(_spi_flash_log_crc16(0xFFFF, header_bytes, 6), payload, header->length);
+}
+
+static void _spi_flash_log_read_header(spi_flash_log_t *log, uint16_t page, spi_flash_log_page_header_t *header) {
+    spi_flash_wait_for_ready();
+    spi_flash_read_data(_spi_flash_log_page_address(log, page), (uint8_t *)header, sizeof(spi_flash_log_page_header_t));
+}
+
+static uint16_t _spi_flash_log_used_pages(spi_flash_log_t *log) {
+    uint16_t total_pages = _spi_flash_log_total_pages(log);
+    uint16_t used_pages;
+
+    if (log->empty) return 0;
+    used_pages = (log->head_page + total_pages - log->tail_sector * SPI_FLASH_PAGES_PER_SECTOR) % total_pages;
+    // head and tail only meet when the log has wrapped all the way around.
+    if (used_pages == 0) used_pages = total_pages;
+
+    return used_pages;
+}
+
+void spi_flash_log_mount(spi_flash_log_t *log, uint16_t first_sector, uint16_t num_sectors, bool overwrite_oldest) {
+    spi_flash_log_page_header_t header;
+    uint32_t newest_sequence = 0;
+    uint32_t oldest_sequence = SPI_FLASH_LOG_ERASED_SEQUENCE;
+    uint16_t newest_sector = 0;
+
+    memset(log, 0, sizeof(spi_flash_log_t));
+    log->first_sector = first_sector;
+    log->num_sectors = num_sectors;
+    log->overwrite_oldest = overwrite_oldest;
+    log->empty = true;
+
+    // the first page of each sector tells us where the sector falls in the log.
+    for (uint16_t sector = 0; sector < num_sectors; sector++) {
+        _spi_flash_log_read_header(log, sector * SPI_FLASH_PAGES_PER_SECTOR, &header);
+        if (header.sequence == SPI_FLASH_LOG_ERASED_SEQUENCE) continue;
+        log->empty = false;
+        // a torn first page can only be the most recent write, and tearing can only leave bits set,
+        // so even a torn sequence number sorts this sector to the head where it belongs.
+        if (header.sequence >= newest_sequence) {
+            newest_sequence = header.sequence;
+            newest_sector = sector;
+        }
+        if (header.sequence < oldest_sequence) {
+            oldest_sequence = header.sequence;
+            log->tail_sector = sector;
+        }
+    }
+
+    if (log->empty) return;
+
+    // now find the first page in the newest sector that was never programmed.
+    log->next_sequence = newest_sequence + 1;
+    log->head_page = (newest_sector + 1) * SPI_FLASH_PAGES_PER_SECTOR;
+    for (uint16_t i = 0; i < SPI_FLASH_PAGES_PER_SECTOR; i++) {
+        uint8_t page[SPI_FLASH_PAGE_SIZE];
+        uint16_t j;
+
+        spi_flash_wait_for_ready();
+        spi_flash_read_data(_spi_flash_log_page_address(log, newest_sector * SPI_FLASH_PAGES_PER_SECTOR + i), page, SPI_FLASH_PAGE_SIZE);
+        for (j = 0; j < SPI_FLASH_PAGE_SIZE; j++) if (page[j] != 0xFF) break;
+        if (j == SPI_FLASH_PAGE_SIZE) {
+            log->head_page = newest_sector * SPI_FLASH_PAGES_PER_SECTOR + i;
+            break;
+        }
+        memcpy(&header, page, sizeof(header));
+        if (header.sequence != SPI_FLASH_LOG_ERASED_SEQUENCE && header.sequence >= log->next_sequence) {
+            log->next_sequence = header.sequence + 1;
+        }
+    }
+    log->head_page %= _spi_flash_log_total_pages(log);
+}
+
+bool spi_flash_log_append(spi_flash_log_t *log, const void *data, uint16_t length) {
+    uint8_t page[SPI_FLASH_PAGE_SIZE];
+    spi_flash_log_page_header_t header;
+    uint16_t sector = log->head_page / SPI_FLASH_PAGES_PER_SECTOR;
+
+    if (length > SPI_FLASH_LOG_PAYLOAD_SIZE) return false;
+
+    if (log->head_page % SPI_FLASH_PAGES_PER_SECTOR == 0) {
+        // starting a new sector. if it's the oldest one, we're full.
+        if (!log->empty && sector == log->tail_sector) {
+            if (!log->overwrite_oldest) return false;
+            log->tail_sector = (log->tail_sector + 1) % log->num_sectors;
+        }
+        if (!_spi_flash_log_is_erased(log, sector)) _spi_flash_log_erase_sector(log, sector);
+    }
+
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page + sizeof(header), data, length);
+    header.sequence = log->next_sequence;
+    header.length = length;
+    header.crc = _spi_flash_log_page_crc(&header, page + sizeof(header));
+    memcpy(page, &header, sizeof(header));
+
+    spi_flash_wait_for_ready();
+    spi_flash_command(CMD_ENABLE_WRITE);
+    spi_flash_write_data(_spi_flash_log_page_address(log, log->head_page), page, SPI_FLASH_PAGE_SIZE);
+
+    log->erased[sector / 8] &= ~(1 << (sector % 8));
+    log->empty = false;
+    log->next_sequence++;
+    log->head_page = (log->head_page + 1) % _spi_flash_log_total_pages(log);
+
+    // having just started this sector, get the next one ready while we fill it.
+    if (log->head_page % SPI_FLASH_PAGES_PER_SECTOR == 1) {
+        uint16_t next_sector = (sector + 1) % log->num_sectors;
+        if (next_sector != log->tail_sector && !_spi_flash_log_is_erased(log, next_sector)) {
+            _spi_flash_log_erase_sector(log, next_sector);
+        }
+    }
+
+    return true;
+}
+
+void spi_flash_log_erase(spi_flash_log_t *log) {
+    for (uint16_t sector = 0; sector < log->num_sectors; sector++) {
+        _spi_flash_log_erase_sector(log, sector);
+    }
+    spi_flash_wait_for_ready();
+    log->empty = true;
+    log->head_page = 0;
+    log->tail_sector = 0;
+}
+
+bool spi_flash_log_is_full(spi_flash_log_t *log) {
+    return !log->overwrite_oldest && _spi_flash_log_used_pages(log) == _spi_flash_log_total_pages(log);
+}
+
+uint16_t spi_flash_log_get_free_pages(spi_flash_log_t *log) {
+    return _spi_flash_log_total_pages(log) - _spi_flash_log_used_pages(log);
+}
+
+void spi_flash_log_rewind(spi_flash_log_t *log, spi_flash_log_cursor_t *cursor) {
+    cursor->page = log->tail_sector * SPI_FLASH_PAGES_PER_SECTOR;
+    cursor->remaining = _spi_flash_log_used_pages(log);
+}
+
+bool spi_flash_log_read_next(spi_flash_log_t *log, spi_flash_log_cursor_t *cursor, void *data, uint16_t *length) {
+    uint8_t page[SPI_FLASH_PAGE_SIZE];
+    spi_flash_log_page_header_t header;
+
+    while (cursor->remaining) {
+        spi_flash_wait_for_ready();
+        spi_flash_read_data(_spi_flash_log_page_address(log, cursor->page), page, SPI_FLASH_PAGE_SIZE);
+        cursor->page = (cursor->page + 1) % _spi_flash_log_total_pages(log);
+        cursor->remaining--;
+
+        // skip pages that were torn by a power loss, or never written
+        memcpy(&header, page, sizeof(header));
+        if (header.length > SPI_FLASH_LOG_PAYLOAD_SIZE) continue;
+        if (header.crc != _spi_flash_log_page_crc(&header, page + sizeof(header))) continue;
+
+        memcpy(data, page + sizeof(header), header.length);
+        *length = header.length;
+        return true;
+    }
+
+    return false;
+}
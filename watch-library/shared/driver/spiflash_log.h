@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SPIFLASH_LOG_H
+#define SPIFLASH_LOG_H
+
+#include "spiflash.h"
+
+/*
+ * A log-structured store on the SPI flash.
+ *
+ * Records are appended one page at a time. Every page carries a header with a sequence number and a
+ * CRC, so there is no allocation table to update (or to corrupt): mounting the log scans the first
+ * page of each sector to find the oldest and newest data, and a page that was torn by a power loss
+ * simply fails its CRC and is skipped. Sectors are used in a ring, so every sector is erased equally
+ * often, and the sector after the one being written is erased ahead of time so appends don't stall.
+ */
+
+#define SPI_FLASH_PAGE_SIZE 256
+#define SPI_FLASH_SECTOR_SIZE 4096
+#define SPI_FLASH_PAGES_PER_SECTOR (SPI_FLASH_SECTOR_SIZE / SPI_FLASH_PAGE_SIZE)
+#define SPI_FLASH_NUM_SECTORS 512    // 2 MB
+
+typedef struct {
+    uint32_t sequence;
+    uint16_t length;
+    uint16_t crc;
+} spi_flash_log_page_header_t;
+
+#define SPI_FLASH_LOG_PAYLOAD_SIZE (SPI_FLASH_PAGE_SIZE - sizeof(spi_flash_log_page_header_t))
+
+typedef struct {
+    // configuration
+    uint16_t first_sector;
+    uint16_t num_sectors;
+    bool overwrite_oldest;      // when full, erase the oldest sector instead of refusing new records
+    // cached state; do not manipulate directly.
+    bool empty;
+    uint32_t next_sequence;
+    uint16_t head_page;         // next page to write, relative to first_sector
+    uint16_t tail_sector;       // oldest sector with data in it, relative to first_sector
+    uint8_t erased[SPI_FLASH_NUM_SECTORS / 8]; // sectors we know to be erased and ready to program
+} spi_flash_log_t;
+
+typedef struct {
+    uint16_t page;
+    uint16_t remaining;
+} spi_flash_log_cursor_t;
+
+// Scans the flash to find the head and tail of the log. Call spi_flash_init first.
+void spi_flash_log_mount(spi_flash_log_t *log, uint16_t first_sector, uint16_t num_sectors, bool overwrite_oldest);
+
+// Appends one record of up to SPI_FLASH_LOG_PAYLOAD_SIZE bytes. Returns false if the log is full.
+bool spi_flash_log_append(spi_flash_log_t *log, const void *data, uint16_t length);
+
+// Erases every sector in the log. This takes a while.
+void spi_flash_log_erase(spi_flash_log_t *log);
+
+bool spi_flash_log_is_full(spi_flash_log_t *log);
+
+// Returns the number of pages that can still be appended before the log is full.
+uint16_t spi_flash_log_get_free_pages(spi_flash_log_t *log);
+
+// Reading: rewind a cursor to the oldest record, then read records in order until this returns false.
+void spi_flash_log_rewind(spi_flash_log_t *log, spi_flash_log_cursor_t *cursor);
+bool spi_flash_log_read_next(spi_flash_log_t *log, spi_flash_log_cursor_t *cursor, void *data, uint16_t *length);
+
+#endif // SPIFLASH_LOG_H
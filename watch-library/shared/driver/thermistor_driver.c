@@ -26,6 +26,19 @@
 #include "watch.h"
 #include "watch_utility.h"
 
+// the latest reading from thermistor_driver_start_reading, filled in from the ADC interrupt.
+static volatile uint16_t _thermistor_driver_value;
+
+static float _thermistor_driver_temperature(uint16_t value) {
+    return watch_utility_thermistor_temperature(value, THERMISTOR_HIGH_SIDE, THERMISTOR_B_COEFFICIENT, THERMISTOR_NOMINAL_TEMPERATURE, THERMISTOR_NOMINAL_RESISTANCE, THERMISTOR_SERIES_RESISTANCE);
+}
+
+static void _thermistor_driver_conversion_done(uint16_t value) {
+    // the ADC has its sample, so there's no need to keep current flowing through the divider.
+    watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
+    _thermistor_driver_value = value;
+}
+
 void thermistor_driver_enable(void) {
     // Enable the ADC peripheral, which we'll use to read the thermistor value.
     watch_enable_adc();
@@ -54,5 +67,20 @@ float thermistor_driver_get_temperature(void) {
     // and then set the enable pin to the opposite value to power down the thermistor circuit.
     watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
 
-    return watch_utility_thermistor_temperature(value, THERMISTOR_HIGH_SIDE, THERMISTOR_B_COEFFICIENT, THERMISTOR_NOMINAL_TEMPERATURE, THERMISTOR_NOMINAL_RESISTANCE, THERMISTOR_SERIES_RESISTANCE);
+    return _thermistor_driver_temperature(value);
+}
+
+bool thermistor_driver_start_reading(void) {
+    watch_set_pin_level(THERMISTOR_ENABLE_PIN, THERMISTOR_ENABLE_VALUE);
+    if (watch_start_analog_pin_conversion(THERMISTOR_SENSE_PIN, 0, _thermistor_driver_conversion_done)) return true;
+
+    watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
+    return false;
+}
+
+float thermistor_driver_finish_reading(void) {
+    // at the default 16 samples, the conversion takes a fraction of a millisecond, and it's usually done by now.
+    while (watch_is_analog_conversion_in_progress());
+
+    return _thermistor_driver_temperature(_thermistor_driver_value);
 }
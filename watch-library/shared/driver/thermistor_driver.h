@@ -25,6 +25,8 @@
 #ifndef THERMISTOR_DRIVER_H_
 #define THERMISTOR_DRIVER_H_
 
+#include <stdbool.h>
+
 // TODO: Do these belong in movement_config.h? In settings we can set on the watch? In an EEPROM configuration area?
 // Think on this. [joey 11/22]
 #define THERMISTOR_SENSE_PIN (A2)
@@ -40,4 +42,10 @@ void thermistor_driver_enable(void);
 void thermistor_driver_disable(void);
 float thermistor_driver_get_temperature(void);
 
+// the same reading in two halves, for a caller with other work to do while the ADC samples: start powers the
+// thermistor and starts the conversion, returning false if the ADC is busy. finish waits for the result
+// (the thermistor is already powered down by then) and returns the temperature. Call both while enabled.
+bool thermistor_driver_start_reading(void);
+float thermistor_driver_finish_reading(void);
+
 #endif // THERMISTOR_DRIVER_H_
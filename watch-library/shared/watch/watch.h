@@ -55,6 +55,8 @@
             - @ref uart - This section covers functions related to the UART peripheral.
             - @ref deepsleep - This section covers functions related to preparing for and entering BACKUP mode, the
                                deepest sleep mode available on the SAM L22.
+            - @ref timer - This section covers the shared software timer service, for callbacks faster than 1 Hz.
+            - @ref trng - This section covers functions related to the SAM L22's true random number generator.
  */
 
 #include "watch_app.h"
@@ -70,6 +72,8 @@
 #include "watch_uart.h"
 #include "watch_storage.h"
 #include "watch_deepsleep.h"
+#include "watch_timer.h"
+#include "watch_trng.h"
 
 #include "watch_private.h"
 
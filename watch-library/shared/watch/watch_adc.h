@@ -51,6 +51,30 @@ void watch_enable_analog_input(const uint8_t pin);
   **/
 uint16_t watch_get_analog_pin_level(const uint8_t pin);
 
+/// @brief A function to be called when an asynchronous analog conversion completes.
+typedef void (*watch_adc_cb_t)(uint16_t value);
+
+/** @brief Starts an analog conversion on one of the pins and returns immediately.
+  * @param pin One of pins A0-A4.
+  * @param samples The number of samples to accumulate, as with watch_set_analog_num_samples, or 0
+  *                to keep the current setting. Note that this changes the setting for subsequent
+  *                conversions too.
+  * @param callback A function to call from the ADC interrupt with the result, or NULL if you intend
+  *                 to poll watch_is_analog_conversion_in_progress instead.
+  * @return true if the conversion was started; false if the pin was invalid or the ADC is busy.
+  * @details watch_get_analog_pin_level blocks until its result is ready, but it idles the CPU while
+  *          it waits, so for a single reading it is usually all you need. This function is for the
+  *          case where you have other work to do while the ADC accumulates a large number of samples.
+  *          Keep the callback short: it runs in interrupt context. The ADC's clock stops in standby,
+  *          so collect the result before you return control to Movement.
+  */
+bool watch_start_analog_pin_conversion(const uint8_t pin, uint16_t samples, watch_adc_cb_t callback);
+
+/** @brief Checks whether a conversion started with watch_start_analog_pin_conversion is still running.
+  * @return true if the ADC has not yet delivered a result.
+  */
+bool watch_is_analog_conversion_in_progress(void);
+
 /** @brief Sets the number of samples to accumulate when measuring a pin level. Default is 16.
   * @param samples A power of 2 <= 1024. Specifically: 1, 2, 4, 8, 16, 32, 64, 128, 256, 512
                    or 1024. Any other value will be ignored.
@@ -126,6 +150,9 @@ typedef enum {
   *          makes it very useful for measuring the battery voltage (since you can't really compare
   *          VCC to itself). You can change the INTREF voltage to 2.048 or 4.096 V by poking at the
   *          supply controller's VREF register, but the watch library does not support this use case.
+  *
+  *          Changing the reference requires a throwaway conversion, so the watch library only does it
+  *          when the new reference differs from the one the ADC is already using.
   **/
 void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference);
 
@@ -136,6 +163,9 @@ void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference);
   *          us measure VCC per se; it instead lets us measure VCC / 4, and we choose to measure it
   *          against the internal reference voltage of 1.024 V. In short, the ADC gives us a number
   *          that's complicated to deal with, so we just turn it into a useful number for you :)
+  *
+  *          This function does not switch the ADC back to your chosen reference voltage right away;
+  *          that happens the next time you read an analog pin, so calling it repeatedly is cheap.
   * @note This function depends on INTREF being 1.024V. If you have changed it by poking at the supply
   *       controller's VREF.SEL bits, this function will return inaccurate values.
   */
@@ -33,6 +33,19 @@
   *        registers on I2C devices.
   */
 /// @{
+#ifndef WATCH_I2C_QUEUE_LENGTH
+#define WATCH_I2C_QUEUE_LENGTH 4   ///< The number of transactions that can be waiting on the bus at once.
+#endif
+
+typedef enum {
+    WATCH_I2C_STATUS_OK = 0,    ///< The transaction completed.
+    WATCH_I2C_STATUS_NACK,      ///< The device did not acknowledge its address or a byte we sent.
+    WATCH_I2C_STATUS_BUS_ERROR, ///< The bus misbehaved, or the transaction could not be queued.
+} watch_i2c_status_t;
+
+/// @brief A function to be called from the I2C interrupt when a queued transaction completes.
+typedef void (*watch_i2c_cb_t)(watch_i2c_status_t status, void *context);
+
 /** @brief Enables the I2C peripheral. Call this before attempting to interface with I2C devices.
   */
 void watch_enable_i2c(void);
@@ -102,5 +115,53 @@ uint32_t watch_i2c_read24(int16_t addr, uint8_t reg);
           bit packing, you may need to shuffle some bits around.
   */
 uint32_t watch_i2c_read32(int16_t addr, uint8_t reg);
+
+/** @brief Queues a read of consecutive registers, to be run in the background.
+  * @param addr The address of the device you wish to address.
+  * @param reg The first register you wish to read. The device must auto-increment the register
+  *            address (or, like a FIFO, keep returning new data) for reads longer than one byte.
+  * @param buf Storage for the incoming bytes. It must remain valid until the callback fires.
+  * @param length The number of bytes that you wish to receive.
+  * @param callback A function to call when the transaction completes, or NULL.
+  * @param context A pointer that will be passed to your callback.
+  * @return true if the transaction was queued, false if the queue was full.
+  * @details The register address and the data are moved in a single transaction with a repeated
+  *          start, driven entirely by the SERCOM interrupt. The callback runs in interrupt context,
+  *          so keep it short; it may queue another transaction.
+  */
+bool watch_i2c_queue_read(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context);
+
+/** @brief Queues a write to consecutive registers, to be run in the background.
+  * @param addr The address of the device you wish to address.
+  * @param reg The first register you wish to write.
+  * @param buf The bytes to write. It must remain valid until the callback fires.
+  * @param length The number of bytes in buf that you wish to send.
+  * @param callback A function to call when the transaction completes, or NULL.
+  * @param context A pointer that will be passed to your callback.
+  * @return true if the transaction was queued, false if the queue was full.
+  */
+bool watch_i2c_queue_write(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context);
+
+/** @brief Checks whether any queued transactions are still in progress.
+  * @return true if the bus is busy with queued transactions.
+  */
+bool watch_i2c_is_busy(void);
+
+/** @brief Idles the CPU until all queued transactions have completed.
+  * @note The blocking functions above go through the same queue and idle the CPU until their own
+  *       transaction is done, so you can mix them freely with queued transactions, even ones queued
+  *       from an interrupt while they wait; they simply take their turn. Since they wait on the I2C
+  *       interrupt, don't call them from an interrupt handler.
+  */
+void watch_i2c_wait_for_idle(void);
+
+/** @brief Reads a run of consecutive registers in one transaction, idling the CPU until it's done.
+  * @param addr The address of the device you wish to address.
+  * @param reg The first register you wish to read.
+  * @param buf Storage for the incoming bytes; on return, it will contain the received data.
+  * @param length The number of bytes that you wish to receive.
+  * @return WATCH_I2C_STATUS_OK on success, or the reason the transaction failed.
+  */
+watch_i2c_status_t watch_i2c_read_burst(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length);
 /// @}
 #endif
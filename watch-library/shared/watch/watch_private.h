@@ -41,6 +41,22 @@ void _watch_disable_tcc(void);
 /// Called by main.c if plugged in to USB. You should not call this from your app.
 void _watch_enable_usb(void);
 
+/// Called by the timer service to power up its hardware counter, starting from zero. Does nothing if it's running.
+void _watch_timer_counter_enable(void);
+
+/// Called by the timer service to power down its hardware counter once no timers are pending.
+void _watch_timer_counter_disable(void);
+
+/// Called by the timer service to read its hardware counter, extended to 32 bits. Call with interrupts disabled.
+uint32_t _watch_timer_counter_now(void);
+
+/// Called by the timer service to request an interrupt at the given tick. If the deadline has already passed,
+/// the interrupt is raised immediately. Call with interrupts disabled.
+void _watch_timer_counter_arm(uint32_t deadline);
+
+/// Called by the timer counter's interrupt to run expired timers. You should not call this from your app.
+void _watch_timer_service(void);
+
 // this function ends up getting called by printf to log stuff to the USB console.
 int _write(int file, char *ptr, int len);
 
@@ -166,3 +166,62 @@ void watch_clear_all_indicators(void) {
     watch_clear_pixel(0, 16);
     watch_clear_pixel(1, 10);
 }
+
+void watch_segments_add_pixel(watch_segments_t *segments, uint8_t com, uint8_t seg) {
+    if (com > 2 || seg > 31) return;
+    segments->com[com] |= 1ul << seg;
+}
+
+void watch_segments_add_position(watch_segments_t *segments, uint8_t position) {
+    if (position >= Num_Chars) return;
+    uint64_t segmap = Segment_Map[position];
+
+    for (int i = 0; i < 8; i++) {
+        uint8_t com = (segmap & 0xFF) >> 6;
+        // COM3 means no segment exists; skip it.
+        if (com <= 2) watch_segments_add_pixel(segments, com, segmap & 0x3F);
+        segmap = segmap >> 8;
+    }
+
+    // the funky ninth segments, and the descender on position 1's T.
+    if (position == 0) {
+        watch_segments_add_pixel(segments, 0, 15);
+    } else if (position == 1) {
+        watch_segments_add_pixel(segments, 0, 12);
+        watch_segments_add_pixel(segments, 1, 12);
+    }
+}
+
+void watch_segments_add_character(watch_segments_t *segments, uint8_t character, uint8_t position) {
+    // like watch_display_character_lp_seconds, this skips the per-position special cases, so it's meant for digits.
+    if (position >= Num_Chars || character < 0x20 || character > 0x7F) return;
+    uint64_t segmap = Segment_Map[position];
+    uint64_t segdata = Character_Set[character - 0x20];
+
+    for (int i = 0; i < 8; i++) {
+        uint8_t com = (segmap & 0xFF) >> 6;
+        if (com <= 2 && (segdata & 1)) watch_segments_add_pixel(segments, com, segmap & 0x3F);
+        segmap = segmap >> 8;
+        segdata = segdata >> 1;
+    }
+}
+
+watch_segments_t watch_get_segments(watch_segments_t segments) {
+    watch_segments_t lit = {0};
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t seg = 0; seg < 32; seg++) {
+            if ((segments.com[com] & (1ul << seg)) && watch_get_pixel(com, seg)) lit.com[com] |= 1ul << seg;
+        }
+    }
+    return lit;
+}
+
+void watch_start_position_blink(uint8_t position, uint8_t length, uint32_t duration) {
+    watch_segments_t segments = {0};
+    for (uint8_t i = position; i < position + length && i < Num_Chars; i++) {
+        watch_segments_add_position(&segments, i);
+    }
+    // first frame: the characters as they are now. second frame: all of their segments off.
+    const watch_segments_t frames[2] = { watch_get_segments(segments), {{0}} };
+    watch_start_segment_animation(segments, frames, 2, duration);
+}
@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "watch_timer.h"
+
+// Pending timers, sorted by deadline. Deadlines are compared as signed differences, so the 32-bit tick count
+// can wrap without upsetting the order as long as no timer is scheduled more than 12 days out.
+static watch_timer_t *_watch_timer_queue = NULL;
+
+static void _watch_timer_insert(watch_timer_t *timer) {
+    watch_timer_t **link = &_watch_timer_queue;
+    while (*link != NULL && (int32_t)((*link)->deadline - timer->deadline) <= 0) link = &(*link)->next;
+    timer->next = *link;
+    *link = timer;
+    timer->running = true;
+}
+
+static void _watch_timer_remove(watch_timer_t *timer) {
+    for (watch_timer_t **link = &_watch_timer_queue; *link != NULL; link = &(*link)->next) {
+        if (*link == timer) {
+            *link = timer->next;
+            break;
+        }
+    }
+    timer->next = NULL;
+    timer->running = false;
+}
+
+static void _watch_timer_reschedule(void) {
+    if (_watch_timer_queue == NULL) _watch_timer_counter_disable();
+    else _watch_timer_counter_arm(_watch_timer_queue->deadline);
+}
+
+void watch_timer_start(watch_timer_t *timer, uint32_t delay, uint32_t period, watch_timer_cb_t callback, void *context) {
+    CRITICAL_SECTION_ENTER()
+    if (timer->running) _watch_timer_remove(timer);
+    _watch_timer_counter_enable();
+    timer->deadline = _watch_timer_counter_now() + delay;
+    timer->period = period;
+    timer->callback = callback;
+    timer->context = context;
+    _watch_timer_insert(timer);
+    if (_watch_timer_queue == timer) _watch_timer_reschedule();
+    CRITICAL_SECTION_LEAVE()
+}
+
+void watch_timer_stop(watch_timer_t *timer) {
+    CRITICAL_SECTION_ENTER()
+    if (timer->running) {
+        _watch_timer_remove(timer);
+        // if it was at the head, the pending compare match will find nothing to do; only power down if idle.
+        if (_watch_timer_queue == NULL) _watch_timer_counter_disable();
+    }
+    CRITICAL_SECTION_LEAVE()
+}
+
+void watch_timer_stop_all(void) {
+    CRITICAL_SECTION_ENTER()
+    while (_watch_timer_queue != NULL) _watch_timer_remove(_watch_timer_queue);
+    _watch_timer_counter_disable();
+    CRITICAL_SECTION_LEAVE()
+}
+
+bool watch_timer_is_running(const watch_timer_t *timer) {
+    return timer->running;
+}
+
+uint32_t watch_timer_get_ticks(void) {
+    uint32_t ticks;
+    CRITICAL_SECTION_ENTER()
+    ticks = _watch_timer_counter_now();
+    CRITICAL_SECTION_LEAVE()
+    return ticks;
+}
+
+void _watch_timer_service(void) {
+    watch_timer_t *expired;
+
+    do {
+        expired = NULL;
+        CRITICAL_SECTION_ENTER()
+        watch_timer_t *head = _watch_timer_queue;
+        if (head != NULL && (int32_t)(head->deadline - _watch_timer_counter_now()) <= 0) {
+            _watch_timer_queue = head->next;
+            head->next = NULL;
+            if (head->period) {
+                // periodic timers keep their phase; if we fell behind, the next pass through the loop catches up.
+                head->deadline += head->period;
+                _watch_timer_insert(head);
+            } else {
+                head->running = false;
+            }
+            expired = head;
+        } else {
+            _watch_timer_reschedule();
+        }
+        CRITICAL_SECTION_LEAVE()
+        // run the callback with interrupts enabled; it may start or stop timers, including this one.
+        if (expired != NULL && expired->callback != NULL) expired->callback(expired->context);
+    } while (expired != NULL);
+}
@@ -50,6 +50,14 @@ typedef enum WatchIndicatorSegment {
     WATCH_INDICATOR_LAP         ///< The LAP indicator; the F-91W uses this in its stopwatch UI.
 } WatchIndicatorSegment;
 
+/// A set of pixels on the display: one bit per segment pin, for each of the three common pins.
+typedef struct {
+    uint32_t com[3];
+} watch_segments_t;
+
+/// The most frames watch_start_segment_animation can play.
+#define WATCH_MAX_ANIMATION_FRAMES 8
+
 /** @brief Enables the Segment LCD display.
   * Call this before attempting to set pixels or display strings.
   */
@@ -69,10 +77,33 @@ void watch_set_pixel(uint8_t com, uint8_t seg);
   */
 void watch_clear_pixel(uint8_t com, uint8_t seg);
 
+/** @brief Checks whether a pixel is on. See <a href="segmap.html">segmap.html</a>.
+  * @param com the common pin, numbered from 0-2.
+  * @param seg the segment pin, numbered from 0-23.
+  * @return true if the pixel is currently set; false otherwise.
+  */
+bool watch_get_pixel(uint8_t com, uint8_t seg);
+
 /** @brief Clears all segments of the display, including incicators and the colon.
   */
 void watch_clear_display(void);
 
+/** @brief Starts composing a frame, so that a batch of drawing reaches the display all at once.
+  * @details Until you call watch_commit_display_frame, watch_set_pixel, watch_clear_pixel and everything
+  *          built on them (watch_display_string, indicators, the colon) only update a copy of the
+  *          segment data in RAM. This saves a register access per segment, and avoids the display
+  *          showing a half-drawn frame; use it for fast animations that redraw many segments per tick.
+  *          Every frame you begin must be committed before your loop function returns.
+  */
+void watch_begin_display_frame(void);
+
+/** @brief Writes the frame started by watch_begin_display_frame to the display.
+  * @details On the watch, this is one write per common line, with the SLCD's shadow memory locked so
+  *          that all of them take effect at the same frame boundary. Only segments drawn since
+  *          watch_begin_display_frame are changed. If no frame is open, this does nothing.
+  */
+void watch_commit_display_frame(void);
+
 /** @brief Displays a string at the given position, starting from the top left. There are ten digits.
            A space in any position will clear that digit.
   * @param string A null-terminated string.
@@ -147,5 +178,113 @@ bool watch_tick_animation_is_running(void);
   * @details This will stop the animation and clear all segments in position 8.
   */
 void watch_stop_tick_animation(void);
+
+/** @brief Adds a single pixel to a set of segments.
+  * @param segments The set to add to.
+  * @param com the common pin, numbered from 0-2.
+  * @param seg the segment pin, numbered from 0-23.
+  */
+void watch_segments_add_pixel(watch_segments_t *segments, uint8_t com, uint8_t seg);
+
+/** @brief Adds every segment of a character position to a set of segments.
+  * @param segments The set to add to.
+  * @param position The character position, from 0 to 9. @see watch_display_string
+  * @note Some positions share segments with their neighbors (see the notes in segmap.html); those
+  *       shared segments are included too.
+  */
+void watch_segments_add_position(watch_segments_t *segments, uint8_t position);
+
+/** @brief Adds the segments a character lights up in a given position to a set of segments.
+  * @param segments The set to add to.
+  * @param character The character, as you would pass it to watch_display_character.
+  * @param position The character position, from 0 to 9.
+  * @note This doesn't apply the substitutions watch_display_character makes for positions that
+  *       can't draw certain characters, so it's best suited to digits.
+  */
+void watch_segments_add_character(watch_segments_t *segments, uint8_t character, uint8_t position);
+
+/** @brief Sets a group of segments at once: those in lit are turned on, and the rest of the set is turned off.
+  * @details Unlike watch_set_pixel, this always writes to the display immediately (even while a frame is
+  *          open), so it's safe to call from an interrupt that animates segments the foreground doesn't draw.
+  * @param segments The segments to update. Segments outside the set are left alone.
+  * @param lit The segments in the set that should be on.
+  */
+void watch_set_segments(watch_segments_t segments, watch_segments_t lit);
+
+/** @brief Reads which of a set of segments are currently on.
+  * @param segments The segments to check.
+  * @return The subset of segments that are lit right now.
+  */
+watch_segments_t watch_get_segments(watch_segments_t segments);
+
+/** @brief Plays a looping animation on any set of segments.
+  * @details By default the frames are stepped by a software timer (see watch_timer.h), which wakes the
+  *          CPU briefly for each frame. Building with SLCD_DMA=1 uses the SLCD's automated bit mapping
+  *          instead: DMA feeds the display controller one frame's worth of segment data each time a frame
+  *          counter overflows, so the animation continues in STANDBY with the CPU asleep. That path has
+  *          not been tried on a watch yet, so it's opt-in for now.
+  *          Segments outside of the set are left alone, so you can keep updating the rest of the display
+  *          while this runs. Calling this again with the same segments, number of frames and duration just
+  *          swaps in the new frames, and the animation carries on where it was; anything else replaces the
+  *          current animation and starts over at the first frame.
+  *          Unlike watch_start_character_blink and watch_start_tick_animation, this works for any
+  *          segment, and it can run alongside both of them.
+  * @param segments The segments the animation controls.
+  * @param frames The frames to play in order, looping back to the first. In each frame, the segments
+  *               that are in the frame are turned on and the rest of the set is turned off. The frames
+  *               are copied, so they don't need to outlive this call.
+  * @param num_frames The number of frames, from 1 to WATCH_MAX_ANIMATION_FRAMES.
+  * @param frame_duration How long to show each frame, in milliseconds, from 16 to ~4000 ms.
+  */
+void watch_start_segment_animation(watch_segments_t segments, const watch_segments_t frames[], uint8_t num_frames, uint32_t frame_duration);
+
+/** @brief Blinks whatever is displayed in a run of character positions.
+  * @details Use this for the digit being edited on a settings screen: draw it as usual, then call this
+  *          to blink it. The blink shows whatever the positions held when you called this, so call it again
+  *          each time you redraw; as long as the positions are the same, the blink keeps its rhythm. To end
+  *          the blink, call watch_stop_segment_animation before you draw, so it doesn't put the old
+  *          characters back over the new ones.
+  *          @see watch_start_segment_animation
+  * @param position The first character position to blink.
+  * @param length The number of positions to blink.
+  * @param duration How long the characters stay on, and then off, in milliseconds.
+  */
+void watch_start_position_blink(uint8_t position, uint8_t length, uint32_t duration);
+
+/** @brief Checks if a segment animation or position blink is running.
+  * @return true if the animation is running; false otherwise.
+  */
+bool watch_segment_animation_is_running(void);
+
+/** @brief Stops a segment animation or position blink.
+  * @details The animated segments are left as the first frame draws them; for a position blink, that
+  *          means with the characters showing.
+  */
+void watch_stop_segment_animation(void);
+
+/** @brief Keeps the seconds in positions 8 and 9 counting up without waking the CPU.
+  * @details Meant for low energy mode, where a clock face only wakes once a minute. Draw the current
+  *          seconds first (watch_display_character_lp_seconds does this cheaply), then call this with
+  *          the same value. On the watch, the RTC's 1 Hz event triggers a DMA transfer that writes the
+  *          next units digit straight to the display controller; each time the units roll over to 0,
+  *          that transfer triggers a second one for the tens digit. After 59 it wraps around to 00, so
+  *          call this again when you redraw at the top of the minute to stay in step with the RTC.
+  *          Any other drawing in positions 8 and 9 will be overwritten at the next second.
+  * @warning On the watch this needs a build with SLCD_DMA=1, a path that has not been tried on a watch yet.
+  *          Otherwise it does nothing, so check watch_lp_seconds_is_running afterwards and draw what you
+  *          would without it.
+  * @param second The second currently on screen, from 0 to 59.
+  */
+void watch_start_lp_seconds(uint8_t second);
+
+/** @brief Checks if the display is counting seconds on its own.
+  * @return true if watch_start_lp_seconds is running; false otherwise.
+  */
+bool watch_lp_seconds_is_running(void);
+
+/** @brief Stops the seconds counter started by watch_start_lp_seconds.
+  * @details The seconds are left as they were last drawn.
+  */
+void watch_stop_lp_seconds(void);
 /// @}
 #endif
@@ -88,5 +88,18 @@ bool watch_storage_erase(uint32_t row);
 /** @brief Waits for any pending writes to complete.
   */
 bool watch_storage_sync(void);
+
+/** @brief Returns the read-only asset region in the main Flash array.
+  * @details The 32 kilobytes just below the EEPROM emulation area are set aside for data rather than code.
+  *          The firmware never writes there; like the application, it's written by the bootloader, when you
+  *          drag an asset pack built with utils/asset_pack.py onto the WATCHBOOT drive. That means the data
+  *          survives firmware updates (and vice versa). The region is memory mapped, so you can read it in
+  *          place through the returned pointer. Until a pack has been flashed, it holds whatever was there
+  *          before: all 0xFF bytes, or leftovers from an older, larger firmware.
+  * @param size If not NULL, set to the size of the region in bytes. The simulator has no asset region, and
+  *             sets this to 0.
+  * @return A pointer to the start of the region, or NULL if there is none.
+  */
+const uint8_t *watch_storage_get_assets(uint32_t *size);
 /// @}
 #endif
@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_TIMER_H_INCLUDED
+#define _WATCH_TIMER_H_INCLUDED
+////< @file watch_timer.h
+
+#include "watch.h"
+
+/** @addtogroup timer Software Timers
+  * @brief This section covers functions related to the shared timer service, which multiplexes any number
+  *        of one-shot and periodic software timers onto a single hardware counter (TC1, clocked at 2048 Hz
+  *        from the 32 kHz oscillator).
+  * @details Faces and drivers that need callbacks faster than the RTC's 1 Hz tick should use a watch_timer_t
+  *          rather than claiming a TC of their own. Pending timers are kept in a queue sorted by deadline,
+  *          and the counter's compare match is always set for the earliest one. When no timer is pending,
+  *          the counter and its clock channel are switched off entirely, so nothing keeps the 32 kHz clock
+  *          requested in standby on our behalf. Pending timers keep running in standby (and their interrupt wakes
+  *          the watch from it); entering backup mode stops them all.
+  * @warning Timer callbacks are invoked from the TC1 interrupt. Keep them short; to do real work, set a flag
+  *          and handle it in your loop. It is safe to start or stop timers (including the one being serviced)
+  *          from inside a callback.
+  */
+/// @{
+
+#define WATCH_TIMER_TICKS_PER_SECOND (2048)
+
+/// Converts a frequency in Hz to a timer period in ticks. Powers of two up to 2048 Hz are exact.
+#define WATCH_TIMER_HZ(hz) (WATCH_TIMER_TICKS_PER_SECOND / (hz))
+/// Converts a duration in milliseconds to ticks, rounding up so that a timer never fires early.
+#define WATCH_TIMER_MS(ms) ((((uint32_t)(ms)) * WATCH_TIMER_TICKS_PER_SECOND + 999) / 1000)
+
+typedef void (*watch_timer_cb_t)(void *context);
+
+/** @brief A software timer. The storage belongs to the caller and must stay valid while the timer is running;
+  *        a static variable is usually simplest. The fields are private to the timer service.
+  */
+typedef struct watch_timer {
+    struct watch_timer *next;
+    uint32_t deadline;
+    uint32_t period;
+    watch_timer_cb_t callback;
+    void *context;
+    bool running;
+} watch_timer_t;
+
+/** @brief Starts (or restarts) a software timer.
+  * @param timer The timer to start. If it is already running, it is rescheduled.
+  * @param delay Number of ticks until the first callback; 0 fires on the next interrupt.
+  * @param period Number of ticks between subsequent callbacks, or 0 for a one-shot timer. A periodic timer is
+  *               rescheduled relative to its previous deadline, not to when its callback ran, so it doesn't drift.
+  * @param callback The function to call when the timer expires.
+  * @param context An arbitrary pointer passed to the callback.
+  */
+void watch_timer_start(watch_timer_t *timer, uint32_t delay, uint32_t period, watch_timer_cb_t callback, void *context);
+
+/** @brief Stops a software timer. Does nothing if the timer is not running.
+  * @param timer The timer to stop.
+  */
+void watch_timer_stop(watch_timer_t *timer);
+
+/** @brief Stops every running timer and powers down the hardware counter.
+  * @note watch_enter_backup_mode calls this for you.
+  */
+void watch_timer_stop_all(void);
+
+/** @brief Checks whether a software timer is scheduled.
+  * @param timer The timer to check.
+  * @return true if the timer is waiting to fire; false if it was never started, was stopped, or was a one-shot
+  *         timer that has already fired.
+  */
+bool watch_timer_is_running(const watch_timer_t *timer);
+
+/** @brief Returns the timer service's notion of the current time.
+  * @return The number of ticks since the service last powered up the counter. Only meaningful while at least
+  *         one timer is running; the count restarts from zero each time the first timer is started.
+  */
+uint32_t watch_timer_get_ticks(void);
+
+/// @}
+#endif
@@ -0,0 +1,48 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_TRNG_H_INCLUDED
+#define _WATCH_TRNG_H_INCLUDED
+////< @file watch_trng.h
+
+#include "watch.h"
+
+/** @addtogroup trng True Random Number Generator
+  * @brief This section covers functions related to the SAM L22's true random number generator.
+  * @details The TRNG produces a fresh 32-bit word every 84 peripheral clock cycles, so there's no point leaving
+  *          it running. watch_trng_read powers it up, collects the words you asked for and powers it straight
+  *          back down. Most code wants a fast stream of random numbers rather than raw entropy; for that, use the
+  *          entropy pool in Movement, which seeds itself from here.
+  *          In the simulator, the words come from the browser's crypto.getRandomValues.
+  */
+/// @{
+/** @brief Fills a buffer with words from the true random number generator.
+  * @param words The buffer to fill.
+  * @param count The number of 32-bit words to read.
+  */
+void watch_trng_read(uint32_t *words, size_t count);
+
+/// @}
+#endif
@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include "watch.h"
 #include "watch_main_loop.h"
+#include "watch_trace.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -106,6 +107,8 @@ void delay_ms(const uint16_t ms) {
 }
 
 int main(void) {
+    // start recording first, so that the entropy drawn in app_init lands in the trace.
+    watch_trace_begin();
     app_init();
     _watch_init();
     app_setup();
@@ -23,13 +23,26 @@
  */
 
 #include "watch_adc.h"
+#include "watch_trace.h"
 
 void watch_enable_adc(void) {}
 
 void watch_enable_analog_input(const uint8_t pin) {}
 
 uint16_t watch_get_analog_pin_level(const uint8_t pin) {
-    return 32767; // pretend it's half of VCC
+    uint16_t value = 32767; // pretend it's half of VCC
+    watch_trace_adc(pin, value);
+    return value;
+}
+
+bool watch_start_analog_pin_conversion(const uint8_t pin, uint16_t samples, watch_adc_cb_t callback) {
+    // the simulated ADC is infinitely fast.
+    if (callback != NULL) callback(watch_get_analog_pin_level(pin));
+    return true;
+}
+
+bool watch_is_analog_conversion_in_progress(void) {
+    return false;
 }
 
 void watch_set_analog_num_samples(uint16_t samples) {}
@@ -40,7 +53,9 @@ void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference) {
 
 uint16_t watch_get_vcc_voltage(void) {
     // TODO: (a2) hook to UI
-    return 3000;
+    uint16_t millivolts = 3000;
+    watch_trace_vcc(millivolts);
+    return millivolts;
 }
 
 inline void watch_disable_analog_input(const uint8_t pin) {}
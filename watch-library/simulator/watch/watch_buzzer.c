@@ -35,17 +35,12 @@ void cb_watch_buzzer_seq(void *userData);
 
 static uint16_t _seq_position;
 static int8_t _tone_ticks, _repeat_counter;
-static long _em_interval_id = 0;
+static watch_timer_t _seq_timer;
 static int8_t *_sequence;
 static void (*_cb_finished)(void);
 
-static inline void _em_interval_stop() {
-    emscripten_clear_interval(_em_interval_id);
-    _em_interval_id = 0;
-}
-
 void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(void)) {
-    if (_em_interval_id) _em_interval_stop();
+    watch_timer_stop(&_seq_timer);
     watch_set_buzzer_off();
     _sequence = note_sequence;
     _cb_finished = callback_on_end;
@@ -55,7 +50,7 @@ void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(v
     // prepare buzzer
     watch_enable_buzzer();
     // initiate 64 hz callback
-    _em_interval_id = emscripten_set_interval(cb_watch_buzzer_seq, (double)(1000/64), (void *)NULL);
+    watch_timer_start(&_seq_timer, WATCH_TIMER_HZ(64), WATCH_TIMER_HZ(64), cb_watch_buzzer_seq, NULL);
 }
 
 void cb_watch_buzzer_seq(void *userData) {
@@ -102,7 +97,7 @@ void cb_watch_buzzer_seq(void *userData) {
 
 void watch_buzzer_abort_sequence(void) {
     // ends/aborts the sequence
-    if (_em_interval_id) _em_interval_stop();
+    watch_timer_stop(&_seq_timer);
     watch_set_buzzer_off();
 }
 
@@ -26,6 +26,7 @@
 
 #include "watch_extint.h"
 #include "watch_main_loop.h"
+#include "watch_trace.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -186,6 +187,7 @@ static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, watch_in
     }
 
     watch_set_pin_level(pin, level);
+    watch_trace_button(pin, level);
 
     if (callback && (event & trigger) != 0) {
         callback();
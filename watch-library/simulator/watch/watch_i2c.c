@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "watch_i2c.h"
 
 void watch_enable_i2c(void) {}
@@ -49,3 +50,25 @@ uint32_t watch_i2c_read24(int16_t addr, uint8_t reg) {
 uint32_t watch_i2c_read32(int16_t addr, uint8_t reg) {
     return 0;
 }
+
+bool watch_i2c_queue_read(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    memset(buf, 0, length);
+    if (callback != NULL) callback(WATCH_I2C_STATUS_OK, context);
+    return true;
+}
+
+bool watch_i2c_queue_write(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length, watch_i2c_cb_t callback, void *context) {
+    if (callback != NULL) callback(WATCH_I2C_STATUS_OK, context);
+    return true;
+}
+
+bool watch_i2c_is_busy(void) {
+    return false;
+}
+
+void watch_i2c_wait_for_idle(void) {}
+
+watch_i2c_status_t watch_i2c_read_burst(int16_t addr, uint8_t reg, uint8_t *buf, uint16_t length) {
+    memset(buf, 0, length);
+    return WATCH_I2C_STATUS_OK;
+}
@@ -24,6 +24,8 @@
 
 #include "watch_private.h"
 #include "watch_utility.h"
+#include "hal_atomic.h"
+#include <string.h>
 #include <sys/time.h>
 
 void _watch_init(void) {
@@ -32,10 +34,16 @@ void _watch_init(void) {
 }
 
 // this function is called by arc4random to get entropy for random number generation.
-// let's use the SAM L22's true random number generator to seed the PRNG!
+// the simulated TRNG hands out words from the browser's crypto.getRandomValues.
 int getentropy(void *buf, size_t buflen);
 int getentropy(void *buf, size_t buflen) {
-    // TODO: (a2) hook to RNG
+    uint32_t word;
+
+    for (size_t i = 0; i < buflen; i += 4) {
+        watch_trng_read(&word, 1);
+        memcpy((uint8_t *)buf + i, &word, (buflen - i < 4) ? buflen - i : 4);
+    }
+
     return 0;
 }
 
@@ -51,6 +59,15 @@ int _gettimeofday(struct timeval *tv, void *tzvp) {
     return 0;
 }
 
+// callbacks never preempt one another in the simulator, so there is nothing to mask.
+void atomic_enter_critical(hal_atomic_t volatile *atomic) {
+    (void)atomic;
+}
+
+void atomic_leave_critical(hal_atomic_t volatile *atomic) {
+    (void)atomic;
+}
+
 void _watch_enable_tcc(void) {}
 
 void _watch_disable_tcc(void) {}
@@ -24,12 +24,14 @@
 
 #include "watch_rtc.h"
 #include "watch_main_loop.h"
+#include "watch_trace.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
 
 static double time_offset = 0;
 static long tick_callbacks[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+static ext_irq_cb_t tick_functions[8];
 
 static long alarm_interval_id = -1;
 static long alarm_timeout_id = -1;
@@ -82,8 +84,9 @@ void watch_rtc_disable_tick_callback(void) {
 }
 
 static void watch_invoke_periodic_callback(void *userData) {
-    ext_irq_cb_t callback = userData;
-    callback();
+    uint8_t per_n = (uintptr_t)userData;
+    watch_trace_tick(128 >> per_n);
+    tick_functions[per_n]();
     resume_main_loop();
 }
 
@@ -100,7 +103,8 @@ void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequen
     double interval = 1000.0 / frequency; // in msec
 
     if (tick_callbacks[per_n] != -1) emscripten_clear_interval(tick_callbacks[per_n]);
-    tick_callbacks[per_n] = emscripten_set_interval(watch_invoke_periodic_callback, interval, (void *)callback);
+    tick_functions[per_n] = callback;
+    tick_callbacks[per_n] = emscripten_set_interval(watch_invoke_periodic_callback, interval, (void *)(uintptr_t)per_n);
 }
 
 void watch_rtc_disable_periodic_callback(uint8_t frequency) {
@@ -126,10 +130,12 @@ void watch_rtc_disable_all_periodic_callbacks(void) {
 }
 
 static void watch_invoke_alarm_interval_callback(void *userData) {
+    watch_trace_alarm();
     if (alarm_callback) alarm_callback();
 }
 
 static void watch_invoke_alarm_callback(void *userData) {
+    watch_trace_alarm();
     if (alarm_callback) alarm_callback();
     alarm_interval_id = emscripten_set_interval(watch_invoke_alarm_interval_callback, alarm_interval, NULL);
 }
@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "watch_slcd.h"
 #include "watch_private_display.h"
 #include "hpl_slcd_config.h"
@@ -37,12 +38,32 @@ static bool blink_state;
 static long blink_interval_id = - 1;
 static bool tick_state;
 static long tick_interval_id = -1;
+static watch_segments_t animation_segments;
+static watch_segments_t animation_frames[WATCH_MAX_ANIMATION_FRAMES];
+static uint8_t animation_num_frames;
+static uint32_t animation_frame_duration;
+static uint8_t animation_frame;
+static long animation_interval_id = -1;
+
+static bool frame_open = false;
+static uint32_t frame_data[3];
+static uint32_t frame_dirty[3];
+
+static uint8_t lp_seconds;
+static long lp_seconds_interval_id = -1;
 
 void watch_enable_display(void) {
+    // like the hardware, which resets the display controller here.
+    watch_stop_lp_seconds();
     watch_clear_display();
 }
 
 void watch_set_pixel(uint8_t com, uint8_t seg) {
+    if (frame_open) {
+        frame_data[com] |= 1ul << seg;
+        frame_dirty[com] |= 1ul << seg;
+        return;
+    }
     EM_ASM({
         document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
             .forEach((e) => e.style.opacity = 1);
@@ -50,19 +71,67 @@ void watch_set_pixel(uint8_t com, uint8_t seg) {
 }
 
 void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    if (frame_open) {
+        frame_data[com] &= ~(1ul << seg);
+        frame_dirty[com] |= 1ul << seg;
+        return;
+    }
     EM_ASM({
         document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
             .forEach((e) => e.style.opacity = 0);
     }, com, seg);
 }
 
+bool watch_get_pixel(uint8_t com, uint8_t seg) {
+    if (frame_open && (frame_dirty[com] & (1ul << seg))) return frame_data[com] & (1ul << seg);
+    return EM_ASM_INT({
+        const e = document.querySelector("[data-com='" + $0 + "'][data-seg='" + $1 + "']");
+        return e != null && e.style.opacity == 1;
+    }, com, seg);
+}
+
 void watch_clear_display(void) {
+    if (frame_open) {
+        memset(frame_data, 0, sizeof(frame_data));
+        memset(frame_dirty, 0xFF, sizeof(frame_dirty));
+        return;
+    }
     EM_ASM({
         document.querySelectorAll("[data-com][data-seg]")
             .forEach((e) => e.style.opacity = 0);
     });
 }
 
+// one trip into JavaScript for a whole group of segments, instead of one per segment.
+static void watch_write_segment_data(const uint32_t data[3], const uint32_t mask[3]) {
+    EM_ASM({
+        for (let com = 0; com < 3; com++) {
+            const data = HEAPU32[($0 >> 2) + com];
+            const mask = HEAPU32[($1 >> 2) + com];
+            for (let seg = 0; seg < 32; seg++) {
+                if (!((mask >>> seg) & 1)) continue;
+                document.querySelectorAll("[data-com='" + com + "'][data-seg='" + seg + "']")
+                    .forEach((e) => e.style.opacity = (data >>> seg) & 1);
+            }
+        }
+    }, data, mask);
+}
+
+void watch_set_segments(watch_segments_t segments, watch_segments_t lit) {
+    watch_write_segment_data(lit.com, segments.com);
+}
+
+void watch_begin_display_frame(void) {
+    memset(frame_dirty, 0, sizeof(frame_dirty));
+    frame_open = true;
+}
+
+void watch_commit_display_frame(void) {
+    if (!frame_open) return;
+    frame_open = false;
+    watch_write_segment_data(frame_data, frame_dirty);
+}
+
 static void watch_invoke_blink_callback(void *userData) {
     blink_state = !blink_state;
     watch_display_character(blink_state ? blink_character : ' ', 7);
@@ -115,3 +184,77 @@ void watch_stop_tick_animation(void) {
 
     watch_display_character(' ', 8);
 }
+
+static void watch_show_animation_frame(uint8_t frame) {
+    for (uint8_t com = 0; com < 3; com++) {
+        for (uint8_t seg = 0; seg < 32; seg++) {
+            if (!(animation_segments.com[com] & (1ul << seg))) continue;
+            if (animation_frames[frame].com[com] & (1ul << seg)) watch_set_pixel(com, seg);
+            else watch_clear_pixel(com, seg);
+        }
+    }
+}
+
+static void watch_invoke_animation_callback(void *userData) {
+    animation_frame = (animation_frame + 1) % animation_num_frames;
+    watch_show_animation_frame(animation_frame);
+}
+
+void watch_start_segment_animation(watch_segments_t segments, const watch_segments_t frames[], uint8_t num_frames, uint32_t frame_duration) {
+    // the same animation with new frames: swap them in and carry on from the frame we're on.
+    if (animation_interval_id != -1 && num_frames == animation_num_frames && frame_duration == animation_frame_duration &&
+        !memcmp(&segments, &animation_segments, sizeof(watch_segments_t))) {
+        memcpy(animation_frames, frames, num_frames * sizeof(watch_segments_t));
+        watch_show_animation_frame(animation_frame);
+        return;
+    }
+    if (animation_interval_id != -1) {
+        emscripten_clear_interval(animation_interval_id);
+        animation_interval_id = -1;
+    }
+    if (num_frames == 0 || num_frames > WATCH_MAX_ANIMATION_FRAMES) return;
+
+    animation_segments = segments;
+    memcpy(animation_frames, frames, num_frames * sizeof(watch_segments_t));
+    animation_num_frames = num_frames;
+    animation_frame_duration = frame_duration;
+    animation_frame = 0;
+    watch_show_animation_frame(0);
+    animation_interval_id = emscripten_set_interval(watch_invoke_animation_callback, (double)frame_duration, NULL);
+}
+
+bool watch_segment_animation_is_running(void) {
+    return animation_interval_id != -1;
+}
+
+void watch_stop_segment_animation(void) {
+    if (animation_interval_id == -1) return;
+    emscripten_clear_interval(animation_interval_id);
+    animation_interval_id = -1;
+
+    watch_show_animation_frame(0);
+}
+
+static void watch_invoke_lp_seconds_callback(void *userData) {
+    lp_seconds = (lp_seconds + 1) % 60;
+    watch_display_character_lp_seconds('0' + lp_seconds / 10, 8);
+    watch_display_character_lp_seconds('0' + lp_seconds % 10, 9);
+}
+
+void watch_start_lp_seconds(uint8_t second) {
+    watch_stop_lp_seconds();
+    if (second > 59) return;
+
+    lp_seconds = second;
+    lp_seconds_interval_id = emscripten_set_interval(watch_invoke_lp_seconds_callback, 1000.0, NULL);
+}
+
+bool watch_lp_seconds_is_running(void) {
+    return lp_seconds_interval_id != -1;
+}
+
+void watch_stop_lp_seconds(void) {
+    if (lp_seconds_interval_id == -1) return;
+    emscripten_clear_interval(lp_seconds_interval_id);
+    lp_seconds_interval_id = -1;
+}
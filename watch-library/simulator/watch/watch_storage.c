@@ -30,3 +30,9 @@ bool watch_storage_sync(void) {
     // nothing to do here!
     return true;
 }
+
+const uint8_t *watch_storage_get_assets(uint32_t *size) {
+    // there's no asset region to flash in the simulator.
+    if (size != NULL) *size = 0;
+    return NULL;
+}
@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "watch_timer.h"
+#include "watch_main_loop.h"
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+
+// In the simulator, the "counter" is the browser's monotonic clock, and the compare match is a timeout.
+static double _watch_timer_start_ms;
+static bool _watch_timer_enabled = false;
+static long _watch_timer_timeout_id = -1;
+
+static void _watch_timer_clear_timeout(void) {
+    if (_watch_timer_timeout_id != -1) {
+        emscripten_clear_timeout(_watch_timer_timeout_id);
+        _watch_timer_timeout_id = -1;
+    }
+}
+
+static void _watch_timer_invoke_service(void *userData) {
+    (void) userData;
+    _watch_timer_timeout_id = -1;
+    _watch_timer_service();
+    resume_main_loop();
+}
+
+void _watch_timer_counter_enable(void) {
+    if (_watch_timer_enabled) return;
+    _watch_timer_start_ms = emscripten_get_now();
+    _watch_timer_enabled = true;
+}
+
+void _watch_timer_counter_disable(void) {
+    _watch_timer_clear_timeout();
+    _watch_timer_enabled = false;
+}
+
+uint32_t _watch_timer_counter_now(void) {
+    if (!_watch_timer_enabled) return 0;
+    return (uint32_t)((emscripten_get_now() - _watch_timer_start_ms) * WATCH_TIMER_TICKS_PER_SECOND / 1000);
+}
+
+void _watch_timer_counter_arm(uint32_t deadline) {
+    int32_t remaining = (int32_t)(deadline - _watch_timer_counter_now());
+    uint32_t ms = remaining > 0 ? ((uint64_t)remaining * 1000 + WATCH_TIMER_TICKS_PER_SECOND - 1) / WATCH_TIMER_TICKS_PER_SECOND : 0;
+
+    _watch_timer_clear_timeout();
+    _watch_timer_timeout_id = emscripten_set_timeout(_watch_timer_invoke_service, (double)ms, NULL);
+}
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdio.h>
+#include <stdarg.h>
+#include "watch.h"
+#include "watch_trace.h"
+
+#include <emscripten.h>
+
+static char _trace[WATCH_TRACE_BUFFER_SIZE];
+static size_t _trace_length;
+static bool _trace_full;
+static double _trace_start_ms;
+// last reading recorded for each pin, plus one; zero means nothing recorded yet.
+static uint32_t _trace_last_adc[256];
+static uint32_t _trace_last_vcc;
+
+static void _watch_trace_append(const char *format, ...) {
+    if (_trace_full) return;
+
+    size_t space = sizeof(_trace) - _trace_length;
+    int n = snprintf(_trace + _trace_length, space, "%lu ", (unsigned long)(emscripten_get_now() - _trace_start_ms));
+    if (n > 0 && (size_t)n < space) {
+        va_list args;
+        va_start(args, format);
+        int m = vsnprintf(_trace + _trace_length + n, space - n, format, args);
+        va_end(args);
+        if (m > 0 && (size_t)(n + m) < space - 1) {
+            _trace_length += n + m;
+            _trace[_trace_length++] = '\n';
+            return;
+        }
+    }
+
+    _trace[_trace_length] = 0;
+    _trace_full = true;
+}
+
+char watch_trace_button_name(uint8_t pin) {
+    if (pin == BTN_LIGHT) return 'L';
+    if (pin == BTN_MODE) return 'M';
+    if (pin == BTN_ALARM) return 'A';
+    return 0;
+}
+
+void watch_trace_begin(void) {
+    _trace_start_ms = emscripten_get_now();
+    _trace_length = 0;
+    _trace_full = false;
+    _watch_trace_append("time 0x%08lx", (unsigned long)watch_rtc_get_date_time().reg);
+}
+
+void watch_trace_button(uint8_t pin, bool level) {
+    char name = watch_trace_button_name(pin);
+    if (name) _watch_trace_append("btn %c %d", name, level);
+}
+
+void watch_trace_tick(uint8_t frequency) {
+    _watch_trace_append("tick %d", frequency);
+}
+
+void watch_trace_alarm(void) {
+    _watch_trace_append("alarm");
+}
+
+void watch_trace_adc(uint8_t pin, uint16_t value) {
+    if (_trace_last_adc[pin] == (uint32_t)value + 1) return;
+    _trace_last_adc[pin] = (uint32_t)value + 1;
+    _watch_trace_append("adc %d %u", pin, value);
+}
+
+void watch_trace_vcc(uint16_t millivolts) {
+    if (_trace_last_vcc == (uint32_t)millivolts + 1) return;
+    _trace_last_vcc = (uint32_t)millivolts + 1;
+    _watch_trace_append("vcc %u", millivolts);
+}
+
+void watch_trace_trng(uint32_t word) {
+    _watch_trace_append("trng 0x%08lx", (unsigned long)word);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void watch_trace_dump(void) {
+    printf("# Sensor Watch trace\n");
+    fwrite(_trace, 1, _trace_length, stdout);
+    if (_trace_full) printf("# trace buffer full; recording stopped here\n");
+    fflush(stdout);
+}
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 agent
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef WATCH_TRACE_H_
+#define WATCH_TRACE_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Event traces for the simulator.
+  * @details The simulator records everything that happens *to* the watch while it runs: button edges, RTC ticks
+  *          and alarms, sensor readings and random numbers. Call watch_trace_dump() from the browser console (or
+  *          press "Dump to console" on the page) to print the trace, then feed it to the headless build to replay it
+  *          deterministically, e.g. to reproduce a bug or to check a face's output against a known-good run.
+  *
+  *          The format is plain text, one event per line: a timestamp in milliseconds since the trace began, a
+  *          keyword, and its arguments. Blank lines and lines starting with # are ignored.
+  *
+  *              0 time 0x1c2b4000  the RTC's date and time (a watch_date_time register value) when the trace began
+  *              1532 btn A 1       a button edge: L(ight), M(ode) or A(larm), 1 for pressed, 0 for released
+  *              2000 tick 1        a periodic RTC callback at 1, 2, 4 ... 128 Hz
+  *              60000 alarm        the RTC alarm callback
+  *              2010 adc 34 32767  a reading from an analog pin, by pin number (34 is A2; recorded on change)
+  *              2010 vcc 3000      a VCC reading in millivolts (recorded when it changes)
+  *              5 trng 0x8d3e19a2  a word read from the TRNG, in the order they were read
+  *
+  *          Button edges, sensor readings and TRNG words are inputs to the replay. Ticks and alarms are produced by
+  *          the replay's own virtual clock; the recorded ones are only counted, to check that the replay stayed in
+  *          step with the recording.
+  */
+
+/// Size of the buffer the simulator records into; recording stops (and says so) when it is full.
+#define WATCH_TRACE_BUFFER_SIZE 65536
+
+void watch_trace_begin(void);
+void watch_trace_button(uint8_t pin, bool level);
+void watch_trace_tick(uint8_t frequency);
+void watch_trace_alarm(void);
+void watch_trace_adc(uint8_t pin, uint16_t value);
+void watch_trace_vcc(uint16_t millivolts);
+void watch_trace_trng(uint32_t word);
+
+/** @brief Prints the trace recorded so far to the console, in the format above.
+  */
+void watch_trace_dump(void);
+
+/** @brief Maps a button pin to the letter used in traces, or 0 if it isn't a button.
+  */
+char watch_trace_button_name(uint8_t pin);
+
+#endif // WATCH_TRACE_H_